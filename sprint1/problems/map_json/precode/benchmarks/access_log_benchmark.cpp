@@ -0,0 +1,114 @@
+#include <boost/asio/ip/address.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../src/access_log.h"
+#include "../src/request_handler.h"
+
+/*
+ * Измеряет пропускную способность обработки запросов с журналом доступа и без него
+ * и наибольшее время обработки одного запроса: оно показывает, ждал ли поток
+ * освобождения места в очереди журнала.
+ * Обработчик отвечает небольшим JSON на каждый запрос, потоки имитируют потоки io_context.
+ * Журнал пишется во временный файл.
+ */
+
+using namespace std::literals;
+namespace http = boost::beast::http;
+
+namespace {
+
+constexpr int REQUEST_COUNT = 500'000;
+
+using StringRequest = http::request<http::string_body>;
+using StringResponse = http::response<http::string_body>;
+
+// Обработчик, который отвечает так же, как ответил бы /api/v1/maps/{id}
+struct MapHandler {
+    template <typename Send>
+    void operator()(StringRequest&& req, Send&& send) {
+        StringResponse response{http::status::ok, req.version()};
+        response.set(http::field::content_type, "application/json");
+        response.body() = R"({"id":"map1","name":"Map 1"})"sv;
+        response.prepare_payload();
+        send(std::move(response));
+    }
+};
+
+struct Measurement {
+    double requests_per_second = 0;
+    // Наибольшее время обработки одного запроса, мс
+    double max_request_ms = 0;
+};
+
+template <typename Handle>
+Measurement Measure(int thread_count, const Handle& handle) {
+    std::vector<std::thread> threads;
+    std::vector<std::chrono::steady_clock::duration> max_durations(thread_count);
+    const auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&handle, &max_duration = max_durations[t]] {
+            size_t sent = 0;
+            for (int i = 0; i < REQUEST_COUNT; ++i) {
+                const auto request_start = std::chrono::steady_clock::now();
+                StringRequest req{http::verb::get, "/api/v1/maps/map1", 11};
+                handle(std::move(req), [&sent](auto&& response) {
+                    sent += response.body().size();
+                });
+                max_duration = std::max(max_duration, std::chrono::steady_clock::now() - request_start);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto max_duration = *std::max_element(max_durations.begin(), max_durations.end());
+    return {thread_count * REQUEST_COUNT / seconds,
+            std::chrono::duration<double, std::milli>{max_duration}.count()};
+}
+
+}  // namespace
+
+int main() {
+    const auto path = std::filesystem::temp_directory_path() / "access_log_benchmark.log";
+    const auto client = boost::asio::ip::make_address("192.168.1.10");
+    MapHandler handler;
+
+    for (const int thread_count : {1, 4}) {
+        const Measurement disabled = Measure(thread_count, [&](auto&& req, auto&& send) {
+            handler(std::move(req), send);
+        });
+
+        Measurement enabled;
+        {
+            std::ofstream file{path};
+            access_log::AccessLog log{file};
+            http_handler::LoggingRequestHandler logging_handler{handler, log};
+            enabled = Measure(thread_count, [&](auto&& req, auto&& send) {
+                logging_handler(client, std::move(req), send);
+            });
+        }
+
+        std::cout << thread_count << " thread(s): logging disabled "sv
+                  << disabled.requests_per_second << " req/s, enabled "sv
+                  << enabled.requests_per_second << " req/s ("sv
+                  << (1 - enabled.requests_per_second / disabled.requests_per_second) * 100
+                  << "% slower), max request time "sv << disabled.max_request_ms << " ms / "sv
+                  << enabled.max_request_ms << " ms"sv << std::endl;
+    }
+    std::cout << "log lines: "sv << std::filesystem::file_size(path) << " bytes, e.g."sv
+              << std::endl;
+    std::ifstream file{path};
+    std::string line;
+    std::getline(file, line);
+    std::cout << line << std::endl;
+    std::filesystem::remove(path);
+}
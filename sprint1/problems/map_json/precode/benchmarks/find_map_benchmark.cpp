@@ -0,0 +1,97 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../src/model.h"
+
+/*
+ * Измеряет время поиска карты по идентификатору в игре с 10000 карт.
+ * Сравнивает прежний поиск через std::unordered_map с ключом Tagged<std::string>,
+ * поиск через std::unordered_map с заранее вычисленным хешем
+ * и поиск через совершенную хеш-функцию.
+ * Идентификатор создаётся из строки запроса при каждом поиске, как при обработке
+ * /api/v1/maps/{id}, а затем поиск повторяется с готовыми идентификаторами.
+ * Каждый десятый запрос ищет несуществующую карту.
+ */
+
+using namespace std::literals;
+
+namespace {
+
+constexpr size_t MAP_COUNT = 10'000;
+constexpr size_t LOOKUP_COUNT = 2'000'000;
+
+struct OldMapTag {};
+using OldMapId = util::Tagged<std::string, OldMapTag>;
+
+std::string MakeMapId(size_t index) {
+    return "map_"s + std::to_string(index) + "_town"s;
+}
+
+template <typename Find>
+void Report(std::string_view name, const std::vector<std::string>& requests, Find&& find) {
+    size_t found = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& request : requests) {
+        found += find(request) ? 1 : 0;
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now()
+                                                                - start)
+                          .count()
+                    / static_cast<double>(requests.size());
+    std::cout << name << ": "sv << ns << " ns per lookup (found "sv << found << ")"sv
+              << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    model::Game hashed_game;
+    model::Game indexed_game;
+    std::unordered_map<OldMapId, size_t, util::TaggedHasher<OldMapId>> old_index;
+    for (size_t i = 0; i < MAP_COUNT; ++i) {
+        const auto id = MakeMapId(i);
+        hashed_game.AddMap(model::Map{model::Map::Id{id}, "Town "s + std::to_string(i)});
+        indexed_game.AddMap(model::Map{model::Map::Id{id}, "Town "s + std::to_string(i)});
+        old_index.emplace(OldMapId{id}, i);
+    }
+    indexed_game.BuildMapIndex();
+
+    std::mt19937_64 random{42};
+    std::uniform_int_distribution<size_t> map_index{0, MAP_COUNT - 1};
+    std::vector<std::string> requests;
+    requests.reserve(LOOKUP_COUNT);
+    for (size_t i = 0; i < LOOKUP_COUNT; ++i) {
+        requests.push_back(i % 10 == 9 ? "missing_"s + std::to_string(i)
+                                       : MakeMapId(map_index(random)));
+    }
+
+    Report("Tagged<std::string> + std::unordered_map"sv, requests, [&](const std::string& id) {
+        return old_index.contains(OldMapId{id});
+    });
+    Report("HashedString + std::unordered_map"sv, requests, [&](const std::string& id) {
+        return hashed_game.FindMap(model::Map::Id{id}) != nullptr;
+    });
+    Report("HashedString + perfect hash"sv, requests, [&](const std::string& id) {
+        return indexed_game.FindMap(model::Map::Id{id}) != nullptr;
+    });
+
+    // Поиск по уже созданным идентификаторам, например при входе в игру
+    std::vector<model::Map::Id> ids;
+    ids.reserve(requests.size());
+    for (const auto& request : requests) {
+        ids.emplace_back(request);
+    }
+    size_t next = 0;
+    Report("ready ids + std::unordered_map"sv, requests, [&](const std::string&) {
+        return hashed_game.FindMap(ids[next++ % ids.size()]) != nullptr;
+    });
+    next = 0;
+    Report("ready ids + perfect hash"sv, requests, [&](const std::string&) {
+        return indexed_game.FindMap(ids[next++ % ids.size()]) != nullptr;
+    });
+}
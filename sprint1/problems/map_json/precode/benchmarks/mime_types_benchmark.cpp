@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../src/mime_types.h"
+
+/*
+ * Сравнивает определение MIME-типа через совершенную хеш-таблицу с цепочкой сравнений:
+ * расширение приводится к нижнему регистру и по очереди сравнивается с каждым известным.
+ * Расширения запросов взяты из каталогов static (в том числе в верхнем регистре),
+ * четыре из пятнадцати неизвестны.
+ */
+
+using namespace std::literals;
+
+namespace {
+
+constexpr int ROUNDS = 1'000'000;
+
+std::string_view GetContentTypeByComparisons(std::string_view extension) {
+    std::string lower{extension.substr(extension.starts_with('.') ? 1 : 0)};
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    if (lower == "htm"sv || lower == "html"sv) {
+        return "text/html"sv;
+    } else if (lower == "css"sv) {
+        return "text/css"sv;
+    } else if (lower == "txt"sv) {
+        return "text/plain"sv;
+    } else if (lower == "js"sv) {
+        return "text/javascript"sv;
+    } else if (lower == "json"sv) {
+        return "application/json"sv;
+    } else if (lower == "xml"sv) {
+        return "application/xml"sv;
+    } else if (lower == "png"sv) {
+        return "image/png"sv;
+    } else if (lower == "jpg"sv || lower == "jpe"sv || lower == "jpeg"sv) {
+        return "image/jpeg"sv;
+    } else if (lower == "gif"sv) {
+        return "image/gif"sv;
+    } else if (lower == "bmp"sv) {
+        return "image/bmp"sv;
+    } else if (lower == "ico"sv) {
+        return "image/vnd.microsoft.icon"sv;
+    } else if (lower == "tiff"sv || lower == "tif"sv) {
+        return "image/tiff"sv;
+    } else if (lower == "svg"sv || lower == "svgz"sv) {
+        return "image/svg+xml"sv;
+    } else if (lower == "mp3"sv) {
+        return "audio/mpeg"sv;
+    } else if (lower == "obj"sv) {
+        return "model/obj"sv;
+    } else if (lower == "webmanifest"sv) {
+        return "application/manifest+json"sv;
+    }
+    return http_handler::DEFAULT_CONTENT_TYPE;
+}
+
+template <typename Lookup>
+void Report(std::string_view name, const std::vector<std::string>& extensions, Lookup&& lookup) {
+    size_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (const auto& extension : extensions) {
+            checksum += lookup(extension).size();
+        }
+    }
+    const double ns =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+        / static_cast<double>(ROUNDS * extensions.size());
+    std::cout << name << ": "sv << ns << " ns per lookup (checksum "sv << checksum << ")"sv
+              << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    const std::vector<std::string> extensions = {
+        ".html"s, ".js"s,  ".png"s, ".svg"s, ".fbx"s, ".ico"s, ".webmanifest"s, ".JS"s, ".PNG"s,
+        ".md"s,   ".obj"s, ".Html"s, ".map"s, ".jpeg"s, ".exe"s,
+    };
+    Report("chain of comparisons"sv, extensions, GetContentTypeByComparisons);
+    Report("perfect hash"sv, extensions, [](const std::string& extension) {
+        return http_handler::GetContentType(extension);
+    });
+}
@@ -0,0 +1,156 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../src/request_target.h"
+#include "../src/urldecode.h"
+
+/*
+ * Сравнивает разбор цели запроса отдельными шагами, каждый из которых создаёт строки
+ * (декодирование всей цели, деление пути на сегменты, разбор параметров),
+ * с разбором через RequestTarget. В обоих случаях запрос маршрутизируется
+ * как /api/v1/maps/{id}?lang=..., из него извлекаются id и lang.
+ * Кроме времени выводится число выделений памяти на запрос.
+ */
+
+using namespace std::literals;
+
+namespace {
+
+size_t allocation_count = 0;
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+constexpr int REQUEST_COUNT = 2'000'000;
+
+struct Route {
+    std::string id;
+    std::string lang;
+};
+
+// Прежний способ: каждый шаг возвращает новые строки
+bool RouteWithStrings(std::string_view target, Route& route) {
+    const std::string decoded_path = UrlDecode(target.substr(0, target.find('?')));
+    std::vector<std::string> segments;
+    size_t start = 1;
+    while (start <= decoded_path.size()) {
+        const size_t slash = decoded_path.find('/', start);
+        const size_t end = slash == std::string::npos ? decoded_path.size() : slash;
+        segments.emplace_back(decoded_path.substr(start, end - start));
+        start = end + 1;
+    }
+    std::vector<std::pair<std::string, std::string>> params;
+    if (const size_t question = target.find('?'); question != std::string_view::npos) {
+        std::string_view query = target.substr(question + 1);
+        while (!query.empty()) {
+            const size_t amp = query.find('&');
+            const std::string_view param = query.substr(0, amp);
+            const size_t eq = param.find('=');
+            params.emplace_back(UrlDecode(param.substr(0, eq)),
+                                eq == std::string_view::npos ? ""s : UrlDecode(param.substr(eq + 1)));
+            query.remove_prefix(amp == std::string_view::npos ? query.size() : amp + 1);
+        }
+    }
+
+    if (segments.size() != 4 || segments[0] != "api"sv || segments[1] != "v1"sv
+        || segments[2] != "maps"sv) {
+        return false;
+    }
+    route.id = segments[3];
+    route.lang.clear();
+    for (const auto& [name, value] : params) {
+        if (name == "lang"sv) {
+            route.lang = value;
+            break;
+        }
+    }
+    return true;
+}
+
+// Разбор через RequestTarget: строки создаются только для закодированных частей
+bool RouteWithTarget(std::string_view target, Route& route) {
+    const http_handler::RequestTarget request_target{target};
+    static constexpr std::string_view PREFIX[] = {"api"sv, "v1"sv, "maps"sv};
+    size_t index = 0;
+    http_handler::EncodedPart id;
+    for (const auto segment : request_target.GetSegments()) {
+        if (index < std::size(PREFIX)) {
+            if (!segment.Equals(PREFIX[index])) {
+                return false;
+            }
+        } else if (index == std::size(PREFIX)) {
+            id = segment;
+        } else {
+            return false;
+        }
+        ++index;
+    }
+    if (index != std::size(PREFIX) + 1) {
+        return false;
+    }
+    route.id.assign(id.Decode(route.id));
+    route.lang.clear();
+    if (const auto lang = request_target.FindQueryParam("lang"sv)) {
+        route.lang.assign(lang->Decode(route.lang));
+    }
+    return true;
+}
+
+template <typename RouteFn>
+void Report(std::string_view name, std::string_view target, RouteFn&& route_fn) {
+    Route route;
+    route.id.reserve(64);
+    route.lang.reserve(64);
+    size_t matched = 0;
+    const size_t allocations_before = allocation_count;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < REQUEST_COUNT; ++i) {
+        matched += route_fn(target, route) ? 1 : 0;
+    }
+    const double ns =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+        / REQUEST_COUNT;
+    std::cout << "  "sv << name << ": "sv << ns << " ns, "sv
+              << static_cast<double>(allocation_count - allocations_before) / REQUEST_COUNT
+              << " allocations per request (matched "sv << matched << ", id \""sv << route.id
+              << "\", lang \""sv << route.lang << "\")"sv << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    constexpr std::string_view targets[] = {
+        "/api/v1/maps/map1"sv,
+        "/api/v1/maps/town_center_with_a_long_name?lang=ru&debug"sv,
+        "/api/v1/maps/map%201?lang=%D1%80%D1%83&debug"sv,
+        "/static/images/cube.svg"sv,
+    };
+    for (const auto target : targets) {
+        std::cout << target << ":"sv << std::endl;
+        Report("separate string steps"sv, target, RouteWithStrings);
+        Report("RequestTarget"sv, target, RouteWithTarget);
+    }
+}
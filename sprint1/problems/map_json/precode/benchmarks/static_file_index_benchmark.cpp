@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../src/mime_types.h"
+#include "../src/static_file_index.h"
+
+/*
+ * Сравнивает поиск статического файла по пути из запроса через файловую систему
+ * (weakly_canonical, проверка выхода за пределы корня, is_regular_file и file_size)
+ * с поиском в StaticFileIndex.
+ * Пути запросов - все файлы каталога, путь к каталогу, несуществующий файл
+ * и попытки выйти за пределы корня.
+ * Использование: static_file_index_benchmark <static-root>
+ */
+
+using namespace std::literals;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int ROUNDS = 200;
+
+struct FoundFile {
+    fs::path path;
+    std::uintmax_t size = 0;
+    std::string_view content_type;
+};
+
+bool IsSubPath(const fs::path& path, const fs::path& base) {
+    return std::mismatch(base.begin(), base.end(), path.begin(), path.end()).first == base.end();
+}
+
+// Поиск через файловую систему: несколько системных вызовов на каждый запрос
+bool FindOnDisk(const fs::path& root, std::string_view decoded_path, FoundFile& found) {
+    std::string relative{decoded_path.substr(decoded_path.starts_with('/') ? 1 : 0)};
+    if (relative.empty() || relative.ends_with('/')) {
+        relative += "index.html"sv;
+    }
+    std::error_code ec;
+    const fs::path path = fs::weakly_canonical(root / relative, ec);
+    if (ec || !IsSubPath(path, root) || !fs::is_regular_file(path, ec)) {
+        return false;
+    }
+    found = {path, fs::file_size(path, ec), http_handler::GetContentType(path.extension().native())};
+    return !ec;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: static_file_index_benchmark <static-root>"sv << std::endl;
+        return EXIT_FAILURE;
+    }
+    const auto build_start = std::chrono::steady_clock::now();
+    http_handler::StaticFileIndex index{argv[1], http_handler::StaticFileIndex::Watch::DISABLED};
+    std::cout << "index of "sv << index.GetFileCount() << " entries built in "sv
+              << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()
+                                                           - build_start)
+                     .count()
+              << " ms"sv << std::endl;
+
+    std::vector<std::string> requests;
+    for (const auto& entry : fs::recursive_directory_iterator{index.GetRoot()}) {
+        if (entry.is_regular_file()) {
+            requests.push_back("/"s + entry.path().lexically_relative(index.GetRoot()).generic_string());
+        }
+    }
+    requests.insert(requests.end(), {"/"s, "/missing.html"s, "/../../etc/passwd"s,
+                                     "/js/../../secret.txt"s});
+
+    size_t found_on_disk = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (const auto& request : requests) {
+            FoundFile found;
+            found_on_disk += FindOnDisk(index.GetRoot(), request, found) ? 1 : 0;
+        }
+    }
+    const double disk_ns =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+        / static_cast<double>(ROUNDS * requests.size());
+
+    size_t found_in_index = 0;
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (const auto& request : requests) {
+            found_in_index += index.Find(request) ? 1 : 0;
+        }
+    }
+    const double index_ns =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+        / static_cast<double>(ROUNDS * requests.size());
+
+    std::cout << requests.size() << " request paths"sv << std::endl;
+    std::cout << "filesystem lookup: "sv << disk_ns << " ns per request (found "sv
+              << found_on_disk / ROUNDS << ")"sv << std::endl;
+    std::cout << "index lookup: "sv << index_ns << " ns per request (found "sv
+              << found_in_index / ROUNDS << ")"sv << std::endl;
+}
@@ -0,0 +1,246 @@
+#include "access_log.h"
+
+#include <arpa/inet.h>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/sources/channel_logger.hpp>
+#include <boost/make_shared.hpp>
+#include <charconv>
+#include <ctime>
+#include <iterator>
+
+namespace access_log {
+
+namespace logging = boost::log;
+namespace sinks = boost::log::sinks;
+using namespace std::literals;
+
+namespace {
+
+constexpr auto CHANNEL = "access"sv;
+// Время записи в тиках std::chrono::system_clock. Атрибут local_clock из Boost.Log
+// вызывает localtime_r на каждой записи, поэтому время сохраняется числом
+// и форматируется в приёмнике
+constexpr auto TIMESTAMP = "TimeStamp"sv;
+// Объект JSON с полями запроса
+constexpr auto DATA = "Data"sv;
+
+BOOST_LOG_ATTRIBUTE_KEYWORD(channel, "Channel", std::string)
+
+template <typename T>
+void AppendNumber(std::string& out, T value) {
+    char buffer[24];
+    out.append(buffer, std::to_chars(buffer, std::end(buffer), value).ptr);
+}
+
+}  // namespace
+
+std::string_view FormatIp(const boost::asio::ip::address& address, IpText& buffer) {
+    if (address.is_v4()) {
+        const auto bytes = address.to_v4().to_bytes();
+        ::inet_ntop(AF_INET, bytes.data(), buffer.data(), buffer.size());
+        return buffer.data();
+    }
+    const auto v6 = address.to_v6();
+    const auto bytes = v6.to_bytes();
+    ::inet_ntop(AF_INET6, bytes.data(), buffer.data(), buffer.size());
+    const size_t size = std::strlen(buffer.data());
+    if (v6.scope_id() == 0) {
+        return {buffer.data(), size};
+    }
+    // Номер зоны дописывается после '%', как в address::to_string
+    buffer[size] = '%';
+    const auto end = std::to_chars(buffer.data() + size + 1, buffer.data() + buffer.size(),
+                                   v6.scope_id()).ptr;
+    return {buffer.data(), static_cast<size_t>(end - buffer.data())};
+}
+
+void AppendJsonString(std::string& out, std::string_view str) {
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    out += '"';
+    while (!str.empty()) {
+        // Символы, не требующие экранирования, копируются одним вызовом
+        size_t plain = 0;
+        while (plain < str.size()) {
+            const auto c = static_cast<unsigned char>(str[plain]);
+            if (c < 0x20 || c == '"' || c == '\\') {
+                break;
+            }
+            ++plain;
+        }
+        out.append(str.substr(0, plain));
+        if (plain == str.size()) {
+            break;
+        }
+        const auto c = static_cast<unsigned char>(str[plain]);
+        switch (c) {
+            case '"':
+                out += "\\\""sv;
+                break;
+            case '\\':
+                out += "\\\\"sv;
+                break;
+            case '\n':
+                out += "\\n"sv;
+                break;
+            case '\r':
+                out += "\\r"sv;
+                break;
+            case '\t':
+                out += "\\t"sv;
+                break;
+            default:
+                out += "\\u00"sv;
+                out += HEX_DIGITS[c >> 4];
+                out += HEX_DIGITS[c & 0xf];
+        }
+        str.remove_prefix(plain + 1);
+    }
+    out += '"';
+}
+
+void AppendRequestJson(std::string& out, const RequestInfo& info) {
+    out += R"({"ip":)"sv;
+    AppendJsonString(out, info.ip);
+    out += R"(,"method":)"sv;
+    AppendJsonString(out, info.method);
+    out += R"(,"URI":)"sv;
+    AppendJsonString(out, info.uri);
+    out += R"(,"code":)"sv;
+    AppendNumber(out, info.status);
+    out += R"(,"response_time":)"sv;
+    AppendNumber(out, info.response_time.count());
+    out += R"(,"content_type":)"sv;
+    if (info.content_type.empty()) {
+        out += "null"sv;
+    } else {
+        AppendJsonString(out, info.content_type);
+    }
+    out += '}';
+}
+
+JsonLinesBackend::JsonLinesBackend(std::ostream& output)
+    : output_{output} {
+    batch_.reserve(BATCH_SIZE + 4096);
+}
+
+void JsonLinesBackend::consume(const logging::record_view& rec) {
+    batch_ += R"({"timestamp":")"sv;
+    if (const auto ticks = logging::extract<int64_t>(std::string{TIMESTAMP}, rec)) {
+        AppendTimestamp(std::chrono::system_clock::time_point{
+            std::chrono::system_clock::duration{*ticks}});
+    }
+    batch_ += R"(","data":)"sv;
+    if (const auto data = logging::extract<RequestJson>(std::string{DATA}, rec)) {
+        batch_ += data->GetText();
+    } else {
+        batch_ += "{}"sv;
+    }
+    batch_ += R"(,"message":"response sent"})"sv;
+    batch_ += '\n';
+    if (batch_.size() >= BATCH_SIZE) {
+        WriteBatch();
+    }
+}
+
+void JsonLinesBackend::AppendTimestamp(std::chrono::system_clock::time_point time) {
+    // Дата и время с точностью до секунды форматируются заново только при смене секунды
+    const auto seconds = std::chrono::floor<std::chrono::seconds>(time);
+    if (seconds != cached_second_) {
+        const std::time_t t = std::chrono::system_clock::to_time_t(seconds);
+        std::tm tm;
+        localtime_r(&t, &tm);
+        cached_second_text_.resize(32);
+        cached_second_text_.resize(std::strftime(cached_second_text_.data(),
+                                                 cached_second_text_.size(), "%FT%T", &tm));
+        cached_second_ = seconds;
+    }
+    batch_ += cached_second_text_;
+    const auto micros =
+        std::chrono::duration_cast<std::chrono::microseconds>(time - seconds).count();
+    char fraction[7] = {'.'};
+    auto rest = micros;
+    for (size_t i = std::size(fraction) - 1; i > 0; --i, rest /= 10) {
+        fraction[i] = static_cast<char>('0' + rest % 10);
+    }
+    batch_.append(fraction, std::size(fraction));
+}
+
+void JsonLinesBackend::flush() {
+    WriteBatch();
+    output_.flush();
+}
+
+void JsonLinesBackend::WriteBatch() {
+    output_.write(batch_.data(), static_cast<std::streamsize>(batch_.size()));
+    batch_.clear();
+}
+
+AccessLog::AccessLog(std::ostream& output)
+    : sink_{boost::make_shared<Sink>(boost::make_shared<JsonLinesBackend>(output),
+                                     /* start_thread = */ true)} {
+    sink_->set_filter(channel == std::string{CHANNEL});
+    logging::core::get()->add_sink(sink_);
+    flusher_ = std::thread{[this] {
+        RunFlusher();
+    }};
+}
+
+AccessLog::~AccessLog() {
+    {
+        std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+    stop_cv_.notify_one();
+    flusher_.join();
+    logging::core::get()->remove_sink(sink_);
+    // stop может оставить записи в очереди, их дописывает flush на текущем потоке
+    sink_->stop();
+    sink_->flush();
+}
+
+void AccessLog::Log(const RequestInfo& info) {
+    // У каждого потока свой источник записей и свой буфер, поэтому потоки не ждут друг друга
+    thread_local logging::sources::channel_logger<> logger{
+        logging::keywords::channel = std::string{CHANNEL}};
+    thread_local const logging::attribute_name timestamp_name{std::string{TIMESTAMP}};
+    thread_local const logging::attribute_name data_name{std::string{DATA}};
+
+    thread_local std::string buffer = [] {
+        std::string result;
+        result.reserve(1024);
+        return result;
+    }();
+
+    const auto now = std::chrono::system_clock::now();
+    buffer.clear();
+    AppendRequestJson(buffer, info);
+    if (auto rec = logger.open_record()) {
+        // Значения добавляются в запись напрямую, без форматирования через record_ostream
+        auto& values = rec.attribute_values();
+        values.insert(timestamp_name, logging::attributes::make_attribute_value(
+                                          static_cast<int64_t>(now.time_since_epoch().count())));
+        values.insert(data_name, logging::attributes::make_attribute_value(RequestJson{buffer}));
+        logger.push_record(std::move(rec));
+    }
+}
+
+void AccessLog::Flush() {
+    sink_->flush();
+}
+
+void AccessLog::RunFlusher() {
+    std::unique_lock lock{mutex_};
+    while (!stop_cv_.wait_for(lock, FLUSH_INTERVAL, [this] {
+        return stopping_;
+    })) {
+        lock.unlock();
+        // Поток приёмника дописывает в пачку записи из очереди и выводит неполную пачку
+        sink_->flush();
+        lock.lock();
+    }
+}
+
+}  // namespace access_log
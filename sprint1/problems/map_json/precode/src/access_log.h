@@ -0,0 +1,148 @@
+#pragma once
+#include <boost/asio/ip/address.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/block_on_overflow.hpp>
+#include <boost/log/sinks/bounded_fifo_queue.hpp>
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace access_log {
+
+/*
+ * Строка, которая хранится внутри объекта, если её длина не больше N.
+ * Более длинные строки хранятся в динамической памяти.
+ */
+template <size_t N>
+class InlineString {
+public:
+    InlineString() = default;
+
+    explicit InlineString(std::string_view text)
+        : size_{text.size()} {
+        if (size_ <= N) {
+            std::memcpy(inline_.data(), text.data(), size_);
+        } else {
+            heap_.assign(text);
+        }
+    }
+
+    std::string_view GetText() const noexcept {
+        return size_ <= N ? std::string_view{inline_.data(), size_} : std::string_view{heap_};
+    }
+
+private:
+    std::array<char, N> inline_;
+    size_t size_ = 0;
+    std::string heap_;
+};
+
+// Объект JSON с полями запроса, который передаётся приёмнику значением атрибута записи
+using RequestJson = InlineString<256>;
+
+// Буфер для текстового представления IP-адреса
+using IpText = std::array<char, 64>;
+
+// Записывает адрес в buffer без выделения памяти и возвращает его текст
+std::string_view FormatIp(const boost::asio::ip::address& address, IpText& buffer);
+
+// Сведения об обработанном запросе
+struct RequestInfo {
+    std::string_view ip;
+    std::string_view method;
+    std::string_view uri;
+    unsigned status = 0;
+    std::chrono::milliseconds response_time{0};
+    std::string_view content_type;
+};
+
+// Дописывает в out строку JSON в кавычках, экранируя спецсимволы
+void AppendJsonString(std::string& out, std::string_view str);
+
+// Дописывает в out объект JSON с полями запроса
+void AppendRequestJson(std::string& out, const RequestInfo& info);
+
+/*
+ * Приёмник записей журнала доступа для Boost.Log.
+ * Каждая запись выводится строкой JSON
+ *   {"timestamp":"...","data":{...},"message":"response sent"}
+ * Строки накапливаются в буфере и записываются в поток пачками.
+ * Требование flushing нужно, чтобы фронтенд вызывал flush и остаток буфера не терялся.
+ */
+class JsonLinesBackend
+    : public boost::log::sinks::basic_sink_backend<boost::log::sinks::combine_requirements<
+          boost::log::sinks::synchronized_feeding, boost::log::sinks::flushing>::type> {
+public:
+    static constexpr size_t BATCH_SIZE = 64 * 1024;
+
+    explicit JsonLinesBackend(std::ostream& output);
+
+    void consume(const boost::log::record_view& rec);
+    void flush();
+
+private:
+    void AppendTimestamp(std::chrono::system_clock::time_point time);
+    void WriteBatch();
+
+    std::ostream& output_;
+    std::string batch_;
+    // Отформатированные дата и время последней встреченной секунды
+    std::chrono::system_clock::time_point cached_second_{};
+    std::string cached_second_text_;
+};
+
+/*
+ * Журнал доступа HTTP-сервера.
+ * Log вызывается на потоках io_context: объект JSON с полями запроса собирается вручную
+ * и вместе с моментом записи передаётся в асинхронный приёмник Boost.Log значениями
+ * атрибутов, без форматирования через поток. Объект JSON хранится в записи
+ * без отдельного выделения памяти, если помещается в RequestJson.
+ * Собственный поток приёмника забирает записи из очереди сразу, как они появляются,
+ * и форматирует строки в пачку, которая записывается в поток по заполнении BATCH_SIZE.
+ * Ещё один фоновый поток раз в FLUSH_INTERVAL записывает неполную пачку, чтобы записи
+ * не задерживались в буфере при малой нагрузке. Очередь приёмника вмещает QUEUE_CAPACITY
+ * записей; Log ждёт, только если записи поступают быстрее, чем поток приёмника их выводит.
+ * В журнал попадают только записи канала "access", остальные записи Boost.Log он не видит.
+ */
+class AccessLog {
+public:
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{100};
+    static constexpr size_t QUEUE_CAPACITY = 64 * 1024;
+
+    explicit AccessLog(std::ostream& output);
+
+    AccessLog(const AccessLog&) = delete;
+    AccessLog& operator=(const AccessLog&) = delete;
+
+    // Записывает в поток все накопившиеся записи
+    ~AccessLog();
+
+    void Log(const RequestInfo& info);
+
+    // Ждёт, пока записи, сделанные до вызова, окажутся в потоке
+    void Flush();
+
+private:
+    using Sink = boost::log::sinks::asynchronous_sink<
+        JsonLinesBackend, boost::log::sinks::bounded_fifo_queue<
+                              QUEUE_CAPACITY, boost::log::sinks::block_on_overflow>>;
+
+    void RunFlusher();
+
+    boost::shared_ptr<Sink> sink_;
+
+    std::mutex mutex_;
+    std::condition_variable stop_cv_;
+    bool stopping_ = false;
+    std::thread flusher_;
+};
+
+}  // namespace access_log
@@ -8,6 +8,8 @@ model::Game LoadGame(const std::filesystem::path& json_path) {
     // Загрузить модель игры из файла
     model::Game game;
 
+    // После загрузки всех карт строим индекс для поиска карты за одно обращение
+    game.BuildMapIndex();
     return game;
 }
 
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <thread>
 
+#include "access_log.h"
 #include "json_loader.h"
 #include "request_handler.h"
 
@@ -42,13 +43,20 @@ int main(int argc, const char* argv[]) {
 
         // 3. Добавляем асинхронный обработчик сигналов SIGINT и SIGTERM
 
-        // 4. Создаём обработчик HTTP-запросов и связываем его с моделью игры
+        // 4. Создаём обработчик HTTP-запросов и связываем его с моделью игры.
+        // Декоратор записывает каждый обработанный запрос в журнал доступа в stdout
         http_handler::RequestHandler handler{game};
+        access_log::AccessLog access_log{std::cout};
+        http_handler::LoggingRequestHandler logging_handler{handler, access_log};
 
-        // 5. Запустить обработчик HTTP-запросов, делегируя их обработчику запросов
+        // 5. Запустить обработчик HTTP-запросов, делегируя их обработчику запросов.
+        // Сервер передаёт обработчику адрес клиента вместе с запросом
         /*
-        http_server::ServeHttp(ioc, {address, port}, [&handler](auto&& req, auto&& send) {
-            handler(std::forward<decltype(req)>(req), std::forward<decltype(send)>(send));
+        http_server::ServeHttp(ioc, {address, port},
+                               [&logging_handler](const net::ip::address& client, auto&& req,
+                                                  auto&& send) {
+            logging_handler(client, std::forward<decltype(req)>(req),
+                            std::forward<decltype(send)>(send));
         });
         */
 
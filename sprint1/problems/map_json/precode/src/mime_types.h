@@ -0,0 +1,144 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace http_handler {
+
+inline constexpr std::string_view DEFAULT_CONTENT_TYPE = "application/octet-stream";
+
+namespace mime_detail {
+
+using namespace std::literals;
+
+struct MimeType {
+    // Расширение строчными буквами, без точки
+    std::string_view extension;
+    std::string_view content_type;
+};
+
+inline constexpr MimeType MIME_TYPES[] = {
+    {"htm"sv, "text/html"sv},
+    {"html"sv, "text/html"sv},
+    {"css"sv, "text/css"sv},
+    {"txt"sv, "text/plain"sv},
+    {"js"sv, "text/javascript"sv},
+    {"json"sv, "application/json"sv},
+    {"xml"sv, "application/xml"sv},
+    {"png"sv, "image/png"sv},
+    {"jpg"sv, "image/jpeg"sv},
+    {"jpe"sv, "image/jpeg"sv},
+    {"jpeg"sv, "image/jpeg"sv},
+    {"gif"sv, "image/gif"sv},
+    {"bmp"sv, "image/bmp"sv},
+    {"ico"sv, "image/vnd.microsoft.icon"sv},
+    {"tiff"sv, "image/tiff"sv},
+    {"tif"sv, "image/tiff"sv},
+    {"svg"sv, "image/svg+xml"sv},
+    {"svgz"sv, "image/svg+xml"sv},
+    {"mp3"sv, "audio/mpeg"sv},
+    {"obj"sv, "model/obj"sv},
+    {"webmanifest"sv, "application/manifest+json"sv},
+};
+
+inline constexpr size_t MAX_EXTENSION_SIZE = [] {
+    size_t max_size = 0;
+    for (const auto& mime_type : MIME_TYPES) {
+        max_size = std::max(max_size, mime_type.extension.size());
+    }
+    return max_size;
+}();
+
+// Число ячеек таблицы - степень двойки не меньше удвоенного числа расширений
+inline constexpr size_t TABLE_SIZE = [] {
+    size_t size = 1;
+    while (size < 2 * std::size(MIME_TYPES)) {
+        size *= 2;
+    }
+    return size;
+}();
+
+constexpr char ToLower(char c) noexcept {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// FNV-1a над символами, приведёнными к нижнему регистру, с начальным значением seed.
+// Для букв приведение сводится к установке бита 0x20. Остальные символы хешируются
+// так же, ведь расширение из таблицы всё равно сравнивается с исходным посимвольно
+constexpr size_t GetSlot(std::string_view extension, uint32_t seed) noexcept {
+    uint32_t hash = 2166136261u ^ seed;
+    for (const char c : extension) {
+        hash = (hash ^ static_cast<uint8_t>(c | 0x20)) * 16777619u;
+    }
+    return (hash ^ (hash >> 15)) & (TABLE_SIZE - 1);
+}
+
+constexpr bool HasCollisions(uint32_t seed) noexcept {
+    std::array<bool, TABLE_SIZE> used{};
+    for (const auto& mime_type : MIME_TYPES) {
+        const size_t slot = GetSlot(mime_type.extension, seed);
+        if (used[slot]) {
+            return true;
+        }
+        used[slot] = true;
+    }
+    return false;
+}
+
+// Первое начальное значение хеша, при котором все расширения попадают в разные ячейки
+inline constexpr uint32_t SEED = [] {
+    uint32_t seed = 0;
+    while (HasCollisions(seed)) {
+        ++seed;
+    }
+    return seed;
+}();
+
+/*
+ * Совершенная хеш-таблица расширений, построенная при компиляции:
+ * каждое расширение занимает свою ячейку, поэтому поиск - это вычисление хеша
+ * и одно сравнение строк без учёта регистра.
+ */
+inline constexpr std::array<MimeType, TABLE_SIZE> TABLE = [] {
+    std::array<MimeType, TABLE_SIZE> table{};
+    for (const auto& mime_type : MIME_TYPES) {
+        table[GetSlot(mime_type.extension, SEED)] = mime_type;
+    }
+    return table;
+}();
+
+constexpr bool EqualsIgnoreCase(std::string_view str, std::string_view lower) noexcept {
+    if (str.size() != lower.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (ToLower(str[i]) != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace mime_detail
+
+/*
+ * Возвращает MIME-тип по расширению файла (с точкой или без), без учёта регистра.
+ * Для неизвестных расширений возвращает DEFAULT_CONTENT_TYPE.
+ * Возвращённая строка размещена в статической памяти.
+ */
+constexpr std::string_view GetContentType(std::string_view extension) noexcept {
+    using namespace mime_detail;
+    if (!extension.empty() && extension.front() == '.') {
+        extension.remove_prefix(1);
+    }
+    if (extension.empty() || extension.size() > MAX_EXTENSION_SIZE) {
+        return DEFAULT_CONTENT_TYPE;
+    }
+    const MimeType& candidate = TABLE[GetSlot(extension, SEED)];
+    return EqualsIgnoreCase(extension, candidate.extension) ? candidate.content_type
+                                                            : DEFAULT_CONTENT_TYPE;
+}
+
+}  // namespace http_handler
@@ -1,6 +1,7 @@
 #include "model.h"
 
 #include <stdexcept>
+#include <vector>
 
 namespace model {
 using namespace std::literals;
@@ -24,7 +25,8 @@ void Map::AddOffice(Office office) {
 void Game::AddMap(Map map) {
     const size_t index = maps_.size();
     if (auto [it, inserted] = map_id_to_index_.emplace(map.GetId(), index); !inserted) {
-        throw std::invalid_argument("Map with id "s + *map.GetId() + " already exists"s);
+        throw std::invalid_argument("Map with id "s + (*map.GetId()).GetString()
+                                    + " already exists"s);
     } else {
         try {
             maps_.emplace_back(std::move(map));
@@ -32,7 +34,18 @@ void Game::AddMap(Map map) {
             map_id_to_index_.erase(it);
             throw;
         }
+        map_index_.Clear();
     }
 }
 
+void Game::BuildMapIndex() {
+    std::vector<uint64_t> hashes;
+    hashes.reserve(maps_.size());
+    for (const auto& map : maps_) {
+        hashes.push_back((*map.GetId()).GetHash());
+    }
+    // Если построить таблицу не удалось, FindMap продолжит искать через map_id_to_index_
+    map_index_.Build(hashes);
+}
+
 }  // namespace model
@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "perfect_hash_index.h"
 #include "tagged.h"
 
 namespace model {
@@ -87,7 +88,7 @@ private:
 
 class Office {
 public:
-    using Id = util::Tagged<std::string, Office>;
+    using Id = util::Tagged<util::HashedString, Office>;
 
     Office(Id id, Point position, Offset offset) noexcept
         : id_{std::move(id)}
@@ -115,7 +116,7 @@ private:
 
 class Map {
 public:
-    using Id = util::Tagged<std::string, Map>;
+    using Id = util::Tagged<util::HashedString, Map>;
     using Roads = std::vector<Road>;
     using Buildings = std::vector<Building>;
     using Offices = std::vector<Office>;
@@ -173,11 +174,20 @@ public:
 
     void AddMap(Map map);
 
+    // Строит совершенную хеш-функцию по идентификаторам загруженных карт,
+    // после чего FindMap обращается к одной ячейке таблицы.
+    // Вызывается после загрузки всех карт; добавление карты сбрасывает таблицу
+    void BuildMapIndex();
+
     const Maps& GetMaps() const noexcept {
         return maps_;
     }
 
     const Map* FindMap(const Map::Id& id) const noexcept {
+        if (map_index_.IsBuilt()) {
+            const size_t index = map_index_.Find((*id).GetHash());
+            return index < maps_.size() && maps_[index].GetId() == id ? &maps_[index] : nullptr;
+        }
         if (auto it = map_id_to_index_.find(id); it != map_id_to_index_.end()) {
             return &maps_.at(it->second);
         }
@@ -190,6 +200,7 @@ private:
 
     std::vector<Map> maps_;
     MapIdToIndex map_id_to_index_;
+    util::PerfectHashIndex map_index_;
 };
 
 }  // namespace model
@@ -0,0 +1,113 @@
+#include "perfect_hash_index.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace util {
+
+bool PerfectHashIndex::Build(std::span<const uint64_t> hashes) {
+    Clear();
+    const size_t key_count = hashes.size();
+    if (key_count == 0 || key_count >= EMPTY_SLOT) {
+        return false;
+    }
+    std::vector<uint64_t> sorted(hashes.begin(), hashes.end());
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+        return false;
+    }
+
+    // В среднем около 4 ключей на корзину, таблица заполнена не более чем на 80%
+    const size_t bucket_count = std::max(std::bit_ceil(key_count) / 4, size_t{1});
+    size_t slot_count = std::bit_ceil(key_count + key_count / 4);
+    bucket_mask_ = bucket_count - 1;
+
+    // Номера ключей, сгруппированные по корзинам
+    std::vector<uint32_t> bucket_starts(bucket_count + 1, 0);
+    for (const uint64_t hash : hashes) {
+        ++bucket_starts[(hash & bucket_mask_) + 1];
+    }
+    for (size_t bucket = 0; bucket < bucket_count; ++bucket) {
+        bucket_starts[bucket + 1] += bucket_starts[bucket];
+    }
+    std::vector<uint32_t> bucket_keys(key_count);
+    {
+        std::vector<uint32_t> positions(bucket_starts.begin(), bucket_starts.end() - 1);
+        for (uint32_t key = 0; key < key_count; ++key) {
+            bucket_keys[positions[hashes[key] & bucket_mask_]++] = key;
+        }
+    }
+
+    // Первыми размещаются самые большие корзины, пока свободных ячеек много
+    std::vector<uint32_t> buckets(bucket_count);
+    for (uint32_t bucket = 0; bucket < bucket_count; ++bucket) {
+        buckets[bucket] = bucket;
+    }
+    std::stable_sort(buckets.begin(), buckets.end(), [&bucket_starts](uint32_t lhs, uint32_t rhs) {
+        return bucket_starts[lhs + 1] - bucket_starts[lhs]
+             > bucket_starts[rhs + 1] - bucket_starts[rhs];
+    });
+
+    // В маленькой таблице ключи одной корзины могут не разделяться ни при каком смещении:
+    // ячейки зависят только от младших битов f1 и f2. Тогда таблица увеличивается вдвое
+    for (int attempt = 0; attempt < MAX_BUILD_ATTEMPTS; ++attempt, slot_count *= 2) {
+        if (Place(hashes, bucket_keys, bucket_starts, buckets, slot_count)) {
+            return true;
+        }
+    }
+    Clear();
+    return false;
+}
+
+bool PerfectHashIndex::Place(std::span<const uint64_t> hashes,
+                             std::span<const uint32_t> bucket_keys,
+                             std::span<const uint32_t> bucket_starts,
+                             std::span<const uint32_t> buckets, size_t slot_count) {
+    slot_mask_ = slot_count - 1;
+    displacements_.assign(buckets.size(), 0);
+    slots_.assign(slot_count, EMPTY_SLOT);
+    std::vector<size_t> bucket_slots;
+    for (const uint32_t bucket : buckets) {
+        const auto keys = bucket_keys.subspan(bucket_starts[bucket],
+                                              bucket_starts[bucket + 1] - bucket_starts[bucket]);
+        if (keys.empty()) {
+            break;
+        }
+        // f2 нечётно, а размер таблицы - степень двойки, поэтому за slot_count смещений
+        // каждый ключ побывает во всех ячейках
+        bool placed = false;
+        for (size_t displacement = 0; displacement < slot_count && !placed; ++displacement) {
+            bucket_slots.clear();
+            placed = true;
+            for (const uint32_t key : keys) {
+                const size_t slot = GetSlot(hashes[key], static_cast<uint32_t>(displacement));
+                if (slots_[slot] != EMPTY_SLOT
+                    || std::find(bucket_slots.begin(), bucket_slots.end(), slot)
+                           != bucket_slots.end()) {
+                    placed = false;
+                    break;
+                }
+                bucket_slots.push_back(slot);
+            }
+            if (placed) {
+                displacements_[bucket] = static_cast<uint32_t>(displacement);
+                for (size_t i = 0; i < keys.size(); ++i) {
+                    slots_[bucket_slots[i]] = keys[i];
+                }
+            }
+        }
+        if (!placed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PerfectHashIndex::Clear() noexcept {
+    displacements_.clear();
+    slots_.clear();
+    bucket_mask_ = 0;
+    slot_mask_ = 0;
+}
+
+}  // namespace util
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace util {
+
+/*
+ * Совершенная хеш-функция над фиксированным набором 64-битных хешей ключей
+ * (схема "hash and displace").
+ *
+ * Ключи разбиваются на корзины по младшим битам хеша. Для каждой корзины подбирается
+ * смещение d, при котором ячейки (f1 + d * f2) mod M всех её ключей свободны.
+ * Если разместить корзину не удаётся, таблица увеличивается вдвое.
+ * Поиск вычисляет корзину, берёт её смещение и читает одну ячейку таблицы,
+ * где записан номер ключа. Для хеша, не входившего в набор, возвращается номер
+ * какого-то другого ключа или NOT_FOUND, поэтому вызывающий код должен сравнить ключи.
+ */
+class PerfectHashIndex {
+public:
+    static constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+
+    // Строит таблицу, в которой хеш hashes[i] отображается в номер i.
+    // Возвращает false и оставляет таблицу пустой, если набор пуст или в нём есть
+    // одинаковые хеши
+    bool Build(std::span<const uint64_t> hashes);
+
+    void Clear() noexcept;
+
+    bool IsBuilt() const noexcept {
+        return !slots_.empty();
+    }
+
+    // Для непостроенной таблицы возвращает NOT_FOUND
+    size_t Find(uint64_t hash) const noexcept {
+        if (!IsBuilt()) {
+            return NOT_FOUND;
+        }
+        const uint32_t displacement = displacements_[hash & bucket_mask_];
+        const uint32_t key = slots_[GetSlot(hash, displacement)];
+        return key == EMPTY_SLOT ? NOT_FOUND : key;
+    }
+
+private:
+    static constexpr uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+    static constexpr int MAX_BUILD_ATTEMPTS = 8;
+
+    // Размещает ключи корзин buckets (в порядке размещения) в таблице из slot_count ячеек
+    bool Place(std::span<const uint64_t> hashes, std::span<const uint32_t> bucket_keys,
+               std::span<const uint32_t> bucket_starts, std::span<const uint32_t> buckets,
+               size_t slot_count);
+
+    size_t GetSlot(uint64_t hash, uint32_t displacement) const noexcept {
+        const auto f1 = static_cast<uint32_t>(hash >> 32);
+        const auto f2 = static_cast<uint32_t>((hash * 0x9e3779b97f4a7c15) >> 32) | 1u;
+        return (f1 + static_cast<uint64_t>(displacement) * f2) & slot_mask_;
+    }
+
+    std::vector<uint32_t> displacements_;
+    std::vector<uint32_t> slots_;
+    uint64_t bucket_mask_ = 0;
+    uint64_t slot_mask_ = 0;
+};
+
+}  // namespace util
@@ -1,6 +1,12 @@
 #pragma once
+#include <boost/asio/ip/address.hpp>
+#include <chrono>
+#include <string>
+
+#include "access_log.h"
 #include "http_server.h"
 #include "model.h"
+#include "request_target.h"
 
 namespace http_handler {
 namespace beast = boost::beast;
@@ -17,11 +23,66 @@ public:
 
     template <typename Body, typename Allocator, typename Send>
     void operator()(http::request<Body, http::basic_fields<Allocator>>&& req, Send&& send) {
-        // Обработать запрос request и отправить ответ, используя send
+        // Цель запроса разбирается один раз, дальше используются только её части
+        const auto raw_target = req.target();
+        const RequestTarget target{{raw_target.data(), raw_target.size()}};
+        HandleRequest(target, req, std::forward<Send>(send));
     }
 
 private:
+    template <typename Body, typename Allocator, typename Send>
+    void HandleRequest(
+        [[maybe_unused]] const RequestTarget& target,
+        [[maybe_unused]] const http::request<Body, http::basic_fields<Allocator>>& req,
+        [[maybe_unused]] Send&& send) {
+        // Обработать запрос request и отправить ответ, используя send
+    }
+
     model::Game& game_;
 };
 
+/*
+ * Декоратор обработчика запросов: передаёт запрос обработчику и записывает
+ * в журнал доступа метод, URI, код и тип содержимого ответа, время обработки
+ * и адрес клиента.
+ */
+template <typename Handler>
+class LoggingRequestHandler {
+public:
+    LoggingRequestHandler(Handler& handler, access_log::AccessLog& log)
+        : handler_{handler}
+        , log_{log} {
+    }
+
+    template <typename Body, typename Allocator, typename Send>
+    void operator()(const boost::asio::ip::address& client,
+                    http::request<Body, http::basic_fields<Allocator>>&& req, Send&& send) {
+        const auto start = std::chrono::steady_clock::now();
+        const http::verb method = req.method();
+        // Запрос передаётся обработчику, поэтому URI копируется. Обычно он помещается в объект
+        const auto target = req.target();
+        UriText uri{{target.data(), target.size()}};
+        handler_(std::move(req), [this, start, client, method, uri = std::move(uri),
+                                  send = std::forward<Send>(send)](auto&& response) mutable {
+            access_log::IpText ip_buffer;
+            const auto method_name = http::to_string(method);
+            const auto content_type = response[http::field::content_type];
+            log_.Log({.ip = access_log::FormatIp(client, ip_buffer),
+                      .method = {method_name.data(), method_name.size()},
+                      .uri = uri.GetText(),
+                      .status = response.result_int(),
+                      .response_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - start),
+                      .content_type = {content_type.data(), content_type.size()}});
+            send(std::forward<decltype(response)>(response));
+        });
+    }
+
+private:
+    using UriText = access_log::InlineString<128>;
+
+    Handler& handler_;
+    access_log::AccessLog& log_;
+};
+
 }  // namespace http_handler
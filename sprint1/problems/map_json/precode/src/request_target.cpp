@@ -0,0 +1,63 @@
+#include "request_target.h"
+
+#include <array>
+
+#include "urldecode.h"
+
+namespace http_handler {
+
+bool EncodedPart::IsEncoded() const noexcept {
+    return HasUrlEscapes(raw_);
+}
+
+std::string_view EncodedPart::Decode(std::string& buffer) const {
+    if (!IsEncoded()) {
+        return raw_;
+    }
+    buffer.resize(raw_.size());
+    buffer.resize(static_cast<size_t>(UrlDecodeTo(raw_, buffer.data()) - buffer.data()));
+    return buffer;
+}
+
+std::string EncodedPart::Decode() const {
+    return UrlDecode(raw_);
+}
+
+bool EncodedPart::Equals(std::string_view decoded) const {
+    if (!IsEncoded()) {
+        return raw_ == decoded;
+    }
+    // Декодированная строка не длиннее исходной
+    if (decoded.size() > raw_.size()) {
+        return false;
+    }
+    std::array<char, 256> stack_buffer;
+    if (raw_.size() <= stack_buffer.size()) {
+        const char* const end = UrlDecodeTo(raw_, stack_buffer.data());
+        return std::string_view{stack_buffer.data(), static_cast<size_t>(end - stack_buffer.data())}
+            == decoded;
+    }
+    return UrlDecode(raw_) == decoded;
+}
+
+RequestTarget::RequestTarget(std::string_view target) noexcept {
+    if (const size_t hash = target.find('#'); hash != std::string_view::npos) {
+        target = target.substr(0, hash);
+    }
+    const size_t question = target.find('?');
+    path_ = target.substr(0, question);
+    if (question != std::string_view::npos) {
+        query_ = target.substr(question + 1);
+    }
+}
+
+std::optional<EncodedPart> RequestTarget::FindQueryParam(std::string_view name) const {
+    for (const QueryParam& param : GetQueryParams()) {
+        if (param.name.Equals(name)) {
+            return param.value;
+        }
+    }
+    return std::nullopt;
+}
+
+}  // namespace http_handler
@@ -0,0 +1,282 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace http_handler {
+
+/*
+ * Часть цели запроса в исходном, URL-кодированном виде: сегмент пути,
+ * имя или значение параметра запроса.
+ * Декодирование выполняется только по требованию и только если в части
+ * есть символы '%' или '+'. Ошибки декодирования сообщаются исключением
+ * std::invalid_argument, как в UrlDecode.
+ */
+class EncodedPart {
+public:
+    EncodedPart() = default;
+
+    explicit EncodedPart(std::string_view raw) noexcept
+        : raw_{raw} {
+    }
+
+    std::string_view GetRaw() const noexcept {
+        return raw_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return raw_.empty();
+    }
+
+    // Есть ли в части %-последовательности или '+'
+    bool IsEncoded() const noexcept;
+
+    // Декодированное значение. Часть без '%' и '+' возвращается как есть, без копирования,
+    // иначе она декодируется в buffer. Результат действителен, пока жив buffer
+    // и буфер исходной цели запроса
+    std::string_view Decode(std::string& buffer) const;
+
+    std::string Decode() const;
+
+    // Сравнивает декодированное значение со строкой decoded.
+    // Короткие закодированные части декодируются в буфер на стеке
+    bool Equals(std::string_view decoded) const;
+
+private:
+    std::string_view raw_;
+};
+
+namespace detail {
+
+/*
+ * Однонаправленный итератор по частям строки, разделённым символом SEPARATOR.
+ * Пустая строка не содержит частей. Если SKIP_EMPTY == true, пустые части пропускаются.
+ */
+template <char SEPARATOR, bool SKIP_EMPTY>
+class SplitIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view*;
+    using reference = const std::string_view&;
+
+    // Итератор конца
+    SplitIterator() = default;
+
+    explicit SplitIterator(std::string_view str) noexcept
+        : rest_{str}
+        , has_rest_{!str.empty()}
+        , at_end_{false} {
+        Next();
+    }
+
+    reference operator*() const noexcept {
+        return current_;
+    }
+
+    pointer operator->() const noexcept {
+        return &current_;
+    }
+
+    SplitIterator& operator++() noexcept {
+        Next();
+        return *this;
+    }
+
+    SplitIterator operator++(int) noexcept {
+        SplitIterator old = *this;
+        Next();
+        return old;
+    }
+
+    bool operator==(const SplitIterator& other) const noexcept {
+        return at_end_ == other.at_end_ && (at_end_ || current_.data() == other.current_.data());
+    }
+
+private:
+    void Next() noexcept {
+        do {
+            if (!has_rest_) {
+                at_end_ = true;
+                current_ = {};
+                return;
+            }
+            if (const size_t pos = rest_.find(SEPARATOR); pos != std::string_view::npos) {
+                current_ = rest_.substr(0, pos);
+                rest_.remove_prefix(pos + 1);
+            } else {
+                current_ = rest_;
+                has_rest_ = false;
+            }
+        } while (SKIP_EMPTY && current_.empty());
+    }
+
+    std::string_view current_;
+    std::string_view rest_;
+    bool has_rest_ = false;
+    bool at_end_ = true;
+};
+
+}  // namespace detail
+
+// Сегменты пути: "/api/v1/maps" -> "api", "v1", "maps"; "/maps/" -> "maps", ""
+class PathSegments {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = EncodedPart;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = EncodedPart;
+
+        Iterator() = default;
+
+        explicit Iterator(detail::SplitIterator<'/', false> it) noexcept
+            : it_{it} {
+        }
+
+        EncodedPart operator*() const noexcept {
+            return EncodedPart{*it_};
+        }
+
+        Iterator& operator++() noexcept {
+            ++it_;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++it_;
+            return old;
+        }
+
+        bool operator==(const Iterator&) const noexcept = default;
+
+    private:
+        detail::SplitIterator<'/', false> it_;
+    };
+
+    explicit PathSegments(std::string_view path) noexcept
+        : path_{path} {
+    }
+
+    Iterator begin() const noexcept {
+        return Iterator{detail::SplitIterator<'/', false>{path_}};
+    }
+
+    Iterator end() const noexcept {
+        return {};
+    }
+
+private:
+    std::string_view path_;
+};
+
+struct QueryParam {
+    EncodedPart name;
+    EncodedPart value;
+};
+
+// Параметры запроса: "a=1&b&&c=" -> {a, 1}, {b, ""}, {c, ""}
+class QueryParams {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = QueryParam;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = QueryParam;
+
+        Iterator() = default;
+
+        explicit Iterator(detail::SplitIterator<'&', true> it) noexcept
+            : it_{it} {
+        }
+
+        QueryParam operator*() const noexcept {
+            const std::string_view param = *it_;
+            const size_t eq = param.find('=');
+            if (eq == std::string_view::npos) {
+                return {EncodedPart{param}, EncodedPart{}};
+            }
+            return {EncodedPart{param.substr(0, eq)}, EncodedPart{param.substr(eq + 1)}};
+        }
+
+        Iterator& operator++() noexcept {
+            ++it_;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++it_;
+            return old;
+        }
+
+        bool operator==(const Iterator&) const noexcept = default;
+
+    private:
+        detail::SplitIterator<'&', true> it_;
+    };
+
+    explicit QueryParams(std::string_view query) noexcept
+        : query_{query} {
+    }
+
+    Iterator begin() const noexcept {
+        return Iterator{detail::SplitIterator<'&', true>{query_}};
+    }
+
+    Iterator end() const noexcept {
+        return {};
+    }
+
+private:
+    std::string_view query_;
+};
+
+/*
+ * Разобранная цель HTTP-запроса (request-target), например
+ *   /api/v1/maps/map%201?lang=ru&debug
+ * Хранит только представления строк в буфере исходного запроса и ничего не копирует:
+ * путь делится на сегменты, строка запроса - на параметры по мере обхода,
+ * а декодируются части, только если в них есть '%' или '+'.
+ * Для целей без таких символов разбор и маршрутизация обходятся без выделения памяти.
+ * Объект действителен, пока жив буфер, на который указывает target.
+ */
+class RequestTarget {
+public:
+    explicit RequestTarget(std::string_view target) noexcept;
+
+    // Путь в исходном виде, вместе с начальным '/'
+    EncodedPart GetPath() const noexcept {
+        return EncodedPart{path_};
+    }
+
+    // Строка запроса после '?' в исходном виде, без фрагмента
+    std::string_view GetQuery() const noexcept {
+        return query_;
+    }
+
+    PathSegments GetSegments() const noexcept {
+        return PathSegments{path_.empty() || path_.front() != '/' ? path_ : path_.substr(1)};
+    }
+
+    QueryParams GetQueryParams() const noexcept {
+        return QueryParams{query_};
+    }
+
+    // Первый параметр запроса с декодированным именем name
+    std::optional<EncodedPart> FindQueryParam(std::string_view name) const;
+
+private:
+    std::string_view path_;
+    std::string_view query_;
+};
+
+}  // namespace http_handler
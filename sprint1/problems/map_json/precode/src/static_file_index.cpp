@@ -0,0 +1,202 @@
+#include "static_file_index.h"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include "mime_types.h"
+
+namespace http_handler {
+
+namespace fs = std::filesystem;
+using namespace std::literals;
+
+namespace {
+
+constexpr uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM
+                              | IN_MOVED_TO | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF
+                              | IN_ONLYDIR;
+
+// Изменения обычно приходят пачкой (копирование каталога, сборка клиента), поэтому индекс
+// перестраивается, когда уведомления перестают поступать в течение этого времени
+constexpr int SETTLE_TIMEOUT_MS = 50;
+
+constexpr std::string_view INDEX_FILE = "index.html"sv;
+
+}  // namespace
+
+StaticFileIndex::StaticFileIndex(const fs::path& root, Watch watch) {
+    if (!fs::is_directory(root)) {
+        throw std::invalid_argument("Static content root is not a directory: "s + root.string());
+    }
+    root_ = fs::canonical(root);
+
+    if (watch == Watch::ENABLED) {
+        inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "inotify_init1");
+        }
+        stop_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (stop_fd_ < 0) {
+            const int error = errno;
+            close(inotify_fd_);
+            throw std::system_error(error, std::generic_category(), "eventfd");
+        }
+    }
+
+    try {
+        Rebuild();
+    } catch (...) {
+        if (inotify_fd_ >= 0) {
+            close(inotify_fd_);
+            close(stop_fd_);
+        }
+        throw;
+    }
+
+    if (watch == Watch::ENABLED) {
+        watcher_ = std::thread{[this] {
+            RunWatcher();
+        }};
+    }
+}
+
+StaticFileIndex::~StaticFileIndex() {
+    if (watcher_.joinable()) {
+        const uint64_t one = 1;
+        [[maybe_unused]] const auto written = write(stop_fd_, &one, sizeof(one));
+        watcher_.join();
+    }
+    if (inotify_fd_ >= 0) {
+        close(inotify_fd_);
+        close(stop_fd_);
+    }
+}
+
+std::shared_ptr<const StaticFileIndex::FileInfo> StaticFileIndex::Find(
+    std::string_view decoded_path) const {
+    if (!decoded_path.empty() && decoded_path.front() == '/') {
+        decoded_path.remove_prefix(1);
+    }
+    auto files = files_.load(std::memory_order_acquire);
+    const auto it = files->find(decoded_path);
+    if (it == files->end()) {
+        return nullptr;
+    }
+    // Запись держит весь индекс, в котором найдена, поэтому переживёт его подмену
+    return {std::move(files), &it->second};
+}
+
+size_t StaticFileIndex::GetFileCount() const {
+    return files_.load(std::memory_order_acquire)->size();
+}
+
+void StaticFileIndex::Rebuild() {
+    // Наблюдение за каталогами добавляется во время обхода, поэтому изменения,
+    // сделанные после обхода каталога, не будут пропущены
+    auto files = Scan([this](const fs::path& dir) {
+        AddWatch(dir);
+    });
+    files_.store(std::move(files), std::memory_order_release);
+}
+
+std::shared_ptr<const StaticFileIndex::Files> StaticFileIndex::Scan(
+    const std::function<void(const fs::path&)>& on_directory) const {
+    auto files = std::make_shared<Files>();
+    on_directory(root_);
+
+    std::error_code ec;
+    fs::recursive_directory_iterator it{root_, fs::directory_options::skip_permission_denied, ec};
+    for (; !ec && it != fs::recursive_directory_iterator{}; it.increment(ec)) {
+        const fs::directory_entry& entry = *it;
+        std::error_code entry_ec;
+        // Каталоги-ссылки и так не обходятся, а ссылки на файлы могут вести за пределы root
+        if (entry.is_symlink(entry_ec)) {
+            continue;
+        }
+        if (entry.is_directory(entry_ec)) {
+            on_directory(entry.path());
+            continue;
+        }
+        if (!entry.is_regular_file(entry_ec)) {
+            continue;
+        }
+        // Файл может быть удалён во время обхода, такие файлы пропускаются
+        FileInfo info{entry.path(), entry.file_size(entry_ec), entry.last_write_time(entry_ec),
+                      GetContentType(entry.path().extension().native())};
+        if (entry_ec) {
+            continue;
+        }
+        files->emplace(entry.path().lexically_relative(root_).generic_string(), std::move(info));
+    }
+
+    // Путь каталога ("", "js/") ведёт на его index.html
+    std::vector<std::pair<std::string, FileInfo>> directory_indexes;
+    for (const auto& [relative_path, info] : *files) {
+        const std::string_view path = relative_path;
+        if (path.ends_with(INDEX_FILE)
+            && (path.size() == INDEX_FILE.size() || path[path.size() - INDEX_FILE.size() - 1] == '/')) {
+            directory_indexes.emplace_back(path.substr(0, path.size() - INDEX_FILE.size()), info);
+        }
+    }
+    for (auto& [dir, info] : directory_indexes) {
+        files->emplace(std::move(dir), std::move(info));
+    }
+    return files;
+}
+
+void StaticFileIndex::AddWatch(const fs::path& dir) const {
+    // Повторное добавление каталога, за которым уже ведётся наблюдение, ничего не меняет
+    if (inotify_fd_ >= 0) {
+        inotify_add_watch(inotify_fd_, dir.c_str(), WATCH_MASK);
+    }
+}
+
+void StaticFileIndex::RunWatcher() {
+    alignas(inotify_event) std::array<char, 16 * 1024> buffer;
+    const auto drain = [this, &buffer] {
+        bool changed = false;
+        ssize_t size;
+        while ((size = read(inotify_fd_, buffer.data(), buffer.size())) > 0) {
+            changed = true;
+        }
+        return changed;
+    };
+
+    std::array<pollfd, 2> fds{pollfd{inotify_fd_, POLLIN, 0}, pollfd{stop_fd_, POLLIN, 0}};
+    bool pending = false;
+    while (true) {
+        // Пока есть необработанные изменения, ждём затишья, иначе ждём без ограничения
+        const int ready = poll(fds.data(), fds.size(), pending ? SETTLE_TIMEOUT_MS : -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents != 0) {
+            return;
+        }
+        if (ready > 0 && (fds[0].revents & POLLIN)) {
+            pending = drain() || pending;
+            continue;
+        }
+        if (pending) {
+            pending = false;
+            try {
+                Rebuild();
+            } catch (const std::exception&) {
+                // Каталог временно недоступен: остаётся прежний индекс до следующего изменения
+            }
+        }
+    }
+}
+
+}  // namespace http_handler
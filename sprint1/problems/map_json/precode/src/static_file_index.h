@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace http_handler {
+
+/*
+ * Индекс статических файлов.
+ *
+ * При создании обходит каталог root и строит хеш-таблицу, в которой по декодированному
+ * относительному пути файла ("index.html", "js/game.js", "file with spaces.html")
+ * хранятся полный путь, размер, время изменения и MIME-тип файла. Пути каталогов,
+ * в которых есть index.html ("", "js/"), ведут на этот index.html.
+ *
+ * Поиск - одно обращение к хеш-таблице без системных вызовов и без обращения к файловой
+ * системе. Выйти за пределы root невозможно: в таблице есть только файлы, найденные
+ * при обходе root, поэтому пути вроде "../secret" или "/etc/passwd" просто не находятся.
+ * Символические ссылки не индексируются, так как могут вести за пределы root.
+ *
+ * Если включено наблюдение, фоновый поток получает через inotify уведомления
+ * об изменениях в каталогах и перестраивает индекс. Новый индекс подменяет старый
+ * атомарно, а уже найденные записи остаются действительными, пока на них есть ссылки.
+ */
+class StaticFileIndex {
+public:
+    struct FileInfo {
+        std::filesystem::path path;
+        std::uintmax_t size = 0;
+        std::filesystem::file_time_type last_write_time;
+        std::string_view content_type;
+    };
+
+    enum class Watch { DISABLED, ENABLED };
+
+    // Выбрасывает std::invalid_argument, если root не является каталогом
+    explicit StaticFileIndex(const std::filesystem::path& root, Watch watch = Watch::ENABLED);
+
+    StaticFileIndex(const StaticFileIndex&) = delete;
+    StaticFileIndex& operator=(const StaticFileIndex&) = delete;
+
+    ~StaticFileIndex();
+
+    // Ищет файл по декодированному пути из запроса, например "/js/game.js".
+    // Возвращает nullptr, если такого файла в индексе нет
+    std::shared_ptr<const FileInfo> Find(std::string_view decoded_path) const;
+
+    size_t GetFileCount() const;
+
+    const std::filesystem::path& GetRoot() const noexcept {
+        return root_;
+    }
+
+    // Заново обходит каталог и подменяет индекс
+    void Rebuild();
+
+private:
+    struct StringHash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view str) const noexcept {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
+    using Files = std::unordered_map<std::string, FileInfo, StringHash, std::equal_to<>>;
+
+    // Обходит каталог root_, вызывая on_directory для каждого каталога, включая root_
+    std::shared_ptr<const Files> Scan(
+        const std::function<void(const std::filesystem::path&)>& on_directory) const;
+    void AddWatch(const std::filesystem::path& dir) const;
+    void RunWatcher();
+
+    std::filesystem::path root_;
+    std::atomic<std::shared_ptr<const Files>> files_;
+
+    int inotify_fd_ = -1;
+    int stop_fd_ = -1;
+    std::thread watcher_;
+};
+
+}  // namespace http_handler
@@ -1,5 +1,12 @@
 #pragma once
+#include <algorithm>
+#include <bit>
 #include <compare>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
 
 namespace util {
 
@@ -63,4 +70,77 @@ struct TaggedHasher {
     }
 };
 
+/*
+ * Строка с заранее вычисленным хешем.
+ * Хеш вычисляется один раз при создании строки и не зависит от реализации
+ * стандартной библиотеки, поэтому его можно сохранять и сравнивать между запусками.
+ * При сравнении на равенство сначала сравниваются хеши, и только при их совпадении - строки.
+ * Пример:
+ *
+ *  struct MapTag{};
+ *  using MapId = util::Tagged<util::HashedString, MapTag>;
+ *  std::unordered_map<MapId, size_t, util::TaggedHasher<MapId>> maps;
+ */
+class HashedString {
+public:
+    HashedString(std::string value)
+        : value_(std::move(value))
+        , hash_(ComputeHash(value_)) {
+    }
+
+    HashedString(const char* value)
+        : HashedString(std::string(value)) {
+    }
+
+    const std::string& GetString() const noexcept {
+        return value_;
+    }
+
+    operator const std::string&() const noexcept {
+        return value_;
+    }
+
+    uint64_t GetHash() const noexcept {
+        return hash_;
+    }
+
+    bool operator==(const HashedString& other) const noexcept {
+        return hash_ == other.hash_ && value_ == other.value_;
+    }
+
+    std::strong_ordering operator<=>(const HashedString& other) const noexcept {
+        return value_ <=> other.value_;
+    }
+
+    // Хеш по 8 байт за шаг с итоговым перемешиванием (splitmix64).
+    // Байты слова читаются в порядке little-endian на любой платформе
+    static uint64_t ComputeHash(std::string_view value) noexcept {
+        constexpr uint64_t MULTIPLIER = 0x9e3779b97f4a7c15;
+        uint64_t hash = 0xcbf29ce484222325 ^ (value.size() * MULTIPLIER);
+        while (!value.empty()) {
+            const size_t count = std::min(value.size(), sizeof(uint64_t));
+            uint64_t word = 0;
+            for (size_t i = 0; i < count; ++i) {
+                word |= static_cast<uint64_t>(static_cast<unsigned char>(value[i])) << (8 * i);
+            }
+            hash = std::rotl((hash ^ word) * MULTIPLIER, 29);
+            value.remove_prefix(count);
+        }
+        hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+        hash = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+        return hash ^ (hash >> 31);
+    }
+
+private:
+    std::string value_;
+    uint64_t hash_;
+};
+
 }  // namespace util
+
+template <>
+struct std::hash<util::HashedString> {
+    size_t operator()(const util::HashedString& value) const noexcept {
+        return static_cast<size_t>(value.GetHash());
+    }
+};
@@ -0,0 +1,161 @@
+#include "urldecode.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr uint8_t NOT_HEX = 0xFF;
+
+// Значение шестнадцатеричной цифры по коду символа, NOT_HEX для остальных символов
+constexpr std::array<uint8_t, 256> HEX_VALUES = [] {
+    std::array<uint8_t, 256> values{};
+    values.fill(NOT_HEX);
+    for (int i = 0; i < 10; ++i) {
+        values['0' + i] = static_cast<uint8_t>(i);
+    }
+    for (int i = 0; i < 6; ++i) {
+        values['a' + i] = values['A' + i] = static_cast<uint8_t>(10 + i);
+    }
+    return values;
+}();
+
+[[noreturn]] void ThrowIncompleteEscape() {
+    throw std::invalid_argument("Incomplete %-escape sequence");
+}
+
+// Декодирует символы c1 и c2 %-последовательности в байт
+char DecodeEscape(char c1, char c2) {
+    const uint8_t high = HEX_VALUES[static_cast<unsigned char>(c1)];
+    const uint8_t low = HEX_VALUES[static_cast<unsigned char>(c2)];
+    // NOT_HEX больше любой цифры, поэтому одна проверка ловит ошибку в любом из символов
+    if ((high | low) > 0x0F) {
+        throw std::invalid_argument("Invalid %-escape sequence");
+    }
+    return static_cast<char>((high << 4) | low);
+}
+
+// Возвращает указатель на первый символ '%' или '+' в [p, end) либо end.
+// Участки без этих символов проверяются по 32 (AVX2) или 16 (SSE2) байт за шаг
+const char* FindSpecial(const char* p, const char* end) noexcept {
+#if defined(__AVX2__)
+    const __m256i percent32 = _mm256_set1_epi8('%');
+    const __m256i plus32 = _mm256_set1_epi8('+');
+    while (end - p >= 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i found = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, percent32),
+                                              _mm256_cmpeq_epi8(chunk, plus32));
+        if (const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(found))) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i percent = _mm_set1_epi8('%');
+    const __m128i plus = _mm_set1_epi8('+');
+    while (end - p >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i found =
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, percent), _mm_cmpeq_epi8(chunk, plus));
+        if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(found))) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+#endif
+    while (p != end && *p != '%' && *p != '+') {
+        ++p;
+    }
+    return p;
+}
+
+}  // namespace
+
+char* UrlDecodeTo(std::string_view str, char* out) {
+    const char* in = str.data();
+    const char* const end = in + str.size();
+    while (in != end) {
+        if (*in == '%') {
+            if (end - in < 3) {
+                ThrowIncompleteEscape();
+            }
+            *out++ = DecodeEscape(in[1], in[2]);
+            in += 3;
+        } else if (*in == '+') {
+            *out++ = ' ';
+            ++in;
+        } else {
+            // Участок без '%' и '+' копируется целиком
+            const char* special = FindSpecial(in + 1, end);
+            const size_t plain_size = static_cast<size_t>(special - in);
+            if (out != in) {
+                std::memmove(out, in, plain_size);
+            }
+            out += plain_size;
+            in = special;
+        }
+    }
+    return out;
+}
+
+bool HasUrlEscapes(std::string_view str) noexcept {
+    const char* end = str.data() + str.size();
+    return FindSpecial(str.data(), end) != end;
+}
+
+std::string UrlDecode(std::string_view str) {
+    std::string result(str.size(), '\0');
+    result.resize(static_cast<size_t>(UrlDecodeTo(str, result.data()) - result.data()));
+    return result;
+}
+
+void UrlDecodeInPlace(std::string& str) {
+    str.resize(static_cast<size_t>(UrlDecodeTo(str, str.data()) - str.data()));
+}
+
+void UrlDecoder::Decode(std::string_view chunk, std::string& out) {
+    if (pending_size_ != 0) {
+        // Дополняем %-последовательность, начатую в предыдущей части
+        while (pending_size_ < 3 && !chunk.empty()) {
+            pending_[pending_size_++] = chunk.front();
+            chunk.remove_prefix(1);
+        }
+        if (pending_size_ < 3) {
+            return;
+        }
+        out += DecodeEscape(pending_[1], pending_[2]);
+        pending_size_ = 0;
+    }
+
+    // '%' среди двух последних символов начинает последовательность, которая
+    // продолжится в следующей части (шестнадцатеричные цифры не бывают символом '%')
+    size_t tail = 0;
+    if (!chunk.empty() && chunk.back() == '%') {
+        tail = 1;
+    } else if (chunk.size() >= 2 && chunk[chunk.size() - 2] == '%') {
+        tail = 2;
+    }
+    const std::string_view complete = chunk.substr(0, chunk.size() - tail);
+
+    const size_t old_size = out.size();
+    out.resize(old_size + complete.size());
+    char* const out_end = UrlDecodeTo(complete, out.data() + old_size);
+    out.resize(static_cast<size_t>(out_end - out.data()));
+
+    std::memcpy(pending_, chunk.data() + complete.size(), tail);
+    pending_size_ = tail;
+}
+
+void UrlDecoder::Finish() {
+    if (pending_size_ != 0) {
+        pending_size_ = 0;
+        ThrowIncompleteEscape();
+    }
+}
@@ -0,0 +1,184 @@
+#define BOOST_TEST_MODULE access log tests
+#include <boost/test/unit_test.hpp>
+
+#include <boost/asio/ip/address.hpp>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/access_log.h"
+#include "../src/request_handler.h"
+
+using namespace std::literals;
+namespace http = boost::beast::http;
+
+namespace {
+
+std::vector<std::string> SplitLines(const std::string& text) {
+    std::vector<std::string> lines;
+    std::istringstream input{text};
+    for (std::string line; std::getline(input, line);) {
+        lines.push_back(std::move(line));
+    }
+    return lines;
+}
+
+// Поле data строки журнала
+std::string GetData(const std::string& line) {
+    static const std::regex LINE{R"(\{"timestamp":"\d{4}-\d\d-\d\dT\d\d:\d\d:\d\d\.\d{6}",)"
+                                 R"("data":(.*),"message":"response sent"\})"};
+    std::smatch match;
+    BOOST_REQUIRE(std::regex_match(line, match, LINE));
+    return match[1];
+}
+
+std::string MakeRequestJson(const access_log::RequestInfo& info) {
+    std::string result;
+    access_log::AppendRequestJson(result, info);
+    return result;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(Json_strings_are_escaped) {
+    std::string out;
+    access_log::AppendJsonString(out, "plain /path?a=1"sv);
+    BOOST_TEST(out == R"("plain /path?a=1")"s);
+
+    out.clear();
+    access_log::AppendJsonString(out, "q\"b\\n\nr\rt\t\x01\x1f"sv);
+    BOOST_TEST(out == R"("q\"b\\n\nr\rt\t\u0001\u001f")"s);
+}
+
+BOOST_AUTO_TEST_CASE(Request_json_contains_all_fields) {
+    access_log::RequestInfo info{.ip = "10.0.0.1"sv,
+                                 .method = "GET"sv,
+                                 .uri = "/api/v1/maps"sv,
+                                 .status = 200,
+                                 .response_time = std::chrono::milliseconds{15},
+                                 .content_type = "application/json"sv};
+    BOOST_TEST(MakeRequestJson(info)
+               == R"({"ip":"10.0.0.1","method":"GET","URI":"/api/v1/maps","code":200,)"
+                  R"("response_time":15,"content_type":"application/json"})"s);
+
+    info.content_type = {};
+    BOOST_TEST(MakeRequestJson(info).ends_with(R"("content_type":null})"sv));
+}
+
+BOOST_AUTO_TEST_CASE(Inline_string_keeps_short_and_long_text) {
+    using Text = access_log::InlineString<8>;
+    BOOST_TEST(Text{}.GetText().empty());
+    BOOST_TEST(Text{"12345678"sv}.GetText() == "12345678"sv);
+    const std::string long_text(100, 'x');
+    Text text{long_text};
+    BOOST_TEST(text.GetText() == long_text);
+    // Копия длинной строки не ссылается на память исходной
+    const Text copy = text;
+    text = Text{"short"sv};
+    BOOST_TEST(copy.GetText() == long_text);
+    BOOST_TEST(text.GetText() == "short"sv);
+}
+
+BOOST_AUTO_TEST_CASE(Ip_addresses_are_formatted_like_to_string) {
+    for (const auto& text : {"192.168.1.10"s, "0.0.0.0"s, "255.255.255.255"s, "::"s, "::1"s,
+                             "2001:db8::ff00:42:8329"s, "::ffff:10.1.2.3"s,
+                             "ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff"s}) {
+        const auto address = boost::asio::ip::make_address(text);
+        access_log::IpText buffer;
+        BOOST_TEST(access_log::FormatIp(address, buffer) == address.to_string());
+    }
+
+    auto v6 = boost::asio::ip::make_address_v6("2001:db8::1");
+    v6.scope_id(7);
+    access_log::IpText buffer;
+    BOOST_TEST(access_log::FormatIp(v6, buffer) == "2001:db8::1%7"sv);
+}
+
+BOOST_AUTO_TEST_CASE(Records_are_written_after_flush) {
+    std::ostringstream output;
+    access_log::AccessLog log{output};
+    log.Log({.ip = "10.0.0.1"sv, .method = "GET"sv, .uri = "/a"sv, .status = 404,
+             .content_type = {}});
+    // Запись длиннее RequestJson хранится в динамической памяти и выводится целиком
+    const std::string long_uri = "/"s + std::string(1000, 'u');
+    log.Log({.ip = "10.0.0.2"sv, .method = "POST"sv, .uri = long_uri, .status = 200,
+             .content_type = "text/plain"sv});
+    log.Flush();
+
+    const auto lines = SplitLines(output.str());
+    BOOST_REQUIRE(lines.size() == 2u);
+    BOOST_TEST(GetData(lines[0])
+               == R"({"ip":"10.0.0.1","method":"GET","URI":"/a","code":404,)"
+                  R"("response_time":0,"content_type":null})"s);
+    BOOST_TEST(GetData(lines[1])
+               == R"({"ip":"10.0.0.2","method":"POST","URI":")"s + long_uri
+                      + R"(","code":200,"response_time":0,"content_type":"text/plain"})"s);
+}
+
+BOOST_AUTO_TEST_CASE(Records_beyond_queue_capacity_are_not_lost) {
+    constexpr int THREAD_COUNT = 4;
+    constexpr int RECORDS_PER_THREAD = access_log::AccessLog::QUEUE_CAPACITY / 2;
+    std::ostringstream output;
+    {
+        access_log::AccessLog log{output};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREAD_COUNT; ++t) {
+            threads.emplace_back([&log, t] {
+                const std::string ip = "10.0.0."s + std::to_string(t);
+                for (int i = 0; i < RECORDS_PER_THREAD; ++i) {
+                    const std::string uri = "/"s + std::to_string(i);
+                    log.Log({.ip = ip, .method = "GET"sv, .uri = uri, .status = 200,
+                             .content_type = {}});
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    const auto lines = SplitLines(output.str());
+    BOOST_REQUIRE(lines.size() == size_t{THREAD_COUNT * RECORDS_PER_THREAD});
+    std::set<std::string> unique;
+    for (const auto& line : lines) {
+        unique.insert(GetData(line));
+    }
+    BOOST_TEST(unique.size() == lines.size());
+}
+
+BOOST_AUTO_TEST_CASE(Logging_handler_logs_client_request_and_response) {
+    using StringRequest = http::request<http::string_body>;
+    using StringResponse = http::response<http::string_body>;
+
+    // Обработчик отвечает после того, как запрос перемещён в него
+    const auto handler = [](StringRequest&& req, auto&& send) {
+        StringResponse response{http::status::not_found, req.version()};
+        response.set(http::field::content_type, "text/html");
+        req = {};
+        send(std::move(response));
+    };
+
+    std::ostringstream output;
+    access_log::AccessLog log{output};
+    http_handler::LoggingRequestHandler logging_handler{handler, log};
+    const std::string long_target = "/static/"s + std::string(300, 'p') + "?q=1"s;
+    for (const auto& target : {"/index.html"s, long_target}) {
+        bool sent = false;
+        logging_handler(boost::asio::ip::make_address("::1"),
+                        StringRequest{http::verb::head, target, 11}, [&sent](auto&& response) {
+                            sent = response.result() == http::status::not_found;
+                        });
+        BOOST_TEST(sent);
+    }
+    log.Flush();
+
+    const auto lines = SplitLines(output.str());
+    BOOST_REQUIRE(lines.size() == 2u);
+    BOOST_TEST(GetData(lines[0])
+               == R"({"ip":"::1","method":"HEAD","URI":"/index.html","code":404,)"
+                  R"("response_time":0,"content_type":"text/html"})"s);
+    BOOST_TEST(GetData(lines[1]).find(R"("URI":")"s + long_target + "\""s) != std::string::npos);
+}
@@ -0,0 +1,107 @@
+#define BOOST_TEST_MODULE mime types tests
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include "../src/mime_types.h"
+
+using namespace std::literals;
+using http_handler::DEFAULT_CONTENT_TYPE;
+using http_handler::GetContentType;
+
+namespace {
+
+// Эталонный поиск: перебор всех расширений таблицы
+std::string_view FindContentTypeLinear(std::string_view extension) {
+    if (extension.starts_with('.')) {
+        extension.remove_prefix(1);
+    }
+    for (const auto& mime_type : http_handler::mime_detail::MIME_TYPES) {
+        if (http_handler::mime_detail::EqualsIgnoreCase(extension, mime_type.extension)) {
+            return mime_type.content_type;
+        }
+    }
+    return DEFAULT_CONTENT_TYPE;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(Extensions_of_static_files) {
+    // Все расширения файлов из каталогов static в заданиях
+    BOOST_TEST(GetContentType(".html"sv) == "text/html"sv);
+    BOOST_TEST(GetContentType(".js"sv) == "text/javascript"sv);
+    BOOST_TEST(GetContentType(".png"sv) == "image/png"sv);
+    BOOST_TEST(GetContentType(".svg"sv) == "image/svg+xml"sv);
+    BOOST_TEST(GetContentType(".ico"sv) == "image/vnd.microsoft.icon"sv);
+    BOOST_TEST(GetContentType(".webmanifest"sv) == "application/manifest+json"sv);
+    BOOST_TEST(GetContentType(".fbx"sv) == DEFAULT_CONTENT_TYPE);
+    BOOST_TEST(GetContentType(".obj"sv) == "model/obj"sv);
+}
+
+BOOST_AUTO_TEST_CASE(Every_extension_in_every_letter_case) {
+    for (const auto& mime_type : http_handler::mime_detail::MIME_TYPES) {
+        const std::string_view extension = mime_type.extension;
+        // Перебираются все сочетания строчных и заглавных букв
+        for (unsigned mask = 0; mask < (1u << extension.size()); ++mask) {
+            std::string variant{extension};
+            for (size_t i = 0; i < variant.size(); ++i) {
+                if (mask & (1u << i) && variant[i] >= 'a' && variant[i] <= 'z') {
+                    variant[i] = static_cast<char>(variant[i] - 'a' + 'A');
+                }
+            }
+            BOOST_TEST(GetContentType(variant) == mime_type.content_type);
+            BOOST_TEST(GetContentType("."s + variant) == mime_type.content_type);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Near_misses_are_unknown) {
+    BOOST_TEST(GetContentType(""sv) == DEFAULT_CONTENT_TYPE);
+    BOOST_TEST(GetContentType("."sv) == DEFAULT_CONTENT_TYPE);
+    BOOST_TEST(GetContentType("..html"sv) == DEFAULT_CONTENT_TYPE);
+    BOOST_TEST(GetContentType("html."sv) == DEFAULT_CONTENT_TYPE);
+    BOOST_TEST(GetContentType("webmanifests"sv) == DEFAULT_CONTENT_TYPE);
+    for (const auto& mime_type : http_handler::mime_detail::MIME_TYPES) {
+        const std::string extension{mime_type.extension};
+        BOOST_TEST(GetContentType(extension + "x"s) == FindContentTypeLinear(extension + "x"s));
+        BOOST_TEST(GetContentType(extension.substr(1)) == FindContentTypeLinear(extension.substr(1)));
+        // Символы, отличающиеся от букв только битом 0x20, не должны совпадать с буквами
+        std::string shifted = extension;
+        shifted.back() = static_cast<char>(shifted.back() ^ 0x20);
+        if (shifted.back() < 'A' || shifted.back() > 'Z') {
+            BOOST_TEST(GetContentType(shifted) == DEFAULT_CONTENT_TYPE);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(All_short_strings_match_linear_search) {
+    const auto alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789.@[`{_-~"sv;
+    std::string str;
+    size_t mismatches = 0;
+    for (size_t size = 1; size <= 3; ++size) {
+        str.assign(size, ' ');
+        // Перебор всех строк длины size над алфавитом
+        std::vector<size_t> digits(size, 0);
+        while (true) {
+            for (size_t i = 0; i < size; ++i) {
+                str[i] = alphabet[digits[i]];
+            }
+            mismatches += GetContentType(str) != FindContentTypeLinear(str);
+            size_t i = 0;
+            while (i < size && ++digits[i] == alphabet.size()) {
+                digits[i++] = 0;
+            }
+            if (i == size) {
+                break;
+            }
+        }
+    }
+    BOOST_TEST(mismatches == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(Lookup_works_at_compile_time) {
+    static_assert(GetContentType(".HTML"sv) == "text/html"sv);
+    static_assert(GetContentType("JpEg"sv) == "image/jpeg"sv);
+    static_assert(GetContentType("exe"sv) == DEFAULT_CONTENT_TYPE);
+}
@@ -0,0 +1,121 @@
+#define BOOST_TEST_MODULE perfect hash index tests
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../src/model.h"
+#include "../src/perfect_hash_index.h"
+
+using namespace std::literals;
+using util::PerfectHashIndex;
+
+namespace {
+
+std::vector<uint64_t> MakeHashes(size_t count, uint64_t seed) {
+    std::mt19937_64 random{seed};
+    std::unordered_set<uint64_t> unique;
+    std::vector<uint64_t> hashes;
+    while (hashes.size() < count) {
+        const uint64_t hash = random();
+        if (unique.insert(hash).second) {
+            hashes.push_back(hash);
+        }
+    }
+    return hashes;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(Unbuilt_index_finds_nothing) {
+    PerfectHashIndex index;
+    BOOST_TEST(!index.IsBuilt());
+    BOOST_TEST(index.Find(0) == PerfectHashIndex::NOT_FOUND);
+    BOOST_TEST(index.Find(0x123456789abcdef0) == PerfectHashIndex::NOT_FOUND);
+}
+
+BOOST_AUTO_TEST_CASE(Empty_input_is_rejected) {
+    PerfectHashIndex index;
+    BOOST_TEST(!index.Build({}));
+    BOOST_TEST(!index.IsBuilt());
+    BOOST_TEST(index.Find(42) == PerfectHashIndex::NOT_FOUND);
+}
+
+BOOST_AUTO_TEST_CASE(Duplicate_hashes_are_rejected) {
+    PerfectHashIndex index;
+    const std::vector<uint64_t> hashes{1, 2, 3};
+    BOOST_REQUIRE(index.Build(hashes));
+
+    // Неудачная сборка оставляет таблицу пустой
+    const std::vector<uint64_t> duplicates{1, 2, 3, 2};
+    BOOST_TEST(!index.Build(duplicates));
+    BOOST_TEST(!index.IsBuilt());
+    BOOST_TEST(index.Find(1) == PerfectHashIndex::NOT_FOUND);
+}
+
+BOOST_AUTO_TEST_CASE(Every_key_is_found_for_1_to_N_keys) {
+    for (size_t count = 1; count <= 300; ++count) {
+        const auto hashes = MakeHashes(count, count);
+        PerfectHashIndex index;
+        BOOST_REQUIRE(index.Build(hashes));
+        size_t mismatches = 0;
+        for (size_t i = 0; i < count; ++i) {
+            mismatches += index.Find(hashes[i]) != i;
+        }
+        BOOST_TEST(mismatches == 0u, "with " << count << " keys");
+    }
+
+    const auto hashes = MakeHashes(100'000, 0);
+    PerfectHashIndex index;
+    BOOST_REQUIRE(index.Build(hashes));
+    size_t mismatches = 0;
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        mismatches += index.Find(hashes[i]) != i;
+    }
+    BOOST_TEST(mismatches == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(Absent_hashes_give_some_key_or_NOT_FOUND) {
+    const auto hashes = MakeHashes(1000, 1);
+    const std::unordered_set<uint64_t> present(hashes.begin(), hashes.end());
+    PerfectHashIndex index;
+    BOOST_REQUIRE(index.Build(hashes));
+
+    // Номер для отсутствующего хеша не должен выходить за пределы набора,
+    // поэтому вызывающий код может безопасно сравнить ключ
+    size_t out_of_range = 0;
+    for (const uint64_t hash : MakeHashes(10'000, 2)) {
+        if (!present.contains(hash)) {
+            const size_t key = index.Find(hash);
+            out_of_range += key != PerfectHashIndex::NOT_FOUND && key >= hashes.size();
+        }
+    }
+    BOOST_TEST(out_of_range == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(FindMap_falls_back_to_hash_map_after_AddMap) {
+    model::Game game;
+    game.AddMap(model::Map{model::Map::Id{"map1"s}, "Map 1"s});
+    game.AddMap(model::Map{model::Map::Id{"town"s}, "Town"s});
+
+    // Пока таблица не построена, карты ищутся через хеш-таблицу
+    BOOST_REQUIRE(game.FindMap(model::Map::Id{"town"s}));
+    BOOST_TEST(game.FindMap(model::Map::Id{"town"s})->GetName() == "Town"s);
+
+    game.BuildMapIndex();
+    BOOST_TEST(game.FindMap(model::Map::Id{"map1"s})->GetName() == "Map 1"s);
+    BOOST_TEST(game.FindMap(model::Map::Id{"map2"s}) == nullptr);
+
+    // Добавление карты сбрасывает таблицу, но все карты по-прежнему находятся
+    game.AddMap(model::Map{model::Map::Id{"map2"s}, "Map 2"s});
+    BOOST_REQUIRE(game.FindMap(model::Map::Id{"map2"s}));
+    BOOST_TEST(game.FindMap(model::Map::Id{"map2"s})->GetName() == "Map 2"s);
+    BOOST_TEST(game.FindMap(model::Map::Id{"map1"s})->GetName() == "Map 1"s);
+    BOOST_TEST(game.FindMap(model::Map::Id{"unknown"s}) == nullptr);
+
+    game.BuildMapIndex();
+    BOOST_TEST(game.FindMap(model::Map::Id{"map2"s})->GetName() == "Map 2"s);
+    BOOST_TEST(game.FindMap(model::Map::Id{"unknown"s}) == nullptr);
+}
@@ -0,0 +1,111 @@
+#define BOOST_TEST_MODULE request target tests
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/request_target.h"
+
+using namespace std::literals;
+using http_handler::EncodedPart;
+using http_handler::RequestTarget;
+
+namespace {
+
+std::vector<std::string> GetSegments(const RequestTarget& target) {
+    std::vector<std::string> segments;
+    for (const EncodedPart segment : target.GetSegments()) {
+        segments.push_back(segment.Decode());
+    }
+    return segments;
+}
+
+// Декодированные параметры запроса в виде "имя=значение"
+std::vector<std::string> GetParams(const RequestTarget& target) {
+    std::vector<std::string> params;
+    for (const auto& param : target.GetQueryParams()) {
+        params.push_back(param.name.Decode() + "="s + param.value.Decode());
+    }
+    return params;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(Fragment_is_stripped) {
+    const RequestTarget target{"/index.html?lang=ru#section?x=1"sv};
+    BOOST_TEST(target.GetPath().GetRaw() == "/index.html"sv);
+    BOOST_TEST(target.GetQuery() == "lang=ru"sv);
+
+    const RequestTarget without_query{"/maps#top"sv};
+    BOOST_TEST(without_query.GetPath().GetRaw() == "/maps"sv);
+    BOOST_TEST(without_query.GetQuery().empty());
+}
+
+BOOST_AUTO_TEST_CASE(Path_is_split_into_segments) {
+    BOOST_TEST(GetSegments(RequestTarget{"/api/v1/maps"sv})
+               == (std::vector{"api"s, "v1"s, "maps"s}), boost::test_tools::per_element());
+    // Завершающий '/' даёт пустой последний сегмент
+    BOOST_TEST(GetSegments(RequestTarget{"/maps/"sv}) == (std::vector{"maps"s, ""s}),
+               boost::test_tools::per_element());
+    BOOST_TEST(GetSegments(RequestTarget{"/"sv}).empty());
+    BOOST_TEST(GetSegments(RequestTarget{"/maps/map%201"sv}) == (std::vector{"maps"s, "map 1"s}),
+               boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(Empty_query_params_are_skipped) {
+    BOOST_TEST(GetParams(RequestTarget{"/?a=1&&b=2&"sv}) == (std::vector{"a=1"s, "b=2"s}),
+               boost::test_tools::per_element());
+    BOOST_TEST(GetParams(RequestTarget{"/?&&"sv}).empty());
+    BOOST_TEST(GetParams(RequestTarget{"/?"sv}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(Params_without_value_have_empty_value) {
+    const RequestTarget target{"/?debug&c=&name=a+b"sv};
+    BOOST_TEST(GetParams(target) == (std::vector{"debug="s, "c="s, "name=a b"s}),
+               boost::test_tools::per_element());
+    const auto debug = target.FindQueryParam("debug"sv);
+    BOOST_REQUIRE(debug.has_value());
+    BOOST_TEST(debug->IsEmpty());
+    BOOST_TEST(!target.FindQueryParam("missing"sv).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(Encoded_names_are_compared_after_decoding) {
+    const RequestTarget target{"/?first%20name=Ivan&last+name=Petrov"sv};
+    BOOST_TEST(target.FindQueryParam("first name"sv)->GetRaw() == "Ivan"sv);
+    BOOST_TEST(target.FindQueryParam("last name"sv)->GetRaw() == "Petrov"sv);
+    BOOST_TEST(!target.FindQueryParam("first%20name"sv).has_value());
+
+    // Закодированное имя длиннее буфера на стеке декодируется в динамическую память
+    const std::string long_name(300, 'n');
+    std::string encoded_name;
+    for (size_t i = 0; i < long_name.size(); ++i) {
+        encoded_name += "%6E"sv;
+    }
+    BOOST_REQUIRE(encoded_name.size() > 256u);
+    const std::string raw = "/?"s + encoded_name + "=value"s;
+    const RequestTarget long_target{raw};
+    const auto value = long_target.FindQueryParam(long_name);
+    BOOST_REQUIRE(value.has_value());
+    BOOST_TEST(value->GetRaw() == "value"sv);
+    BOOST_TEST(!long_target.FindQueryParam(long_name.substr(1)).has_value());
+
+    const EncodedPart long_part{encoded_name};
+    BOOST_TEST(long_part.Equals(long_name));
+    BOOST_TEST(!long_part.Equals(long_name + "n"s));
+}
+
+BOOST_AUTO_TEST_CASE(Invalid_escapes_throw_invalid_argument) {
+    const RequestTarget target{"/maps/%zz?name%4=1"sv};
+    const auto segments = target.GetSegments();
+    auto it = segments.begin();
+    ++it;
+    BOOST_CHECK_THROW((*it).Decode(), std::invalid_argument);
+    std::string buffer;
+    BOOST_CHECK_THROW((*it).Decode(buffer), std::invalid_argument);
+    BOOST_CHECK_THROW(target.FindQueryParam("name"sv), std::invalid_argument);
+    BOOST_CHECK_THROW(EncodedPart{"%4"sv}.Equals("x"sv), std::invalid_argument);
+
+    // Без '%' и '+' части не декодируются и не проверяются
+    BOOST_TEST(EncodedPart{"plain"sv}.Decode(buffer) == "plain"sv);
+}
@@ -0,0 +1,211 @@
+#define BOOST_TEST_MODULE static file index tests
+#include <boost/test/unit_test.hpp>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "../src/static_file_index.h"
+#include "../src/urldecode.h"
+
+using namespace std::literals;
+namespace fs = std::filesystem;
+using http_handler::StaticFileIndex;
+
+namespace {
+
+void WriteFile(const fs::path& path, std::string_view content = "content"sv) {
+    fs::create_directories(path.parent_path());
+    std::ofstream{path} << content;
+}
+
+// Ждёт, пока фоновый поток перестроит индекс так, чтобы выполнилось условие
+template <typename Predicate>
+bool WaitFor(const Predicate& predicate) {
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(10ms);
+    }
+    return true;
+}
+
+/*
+ * Временный каталог вида
+ *   secret.txt
+ *   root/index.html
+ *   root/js/index.html
+ *   root/js/game.js
+ *   root/file with spaces.html
+ * Файл secret.txt лежит вне каталога статических файлов root
+ */
+struct StaticFilesFixture {
+    StaticFilesFixture() {
+        static int counter = 0;
+        directory = fs::temp_directory_path()
+                  / ("static_file_index_tests_"s + std::to_string(::getpid()) + "_"s
+                     + std::to_string(counter++));
+        fs::remove_all(directory);
+        root = directory / "root";
+        WriteFile(directory / "secret.txt", "secret"sv);
+        WriteFile(root / "index.html");
+        WriteFile(root / "js" / "index.html");
+        WriteFile(root / "js" / "game.js");
+        WriteFile(root / "file with spaces.html");
+    }
+
+    ~StaticFilesFixture() {
+        fs::remove_all(directory);
+    }
+
+    fs::path directory;
+    fs::path root;
+};
+
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(Static_file_index_tests, StaticFilesFixture)
+
+BOOST_AUTO_TEST_CASE(Files_and_directory_indexes_are_found) {
+    const StaticFileIndex index{root, StaticFileIndex::Watch::DISABLED};
+    // Три файла и index.html каталогов "" и "js/"
+    BOOST_TEST(index.GetFileCount() == 6u);
+
+    const auto game = index.Find("js/game.js"sv);
+    BOOST_REQUIRE(game);
+    BOOST_TEST(game->path == fs::canonical(root / "js" / "game.js"));
+    BOOST_TEST(game->size == "content"sv.size());
+    BOOST_TEST(game->content_type == "text/javascript"sv);
+    BOOST_TEST(index.Find("file with spaces.html"sv));
+
+    BOOST_REQUIRE(index.Find(""sv));
+    BOOST_TEST(index.Find(""sv)->path == fs::canonical(root / "index.html"));
+    BOOST_REQUIRE(index.Find("js/"sv));
+    BOOST_TEST(index.Find("js/"sv)->path == fs::canonical(root / "js" / "index.html"));
+    // Каталог без завершающего '/' и несуществующие файлы не находятся
+    BOOST_TEST(!index.Find("js"sv));
+    BOOST_TEST(!index.Find("missing.html"sv));
+}
+
+BOOST_AUTO_TEST_CASE(Leading_slash_is_ignored) {
+    const StaticFileIndex index{root, StaticFileIndex::Watch::DISABLED};
+    for (const auto path : {"index.html"sv, "js/game.js"sv, "js/"sv, ""sv}) {
+        const auto without_slash = index.Find(path);
+        BOOST_REQUIRE(without_slash);
+        BOOST_TEST(index.Find("/"s + std::string{path}) == without_slash);
+    }
+    // Убирается только один '/'
+    BOOST_TEST(!index.Find("//index.html"sv));
+}
+
+BOOST_AUTO_TEST_CASE(Paths_outside_root_are_not_found) {
+    const StaticFileIndex index{root, StaticFileIndex::Watch::DISABLED};
+    for (const auto path : {"../secret.txt"sv, "/../secret.txt"sv, "js/../../secret.txt"sv,
+                            "./../secret.txt"sv, "js/../index.html"sv, "./index.html"sv,
+                            "/etc/passwd"sv, "//etc/passwd"sv, "..\\secret.txt"sv}) {
+        BOOST_TEST(!index.Find(path), path);
+    }
+    // Закодированные пути ищутся после декодирования и тоже не выходят за пределы root
+    for (const auto encoded : {"/%2e%2e/secret.txt"sv, "/%2E%2E%2Fsecret.txt"sv,
+                               "/js/%2e%2e/%2e%2e/secret.txt"sv, "/..%2fsecret.txt"sv}) {
+        BOOST_TEST(!index.Find(encoded), encoded);
+        BOOST_TEST(!index.Find(UrlDecode(encoded)), encoded);
+    }
+    BOOST_TEST(index.Find(UrlDecode("/file%20with%20spaces.html"sv)));
+}
+
+BOOST_AUTO_TEST_CASE(Symlinks_are_skipped) {
+    fs::create_symlink(directory / "secret.txt", root / "secret.txt");
+    fs::create_symlink(root / "js" / "game.js", root / "game.js");
+    fs::create_directory_symlink(directory, root / "parent");
+    fs::create_directory_symlink(root / "js", root / "scripts");
+
+    const StaticFileIndex index{root, StaticFileIndex::Watch::DISABLED};
+    BOOST_TEST(index.GetFileCount() == 6u);
+    for (const auto path : {"secret.txt"sv, "game.js"sv, "parent/secret.txt"sv,
+                            "parent/root/index.html"sv, "scripts/game.js"sv, "scripts/"sv}) {
+        BOOST_TEST(!index.Find(path), path);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Rebuild_picks_up_changes) {
+    StaticFileIndex index{root, StaticFileIndex::Watch::DISABLED};
+    WriteFile(root / "new.css");
+    fs::remove(root / "js" / "game.js");
+    BOOST_TEST(!index.Find("new.css"sv));
+    BOOST_TEST(index.Find("js/game.js"sv));
+
+    index.Rebuild();
+    BOOST_TEST(index.Find("new.css"sv));
+    BOOST_TEST(!index.Find("js/game.js"sv));
+}
+
+BOOST_AUTO_TEST_CASE(Found_entries_outlive_the_index_they_were_found_in) {
+    StaticFileIndex index{root, StaticFileIndex::Watch::DISABLED};
+    const auto game = index.Find("js/game.js"sv);
+    BOOST_REQUIRE(game);
+    fs::remove(root / "js" / "game.js");
+    index.Rebuild();
+    BOOST_TEST(!index.Find("js/game.js"sv));
+    BOOST_TEST(game->path == fs::canonical(root / "js") / "game.js");
+}
+
+BOOST_AUTO_TEST_CASE(Watcher_refreshes_index_after_create_delete_and_rename) {
+    const StaticFileIndex index{root, StaticFileIndex::Watch::ENABLED};
+
+    WriteFile(root / "created.html");
+    BOOST_TEST(WaitFor([&] {
+        return index.Find("created.html"sv) != nullptr;
+    }));
+
+    // Файлы нового каталога индексируются вместе с ним
+    WriteFile(root / "assets" / "images" / "logo.png");
+    BOOST_TEST(WaitFor([&] {
+        return index.Find("assets/images/logo.png"sv) != nullptr;
+    }));
+    BOOST_TEST(index.Find("assets/images/logo.png"sv)->content_type == "image/png"sv);
+    // За новым каталогом тоже ведётся наблюдение
+    WriteFile(root / "assets" / "images" / "index.html");
+    BOOST_TEST(WaitFor([&] {
+        return index.Find("/assets/images/"sv) != nullptr;
+    }));
+
+    fs::remove(root / "created.html");
+    BOOST_TEST(WaitFor([&] {
+        return index.Find("created.html"sv) == nullptr;
+    }));
+
+    fs::rename(root / "js" / "game.js", root / "js" / "renamed.js");
+    BOOST_TEST(WaitFor([&] {
+        return index.Find("js/game.js"sv) == nullptr && index.Find("js/renamed.js"sv) != nullptr;
+    }));
+
+    fs::rename(root / "js", root / "scripts");
+    BOOST_TEST(WaitFor([&] {
+        return index.Find("js/renamed.js"sv) == nullptr
+            && index.Find("scripts/renamed.js"sv) != nullptr && index.Find("scripts/"sv) != nullptr;
+    }));
+
+    // Файл, перемещённый в root извне, тоже появляется в индексе
+    WriteFile(directory / "outside.txt");
+    fs::rename(directory / "outside.txt", root / "moved_in.txt");
+    BOOST_TEST(WaitFor([&] {
+        return index.Find("moved_in.txt"sv) != nullptr;
+    }));
+}
+
+BOOST_AUTO_TEST_CASE(Root_must_be_a_directory) {
+    BOOST_CHECK_THROW(StaticFileIndex(root / "index.html", StaticFileIndex::Watch::DISABLED),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(StaticFileIndex(directory / "missing", StaticFileIndex::Watch::DISABLED),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../my_logger.h"
+
+/*
+ * Измеряет задержку вызова LOG на вызывающем потоке в наносекундах
+ * для 1 и 4 потоков, каждый из которых делает 1000000 вызовов.
+ * Для сравнения измеряется синхронный журнал, который форматирует запись
+ * на вызывающем потоке и пишет её в файл под мьютексом.
+ * В конце выводится размер текстовых и двоичных файлов журнала на одну запись.
+ * Файлы журнала пишутся во временный каталог.
+ */
+
+namespace {
+
+constexpr int CALL_COUNT = 1'000'000;
+
+// Синхронный журнал: std::put_time и вывод в std::ofstream под мьютексом
+class SyncLogger {
+public:
+    explicit SyncLogger(const std::filesystem::path& path)
+        : file_(path) {
+    }
+
+    template <class... Ts>
+    void Log(const Ts&... args) {
+        std::lock_guard lock{mutex_};
+        const auto t_c = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        file_ << std::put_time(std::localtime(&t_c), "%F %T") << ": "sv;
+        ((file_ << args), ...);
+        file_ << '\n';
+    }
+
+private:
+    std::mutex mutex_;
+    std::ofstream file_;
+};
+
+template <typename Log>
+double MeasureNsPerCall(int thread_count, Log&& log) {
+    std::vector<double> results(thread_count);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&log, &result = results[t], t] {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < CALL_COUNT; ++i) {
+                log(t, i);
+            }
+            result = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now()
+                                                              - start)
+                         .count()
+                   / CALL_COUNT;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double sum = 0;
+    for (const double result : results) {
+        sum += result;
+    }
+    return sum / thread_count;
+}
+
+}  // namespace
+
+int main() {
+    const auto directory = std::filesystem::temp_directory_path() / "log_benchmark";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    for (const auto* subdirectory : {"text", "binary", "drop"}) {
+        std::filesystem::create_directories(directory / subdirectory);
+    }
+
+    auto& logger = Logger::GetInstance();
+
+    for (const int thread_count : {1, 4}) {
+        SyncLogger sync_logger{directory / "sync.log"};
+        const double sync_ns = MeasureNsPerCall(thread_count, [&](int t, int i) {
+            sync_logger.Log("Thread "sv, t, " attempt "sv, i, ". "sv, "I Love it"sv);
+        });
+
+        logger.SetLogDirectory(directory / "text");
+        logger.SetOverflowPolicy(OverflowPolicy::BLOCK);
+        const double block_ns = MeasureNsPerCall(thread_count, [](int t, int i) {
+            LOG("Thread "sv, t, " attempt "sv, i, ". "sv, "I Love it"sv);
+        });
+        logger.Flush();
+
+        logger.SetLogDirectory(directory / "binary");
+        logger.SetMode(LogMode::BINARY);
+        const double binary_ns = MeasureNsPerCall(thread_count, [](int t, int i) {
+            LOG(LOG_LITERAL("Thread "), t, LOG_LITERAL(" attempt "), i, LOG_LITERAL(". "),
+                LOG_LITERAL("I Love it"));
+        });
+        logger.Flush();
+        logger.SetMode(LogMode::TEXT);
+
+        logger.SetLogDirectory(directory / "drop");
+        logger.SetOverflowPolicy(OverflowPolicy::DROP);
+        const uint64_t dropped_before = logger.GetDroppedCount();
+        const double drop_ns = MeasureNsPerCall(thread_count, [](int t, int i) {
+            LOG("Thread "sv, t, " attempt "sv, i, ". "sv, "I Love it"sv);
+        });
+        logger.Flush();
+
+        std::cout << thread_count << " thread(s): sync "sv << sync_ns << " ns, async/block "sv
+                  << block_ns << " ns, async/binary "sv << binary_ns << " ns, async/drop "sv
+                  << drop_ns << " ns per LOG ("sv
+                  << logger.GetDroppedCount() - dropped_before << " dropped)"sv << std::endl;
+    }
+
+    // В режиме BLOCK в текстовый и двоичный журналы попадают все 5 * CALL_COUNT записей
+    const auto get_size = [](const std::filesystem::path& path) {
+        uintmax_t size = 0;
+        for (const auto& entry : std::filesystem::directory_iterator{path}) {
+            size += entry.file_size();
+        }
+        return static_cast<double>(size) / (5 * CALL_COUNT);
+    };
+    std::cout << "bytes per record: text "sv << get_size(directory / "text") << ", binary "sv
+              << get_size(directory / "binary") << std::endl;
+
+    std::filesystem::remove_all(directory);
+}
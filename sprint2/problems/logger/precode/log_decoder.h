@@ -0,0 +1,124 @@
+#pragma once
+
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "log_format.h"
+
+namespace log_detail {
+
+/*
+ * Переводит двоичный журнал (LogMode::BINARY) в текстовый.
+ * Время выводится в местном часовом поясе, как в текстовом журнале.
+ */
+class BinaryLogDecoder {
+public:
+    explicit BinaryLogDecoder(std::ostream& output)
+        : output_{output} {
+    }
+
+    // Декодирует данные файла. Выбрасывает std::runtime_error, если файл повреждён
+    void Decode(std::string_view data) {
+        const size_t total = data.size();
+        try {
+            while (!data.empty()) {
+                if (data.starts_with(BINARY_MAGIC)) {
+                    data.remove_prefix(BINARY_MAGIC.size());
+                    dictionary_ = {};
+                    continue;
+                }
+                DecodeEntry(data);
+                if (text_.size() >= 64 * 1024) {
+                    Flush();
+                }
+            }
+        } catch (const std::runtime_error& e) {
+            Flush();
+            throw std::runtime_error(std::string(e.what()) + " at offset "
+                                     + std::to_string(total - data.size()));
+        }
+        Flush();
+    }
+
+private:
+    // Разбирает один элемент. data сдвигается только после успешного разбора
+    void DecodeEntry(std::string_view& data) {
+        std::string_view entry = data;
+        const auto kind = static_cast<EntryKind>(ReadValue<char>(entry));
+        switch (kind) {
+            case EntryKind::FORMAT: {
+                const auto id = ReadValue<uint32_t>(entry);
+                const auto count = ReadValue<uint32_t>(entry);
+                if (entry.size() < count) {
+                    throw std::runtime_error("Log record format is truncated");
+                }
+                std::vector<ArgType> format;
+                for (const char type : entry.substr(0, count)) {
+                    if (static_cast<uint8_t>(type) > static_cast<uint8_t>(ArgType::LITERAL)) {
+                        throw std::runtime_error("Unknown log argument type");
+                    }
+                    format.push_back(static_cast<ArgType>(type));
+                }
+                entry.remove_prefix(count);
+                Define(dictionary_.formats, id, std::move(format));
+                break;
+            }
+            case EntryKind::LITERAL: {
+                const auto id = ReadValue<uint32_t>(entry);
+                const auto size = ReadValue<uint32_t>(entry);
+                if (entry.size() < size) {
+                    throw std::runtime_error("Log string literal is truncated");
+                }
+                Define(dictionary_.literals, id, std::string{entry.substr(0, size)});
+                entry.remove_prefix(size);
+                break;
+            }
+            case EntryKind::RECORD: {
+                const auto size = ReadValue<uint32_t>(entry);
+                if (entry.size() < size) {
+                    throw std::runtime_error("Log record is truncated");
+                }
+                AppendRecordText(text_, timestamps_, dictionary_, entry.substr(0, size));
+                entry.remove_prefix(size);
+                break;
+            }
+            case EntryKind::DROPPED: {
+                const auto ticks = ReadValue<int64_t>(entry);
+                AppendDroppedText(text_, timestamps_, ticks, ReadValue<uint64_t>(entry));
+                break;
+            }
+            default:
+                throw std::runtime_error("Unknown binary log entry");
+        }
+        data = entry;
+    }
+
+    // Номера определений идут подряд, начиная с нуля, но в файл попадают по мере использования
+    template <typename T>
+    static void Define(std::vector<T>& definitions, uint32_t id, T value) {
+        // Номер из повреждённого файла мог бы заставить выделить гигабайты памяти
+        if (id >= MAX_DEFINITIONS) {
+            throw std::runtime_error("Log definition number is too large");
+        }
+        if (id >= definitions.size()) {
+            definitions.resize(id + 1);
+        }
+        definitions[id] = std::move(value);
+    }
+
+    void Flush() {
+        output_.write(text_.data(), static_cast<std::streamsize>(text_.size()));
+        text_.clear();
+    }
+
+    std::ostream& output_;
+    Dictionary dictionary_;
+    TimestampCache timestamps_;
+    std::string text_;
+};
+
+}  // namespace log_detail
@@ -0,0 +1,415 @@
+#pragma once
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+ * Формат записей журнала, общий для Logger и декодера двоичного журнала.
+ *
+ * Запись - время (int64, тики system_clock), номер формата (uint32) и значения аргументов.
+ * Формат - список типов аргументов вызова LOG. Он известен на этапе компиляции,
+ * регистрируется один раз для каждого набора типов, и в записи типы не повторяются.
+ * Значения хранятся без тегов в фиксированной ширине своего типа. Исключение -
+ * строки, которые хранятся как длина (uint32) и байты. Литералы, переданные
+ * через LOG_LITERAL, хранятся номером (uint32), а их текст регистрируется один раз.
+ *
+ * Двоичный файл журнала начинается с BINARY_MAGIC и состоит из элементов:
+ *   'F' номер (u32) | число типов (u32) | типы (u8)  - определение формата
+ *   'L' номер (u32) | длина (u32) | байты            - определение литерала
+ *   'R' длина (u32) | запись                         - запись журнала
+ *   'D' время (i64) | число (u64)                    - отброшенные записи
+ * Определения пишутся в файл перед первой записью, которая на них ссылается.
+ * При каждом открытии файла BINARY_MAGIC пишется снова, и номера после него
+ * определяются заново, поэтому в один файл могут дописывать разные запуски программы.
+ * Номера форматов и литералов меньше MAX_DEFINITIONS.
+ */
+
+namespace log_detail {
+
+using Clock = std::chrono::system_clock;
+
+// Тип аргумента в записи журнала
+enum class ArgType : uint8_t {
+    BOOL,
+    CHAR,
+    INT16,
+    INT32,
+    INT64,
+    UINT16,
+    UINT32,
+    UINT64,
+    FLOAT,
+    DOUBLE,
+    STRING,
+    LITERAL,
+};
+
+enum class EntryKind : char {
+    FORMAT = 'F',
+    LITERAL = 'L',
+    RECORD = 'R',
+    DROPPED = 'D',
+};
+
+inline constexpr std::string_view BINARY_MAGIC{"LOGBIN1\n", 8};
+
+// Ограничение числа форматов и литералов. Их количество определяется местами вызова LOG
+// в программе, а декодеру оно позволяет отвергать повреждённые номера
+inline constexpr uint32_t MAX_DEFINITIONS = 1 << 20;
+
+// Время и номер формата в начале записи
+inline constexpr size_t RECORD_HEADER_SIZE = sizeof(int64_t) + sizeof(uint32_t);
+
+template <typename T, typename... Types>
+constexpr bool IS_ONE_OF = (std::is_same_v<T, Types> || ...);
+
+/*
+ * Строка со статическим временем жизни, которая сохраняется в записи номером.
+ * Конструктор consteval, поэтому принимает только строковые литералы и массивы
+ * static constexpr char: их адрес и текст не меняются, пока работает программа.
+ * Обычно создаётся макросом LOG_LITERAL. Остальные строки, в том числе массивы char
+ * на стеке, сохраняются в записи по значению.
+ */
+class Literal {
+public:
+    template <size_t N>
+    consteval explicit Literal(const char (&text)[N])
+        : data_{text}
+        , size_{std::char_traits<char>::length(text)} {
+    }
+
+    const char* GetData() const noexcept {
+        return data_;
+    }
+
+    std::string_view GetText() const noexcept {
+        return {data_, size_};
+    }
+
+private:
+    const char* data_;
+    size_t size_;
+};
+
+template <typename T>
+constexpr bool IS_LITERAL = std::is_same_v<std::remove_cv_t<T>, Literal>;
+
+template <typename T>
+constexpr bool IS_INTEGER = std::is_integral_v<T> && !IS_ONE_OF<T, bool, char, signed char, unsigned char>;
+
+template <typename T, typename U>
+constexpr bool HAS_LAYOUT = sizeof(T) == sizeof(U) && std::is_signed_v<T> == std::is_signed_v<U>;
+
+// Тип аргумента в записи. T - тип аргумента LOG без ссылки, но с const
+template <typename T>
+constexpr ArgType GetArgType() {
+    using U = std::remove_cv_t<T>;
+    if constexpr (std::is_same_v<U, bool>) {
+        return ArgType::BOOL;
+    } else if constexpr (IS_ONE_OF<U, char, signed char, unsigned char>) {
+        return ArgType::CHAR;
+    } else if constexpr (IS_INTEGER<U> && HAS_LAYOUT<U, int16_t>) {
+        return ArgType::INT16;
+    } else if constexpr (IS_INTEGER<U> && HAS_LAYOUT<U, int32_t>) {
+        return ArgType::INT32;
+    } else if constexpr (IS_INTEGER<U> && HAS_LAYOUT<U, int64_t>) {
+        return ArgType::INT64;
+    } else if constexpr (IS_INTEGER<U> && HAS_LAYOUT<U, uint16_t>) {
+        return ArgType::UINT16;
+    } else if constexpr (IS_INTEGER<U> && HAS_LAYOUT<U, uint32_t>) {
+        return ArgType::UINT32;
+    } else if constexpr (IS_INTEGER<U> && HAS_LAYOUT<U, uint64_t>) {
+        return ArgType::UINT64;
+    } else if constexpr (std::is_same_v<U, float>) {
+        return ArgType::FLOAT;
+    } else if constexpr (std::is_floating_point_v<U>) {
+        return ArgType::DOUBLE;
+    } else if constexpr (IS_LITERAL<T>) {
+        return ArgType::LITERAL;
+    } else {
+        static_assert(std::is_convertible_v<const T&, std::string_view>);
+        return ArgType::STRING;
+    }
+}
+
+// Можно ли сохранить аргумент в запись без вывода в std::ostream
+template <typename T>
+constexpr bool IS_DIRECT_ARG = std::is_arithmetic_v<std::remove_cv_t<T>> || IS_LITERAL<T>
+                            || std::is_convertible_v<const T&, std::string_view>;
+
+// Размер значения фиксированной ширины. Для STRING - размер длины
+constexpr size_t GetFixedSize(ArgType type) {
+    switch (type) {
+        case ArgType::BOOL:
+        case ArgType::CHAR:
+            return 1;
+        case ArgType::INT16:
+        case ArgType::UINT16:
+            return 2;
+        case ArgType::INT32:
+        case ArgType::UINT32:
+        case ArgType::FLOAT:
+        case ArgType::STRING:
+        case ArgType::LITERAL:
+            return 4;
+        case ArgType::INT64:
+        case ArgType::UINT64:
+        case ArgType::DOUBLE:
+            return 8;
+    }
+    throw std::invalid_argument("Unknown log argument type");
+}
+
+template <typename T>
+void WriteValue(char*& out, const T& value) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>);
+    std::memcpy(out, &value, sizeof(value));
+    out += sizeof(value);
+}
+
+template <typename T>
+void AppendValue(std::string& out, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Читает значение из начала data. Выбрасывает std::runtime_error, если данных не хватает
+template <typename T>
+T ReadValue(std::string_view& data) {
+    if (data.size() < sizeof(T)) {
+        throw std::runtime_error("Log record is truncated");
+    }
+    T value;
+    std::memcpy(&value, data.data(), sizeof(value));
+    data.remove_prefix(sizeof(value));
+    return value;
+}
+
+// Форматы и литералы, на которые ссылаются записи
+struct Dictionary {
+    std::vector<std::vector<ArgType>> formats;
+    std::vector<std::string> literals;
+
+    const std::vector<ArgType>& GetFormat(uint32_t id) const {
+        if (id >= formats.size()) {
+            throw std::runtime_error("Unknown log record format");
+        }
+        return formats[id];
+    }
+
+    std::string_view GetLiteral(uint32_t id) const {
+        if (id >= literals.size()) {
+            throw std::runtime_error("Unknown log string literal");
+        }
+        return literals[id];
+    }
+};
+
+// Вызывает visit(ArgType, std::string_view value) для каждого значения записи без заголовка
+template <typename Visit>
+void VisitValues(const std::vector<ArgType>& format, std::string_view data, Visit&& visit) {
+    for (const ArgType type : format) {
+        size_t size = GetFixedSize(type);
+        if (data.size() < size) {
+            throw std::runtime_error("Log record is truncated");
+        }
+        if (type == ArgType::STRING) {
+            std::string_view length = data;
+            size += ReadValue<uint32_t>(length);
+            if (data.size() < size) {
+                throw std::runtime_error("Log record is truncated");
+            }
+        }
+        visit(type, data.substr(0, size));
+        data.remove_prefix(size);
+    }
+}
+
+template <typename T>
+void AppendNumber(std::string& out, std::string_view value) {
+    char buffer[32];
+    std::to_chars_result result;
+    if constexpr (std::is_floating_point_v<T>) {
+        // Как std::ostream с точностью по умолчанию
+        result = std::to_chars(buffer, std::end(buffer), ReadValue<T>(value),
+                               std::chars_format::general, 6);
+    } else {
+        result = std::to_chars(buffer, std::end(buffer), ReadValue<T>(value));
+    }
+    out.append(buffer, result.ptr);
+}
+
+// Выводит значения записи так же, как их вывел бы std::ostream с настройками по умолчанию
+inline void AppendValuesText(std::string& out, const Dictionary& dictionary,
+                             const std::vector<ArgType>& format, std::string_view data) {
+    VisitValues(format, data, [&out, &dictionary](ArgType type, std::string_view value) {
+        switch (type) {
+            case ArgType::BOOL:
+                out.push_back(value[0] ? '1' : '0');
+                break;
+            case ArgType::CHAR:
+                out.push_back(value[0]);
+                break;
+            case ArgType::INT16:
+                AppendNumber<int16_t>(out, value);
+                break;
+            case ArgType::INT32:
+                AppendNumber<int32_t>(out, value);
+                break;
+            case ArgType::INT64:
+                AppendNumber<int64_t>(out, value);
+                break;
+            case ArgType::UINT16:
+                AppendNumber<uint16_t>(out, value);
+                break;
+            case ArgType::UINT32:
+                AppendNumber<uint32_t>(out, value);
+                break;
+            case ArgType::UINT64:
+                AppendNumber<uint64_t>(out, value);
+                break;
+            case ArgType::FLOAT:
+                AppendNumber<float>(out, value);
+                break;
+            case ArgType::DOUBLE:
+                AppendNumber<double>(out, value);
+                break;
+            case ArgType::STRING:
+                out.append(value.substr(sizeof(uint32_t)));
+                break;
+            case ArgType::LITERAL:
+                out.append(dictionary.GetLiteral(ReadValue<uint32_t>(value)));
+                break;
+        }
+    });
+}
+
+inline std::time_t ToTimeT(int64_t ticks) {
+    return Clock::to_time_t(Clock::time_point{Clock::duration{ticks}});
+}
+
+// Разбирает заголовок записи: возвращает время и формат, оставляя в record значения
+inline std::pair<int64_t, uint32_t> ReadRecordHeader(std::string_view& record) {
+    const auto ticks = ReadValue<int64_t>(record);
+    const auto format_id = ReadValue<uint32_t>(record);
+    return {ticks, format_id};
+}
+
+/*
+ * Кэш форматирования времени записей.
+ * Дата "%F" и дата для имени файла "%Y_%m_%d" вычисляются через localtime_r только
+ * при смене дня, время "%T" - только при смене секунды, причём в обычные сутки
+ * оно считается от начала дня без обращения к localtime_r.
+ * Объект не потокобезопасен: у каждого потока должен быть свой.
+ */
+class TimestampCache {
+public:
+    static constexpr std::time_t DAY_SECONDS = 24 * 60 * 60;
+
+    // Возвращает "%F %T" для времени t
+    std::string_view Get(std::time_t t) {
+        if (t != second_) {
+            Update(t);
+        }
+        return {text_, text_size_};
+    }
+
+    // Возвращает дату "%Y_%m_%d" для времени t
+    std::string_view GetFileDate(std::time_t t) {
+        if (t < day_start_ || t >= day_end_) {
+            SetDay(t);
+        }
+        return {file_date_, file_date_size_};
+    }
+
+    // Границы местных суток, в которые попадает время t: [start, end)
+    std::pair<std::time_t, std::time_t> GetDayBounds(std::time_t t) {
+        if (t < day_start_ || t >= day_end_) {
+            SetDay(t);
+        }
+        return {day_start_, day_end_};
+    }
+
+private:
+    void Update(std::time_t t) {
+        if (t < day_start_ || t >= day_end_) {
+            SetDay(t);
+        }
+        second_ = t;
+        char* time = text_ + date_size_;
+        if (day_end_ - day_start_ == DAY_SECONDS) {
+            const auto seconds = static_cast<int>(t - day_start_);
+            WriteTwoDigits(time, seconds / 3600);
+            time[2] = ':';
+            WriteTwoDigits(time + 3, seconds / 60 % 60);
+            time[5] = ':';
+            WriteTwoDigits(time + 6, seconds % 60);
+            text_size_ = date_size_ + 8;
+        } else {
+            // В сутки перехода на летнее время и обратно час считает localtime_r
+            std::tm tm;
+            localtime_r(&t, &tm);
+            text_size_ = date_size_ + std::strftime(time, sizeof(text_) - date_size_, "%T", &tm);
+        }
+    }
+
+    void SetDay(std::time_t t) {
+        std::tm tm;
+        localtime_r(&t, &tm);
+        date_size_ = std::strftime(text_, sizeof(text_), "%F ", &tm);
+        file_date_size_ = std::strftime(file_date_, sizeof(file_date_), "%Y_%m_%d", &tm);
+
+        tm.tm_hour = tm.tm_min = tm.tm_sec = 0;
+        tm.tm_isdst = -1;
+        day_start_ = std::mktime(&tm);
+        ++tm.tm_mday;
+        tm.tm_isdst = -1;
+        day_end_ = std::mktime(&tm);
+    }
+
+    static void WriteTwoDigits(char* out, int value) noexcept {
+        out[0] = static_cast<char>('0' + value / 10);
+        out[1] = static_cast<char>('0' + value % 10);
+    }
+
+    std::time_t second_ = -1;
+    std::time_t day_start_ = 0;
+    std::time_t day_end_ = 0;
+    char text_[64] = {};
+    size_t date_size_ = 0;
+    size_t text_size_ = 0;
+    char file_date_[32] = {};
+    size_t file_date_size_ = 0;
+};
+
+
+// Добавляет строку текстового журнала для записи
+inline void AppendRecordText(std::string& out, TimestampCache& timestamps,
+                             const Dictionary& dictionary, std::string_view record) {
+    const auto [ticks, format_id] = ReadRecordHeader(record);
+    out += timestamps.Get(ToTimeT(ticks));
+    out += ": ";
+    AppendValuesText(out, dictionary, dictionary.GetFormat(format_id), record);
+    out += '\n';
+}
+
+// Добавляет строку текстового журнала об отброшенных записях
+inline void AppendDroppedText(std::string& out, TimestampCache& timestamps, int64_t ticks,
+                              uint64_t count) {
+    out += timestamps.Get(ToTimeT(ticks));
+    out += ": Dropped ";
+    out += std::to_string(count);
+    out += " log records\n";
+}
+
+}  // namespace log_detail
@@ -1,38 +1,419 @@
 #pragma once
 
+#include <atomic>
+#include <charconv>
 #include <chrono>
-#include <iomanip>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
 #include <fstream>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <string_view>
-#include <optional>
-#include <mutex>
 #include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <unordered_map>
+#include <vector>
+
+#include "log_format.h"
 
 using namespace std::literals;
 
 #define LOG(...) Logger::GetInstance().Log(__VA_ARGS__)
+// Строковый литерал, который сохраняется в записи номером, а не текстом.
+// Конкатенация с "" не даёт передать в макрос что-либо, кроме строкового литерала
+#define LOG_LITERAL(text) ::log_detail::Literal{"" text}
+
+namespace log_detail {
+
+/*
+ * Форматы и литералы, зарегистрированные в этом процессе.
+ * Регистрация выполняется один раз для набора типов или литерала,
+ * а фоновый поток копирует новые определения в свой Dictionary.
+ */
+class Registry {
+public:
+    static Registry& GetInstance() {
+        static Registry registry;
+        return registry;
+    }
+
+    uint32_t AddFormat(std::vector<ArgType> format) {
+        std::lock_guard lock{mutex_};
+        if (dictionary_.formats.size() >= MAX_DEFINITIONS) {
+            throw std::length_error("Too many log record formats");
+        }
+        dictionary_.formats.push_back(std::move(format));
+        format_count_.store(dictionary_.formats.size(), std::memory_order_release);
+        return static_cast<uint32_t>(dictionary_.formats.size() - 1);
+    }
+
+    // Возвращает номер литерала. Литералы различаются адресом, поэтому число номеров
+    // не превышает числа литералов в программе
+    uint32_t AddLiteral(Literal literal) {
+        std::lock_guard lock{mutex_};
+        if (const auto it = literal_ids_.find(literal.GetData()); it != literal_ids_.end()) {
+            return it->second;
+        }
+        if (dictionary_.literals.size() >= MAX_DEFINITIONS) {
+            throw std::length_error("Too many log string literals");
+        }
+        const auto id = static_cast<uint32_t>(dictionary_.literals.size());
+        dictionary_.literals.emplace_back(literal.GetText());
+        literal_ids_.emplace(literal.GetData(), id);
+        literal_count_.store(dictionary_.literals.size(), std::memory_order_release);
+        return id;
+    }
+
+    // Есть ли определения, которых нет в копии dictionary
+    bool HasNewerThan(const Dictionary& dictionary) const noexcept {
+        return format_count_.load(std::memory_order_acquire) != dictionary.formats.size()
+            || literal_count_.load(std::memory_order_acquire) != dictionary.literals.size();
+    }
+
+    // Дописывает в dictionary определения, которых в нём ещё нет
+    void CopyNewTo(Dictionary& dictionary) const {
+        std::lock_guard lock{mutex_};
+        dictionary.formats.insert(dictionary.formats.end(),
+                                  dictionary_.formats.begin() + dictionary.formats.size(),
+                                  dictionary_.formats.end());
+        dictionary.literals.insert(dictionary.literals.end(),
+                                   dictionary_.literals.begin() + dictionary.literals.size(),
+                                   dictionary_.literals.end());
+    }
+
+private:
+    Registry() = default;
+
+    mutable std::mutex mutex_;
+    Dictionary dictionary_;
+    std::unordered_map<const char*, uint32_t> literal_ids_;
+    std::atomic<size_t> format_count_ = 0;
+    std::atomic<size_t> literal_count_ = 0;
+};
+
+// Номер формата для набора типов аргументов, регистрируется при первом вызове
+template <typename... Ts>
+uint32_t GetFormatId() {
+    static const uint32_t id = Registry::GetInstance().AddFormat({GetArgType<Ts>()...});
+    return id;
+}
+
+// Номер литерала. Потоки запоминают номера недавних литералов, чтобы не обращаться к реестру
+inline uint32_t GetLiteralId(Literal literal) {
+    struct Entry {
+        const char* data = nullptr;
+        uint32_t id = 0;
+    };
+    static constexpr size_t CACHE_SIZE = 256;
+    thread_local Entry cache[CACHE_SIZE];
+    const char* data = literal.GetData();
+    Entry& entry = cache[(reinterpret_cast<uintptr_t>(data) >> 3) % CACHE_SIZE];
+    if (entry.data != data) {
+        entry = {data, Registry::GetInstance().AddLiteral(literal)};
+    }
+    return entry.id;
+}
+
+template <typename T>
+size_t GetArgSize(const T& arg) noexcept {
+    constexpr ArgType type = GetArgType<T>();
+    if constexpr (type == ArgType::STRING) {
+        return sizeof(uint32_t) + std::string_view{arg}.size();
+    } else {
+        return GetFixedSize(type);
+    }
+}
+
+template <typename T>
+void WriteArg(char*& out, const T& arg) {
+    constexpr ArgType type = GetArgType<T>();
+    if constexpr (type == ArgType::BOOL || type == ArgType::CHAR) {
+        *out++ = static_cast<char>(arg);
+    } else if constexpr (type == ArgType::DOUBLE) {
+        WriteValue(out, static_cast<double>(arg));
+    } else if constexpr (type == ArgType::LITERAL) {
+        WriteValue(out, GetLiteralId(arg));
+    } else if constexpr (type == ArgType::STRING) {
+        const std::string_view str{arg};
+        WriteValue(out, static_cast<uint32_t>(str.size()));
+        std::memcpy(out, str.data(), str.size());
+        out += str.size();
+    } else {
+        WriteValue(out, arg);
+    }
+}
+
+// Аргументы, которые нельзя сохранить как есть, выводятся в std::ostream на вызывающем потоке
+template <typename T>
+decltype(auto) PrepareArg(T&& arg) {
+    if constexpr (IS_DIRECT_ARG<std::remove_reference_t<T>>) {
+        return std::forward<T>(arg);
+    } else {
+        std::ostringstream stream;
+        stream << arg;
+        return std::move(stream).str();
+    }
+}
+
+// Файл журнала, открытый заранее
+struct PreparedFile {
+    std::filesystem::path path;
+    std::ofstream file;
+    // Файла не было до открытия, и его можно удалить, если он не понадобится
+    bool created = false;
+};
+
+inline PreparedFile PrepareFile(std::filesystem::path path) {
+    PreparedFile result;
+    std::error_code ec;
+    result.created = !std::filesystem::exists(path, ec);
+    result.file.open(path, std::ios::app | std::ios::binary);
+    result.path = std::move(path);
+    return result;
+}
+
+// Закрывает ненужный заранее открытый файл и удаляет его, если он пуст и создан заранее
+inline void DiscardFile(PreparedFile prepared) {
+    prepared.file.close();
+    std::error_code ec;
+    if (prepared.created && std::filesystem::file_size(prepared.path, ec) == 0 && !ec) {
+        std::filesystem::remove(prepared.path, ec);
+    }
+}
+
+/*
+ * Кольцевой буфер записей с одним писателем и одним читателем.
+ * Запись - заголовок с её длиной и сами байты, выровненные по 8 байт.
+ * Если запись не помещается в конец буфера, там ставится метка перехода в начало.
+ * Запись больше половины буфера размещается в куче, а в буфер попадает указатель на неё,
+ * так что она выводится в том же порядке, что и остальные записи потока.
+ */
+class RecordRing {
+public:
+    // Вместимость - степень двойки
+    explicit RecordRing(size_t capacity)
+        : buffer_(std::make_unique<char[]>(capacity))
+        , capacity_(capacity)
+        , mask_(capacity - 1) {
+    }
+
+    RecordRing(const RecordRing&) = delete;
+    RecordRing& operator=(const RecordRing&) = delete;
+
+    // Освобождает записи в куче, которые читатель не успел забрать
+    ~RecordRing() {
+        Drain([](std::string_view) {});
+    }
+
+    static constexpr size_t GetRecordSize(size_t payload_size) noexcept {
+        return (HEADER_SIZE + payload_size + 7) & ~size_t{7};
+    }
+
+    // Запись, которая никогда не поместится в буфер и размещается в куче
+    bool IsTooLarge(size_t payload_size) const noexcept {
+        return GetRecordSize(payload_size) > capacity_ / 2;
+    }
+
+    // Записывает в буфер запись из payload_size байт, которые заполняет функция write(char*).
+    // Возвращает false, если места нет. Вызывается только писателем
+    template <typename Write>
+    bool TryPush(size_t payload_size, Write&& write) {
+        if (IsTooLarge(payload_size)) {
+            return false;
+        }
+        return TryPushEntry(static_cast<uint32_t>(payload_size), payload_size, write);
+    }
+
+    // Записывает в буфер указатель на запись в куче. При успехе буфер забирает запись
+    // и удаляет её после чтения. Возвращает false, если места нет. Вызывается только писателем
+    bool TryPushLarge(std::unique_ptr<std::string>& record) {
+        const std::string* data = record.get();
+        if (!TryPushEntry(LARGE, sizeof(data), [data](char* out) {
+                std::memcpy(out, &data, sizeof(data));
+            })) {
+            return false;
+        }
+        (void)record.release();
+        return true;
+    }
+
+    // Передаёт функции consume(std::string_view) все опубликованные записи
+    // и возвращает их количество. Вызывается только читателем
+    template <typename Consume>
+    size_t Drain(Consume&& consume) {
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        size_t count = 0;
+        while (tail != head) {
+            const size_t offset = tail & mask_;
+            uint32_t payload_size;
+            std::memcpy(&payload_size, buffer_.get() + offset, sizeof(payload_size));
+            if (payload_size == WRAP) {
+                tail += capacity_ - offset;
+                continue;
+            }
+            if (payload_size == LARGE) {
+                std::string* record;
+                std::memcpy(&record, buffer_.get() + offset + HEADER_SIZE, sizeof(record));
+                const std::unique_ptr<std::string> owner{record};
+                consume(std::string_view{*record});
+                tail += GetRecordSize(sizeof(record));
+            } else {
+                consume(std::string_view{buffer_.get() + offset + HEADER_SIZE, payload_size});
+                tail += GetRecordSize(payload_size);
+            }
+            tail_.store(tail, std::memory_order_release);
+            ++count;
+        }
+        tail_.store(tail, std::memory_order_release);
+        return count;
+    }
+
+    bool IsEmpty() const noexcept {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+
+    void AddDropped() noexcept {
+        dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Возвращает число отброшенных записей, о которых читатель ещё не знает
+    uint64_t TakeDropped() noexcept {
+        const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+        const uint64_t result = dropped - reported_dropped_;
+        reported_dropped_ = dropped;
+        return result;
+    }
+
+    void Close() noexcept {
+        closed_.store(true, std::memory_order_release);
+    }
+
+    bool IsClosed() const noexcept {
+        return closed_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t HEADER_SIZE = sizeof(uint32_t);
+    static constexpr uint32_t WRAP = UINT32_MAX;
+    // Заголовок записи, вместо байтов которой хранится указатель на std::string в куче
+    static constexpr uint32_t LARGE = UINT32_MAX - 1;
+
+    // Записывает в буфер элемент с заголовком header и payload_size байтами
+    template <typename Write>
+    bool TryPushEntry(uint32_t header, size_t payload_size, Write&& write) {
+        const size_t size = GetRecordSize(payload_size);
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        size_t offset = head & mask_;
+        const size_t skip = capacity_ - offset < size ? capacity_ - offset : 0;
+        if (head + skip + size - cached_tail_ > capacity_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head + skip + size - cached_tail_ > capacity_) {
+                return false;
+            }
+        }
+        if (skip != 0) {
+            WriteHeader(offset, WRAP);
+            head += skip;
+            offset = 0;
+        }
+        WriteHeader(offset, header);
+        write(buffer_.get() + offset + HEADER_SIZE);
+        head_.store(head + size, std::memory_order_release);
+        return true;
+    }
+
+    void WriteHeader(size_t offset, uint32_t value) noexcept {
+        std::memcpy(buffer_.get() + offset, &value, sizeof(value));
+    }
+
+    std::unique_ptr<char[]> buffer_;
+    size_t capacity_;
+    size_t mask_;
+
+    // Поля писателя и читателя лежат в разных строках кэша
+    alignas(64) std::atomic<uint64_t> head_ = 0;
+    uint64_t cached_tail_ = 0;
+    std::atomic<uint64_t> dropped_ = 0;
+    alignas(64) std::atomic<uint64_t> tail_ = 0;
+    uint64_t reported_dropped_ = 0;
+    std::atomic<bool> closed_ = false;
+};
+
+}  // namespace log_detail
+
+// Формат файлов журнала
+enum class LogMode {
+    TEXT,    // sample_log_YYYY_MM_DD.log
+    BINARY,  // sample_log_YYYY_MM_DD.bin, читается программой log_decoder
+};
+
+// Что делать, когда кольцевой буфер потока заполнен
+enum class OverflowPolicy {
+    BLOCK,  // ждать, пока фоновый поток освободит место
+    DROP,   // отбросить запись и учесть её в счётчике отброшенных
+};
 
+/*
+ * Асинхронный журнал.
+ * LOG на вызывающем потоке только копирует время и аргументы в кольцевой буфер этого потока,
+ * без блокировок и выделения памяти. Типы аргументов известны на этапе компиляции,
+ * поэтому запись ссылается на заранее зарегистрированный формат (см. log_format.h).
+ * Единственный фоновый поток забирает записи из буферов всех потоков, форматирует их
+ * и пишет в файл пачками. Записи одного потока выводятся в порядке вызова LOG.
+ * Без записей фоновый поток проверяет буферы всё реже, не чаще раза в MAX_POLL_INTERVAL,
+ * так что запись, сделанная после простоя, попадает в файл с такой задержкой.
+ */
 class Logger {
+    static constexpr size_t RING_CAPACITY = 1 << 20;
+    static_assert((RING_CAPACITY & (RING_CAPACITY - 1)) == 0);
+    static constexpr size_t BATCH_SIZE = 64 * 1024;
+    static constexpr int64_t NO_MANUAL_TS = INT64_MIN;
+    // За сколько секунд до конца дня открывать файл следующего дня
+    static constexpr std::time_t PREPARE_AHEAD = 10 * 60;
+    // Период проверки буферов фоновым потоком растёт вдвое после каждой пустой проверки
+    static constexpr std::chrono::milliseconds MIN_POLL_INTERVAL{1};
+    static constexpr std::chrono::milliseconds MAX_POLL_INTERVAL{100};
+
+    using Clock = log_detail::Clock;
+
     auto GetTime() const {
-        if (manual_ts_) {
-            return *manual_ts_;
+        if (const auto ts = manual_ts_.load(std::memory_order_acquire); ts != NO_MANUAL_TS) {
+            return Clock::time_point{Clock::duration{ts}};
         }
 
-        return std::chrono::system_clock::now();
+        return Clock::now();
+    }
+
+    static log_detail::TimestampCache& GetTimestampCache() {
+        thread_local log_detail::TimestampCache cache;
+        return cache;
     }
 
-    auto GetTimeStamp() const {
-        const auto now = GetTime();
-        const auto t_c = std::chrono::system_clock::to_time_t(now);
-        return std::put_time(std::localtime(&t_c), "%F %T");
+    // Дата для имени файла в формате "%Y_%m_%d"
+    static std::string_view GetFileTimeStamp(std::time_t t) {
+        return GetTimestampCache().GetFileDate(t);
     }
 
-    // Для имени файла возьмите дату с форматом "%Y_%m_%d"
-    std::string GetFileTimeStamp() const;
+    Logger() {
+        // Статические объекты разрушаются в обратном порядке, поэтому реестр создаётся
+        // раньше журнала: фоновый поток обращается к нему, дописывая записи при выходе
+        log_detail::Registry::GetInstance();
+        writer_ = std::thread{[this] {
+            Run();
+        }};
+    }
 
-    Logger() = default;
     Logger(const Logger&) = delete;
 
 public:
@@ -41,15 +422,386 @@ public:
         return obj;
     }
 
-    // Выведите в поток все аргументы.
-    template<class... Ts>
-    void Log(const Ts&... args);
+    ~Logger() {
+        {
+            std::lock_guard lock{mutex_};
+            stopping_ = true;
+        }
+        wake_cv_.notify_one();
+        writer_.join();
+    }
 
-    // Установите manual_ts_. Учтите, что эта операция может выполняться
-    // параллельно с выводом в поток, вам нужно предусмотреть 
-    // синхронизацию.
-    void SetTimestamp(std::chrono::system_clock::time_point ts);
+    // Сохраняет время и аргументы в кольцевой буфер потока.
+    // Вывод аргументов совпадает с выводом в std::ostream.
+    // Строки сохраняются по значению, а литералы из LOG_LITERAL - номером
+    template <class... Ts>
+    void Log(Ts&&... args) {
+        if constexpr ((log_detail::IS_DIRECT_ARG<std::remove_reference_t<Ts>> && ...)) {
+            LogDirect(std::forward<Ts>(args)...);
+        } else {
+            LogDirect(log_detail::PrepareArg(std::forward<Ts>(args))...);
+        }
+    }
+
+    // Устанавливает время, которым помечаются следующие записи.
+    // Может вызываться параллельно с Log
+    void SetTimestamp(std::chrono::system_clock::time_point ts) {
+        manual_ts_.store(ts.time_since_epoch().count(), std::memory_order_release);
+    }
+
+    // Формат файлов, которые будут открыты после вызова
+    void SetMode(LogMode mode) {
+        std::lock_guard lock{mutex_};
+        mode_ = mode;
+        ++output_version_;
+    }
+
+    void SetOverflowPolicy(OverflowPolicy policy) {
+        policy_.store(policy, std::memory_order_relaxed);
+    }
+
+    // Каталог для файлов журнала. Записи, сделанные до вызова, могут попасть в прежний каталог
+    void SetLogDirectory(std::filesystem::path directory) {
+        std::lock_guard lock{mutex_};
+        directory_ = std::move(directory);
+        ++output_version_;
+    }
+
+    // Ждёт, пока записи, сделанные до вызова, окажутся в файле
+    void Flush() {
+        std::unique_lock lock{mutex_};
+        const uint64_t request = ++flush_requested_;
+        wake_cv_.notify_one();
+        flushed_cv_.wait(lock, [this, request] {
+            return flushed_ >= request;
+        });
+    }
+
+    // Число записей, отброшенных из-за переполнения буферов и уже учтённых фоновым потоком
+    uint64_t GetDroppedCount() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
 
 private:
-    std::optional<std::chrono::system_clock::time_point> manual_ts_;
+    // Буфер потока. При завершении потока помечается закрытым и удаляется,
+    // когда фоновый поток заберёт из него все записи
+    struct ThreadRing {
+        explicit ThreadRing(Logger& logger)
+            : ring(std::make_shared<log_detail::RecordRing>(RING_CAPACITY)) {
+            std::lock_guard lock{logger.mutex_};
+            logger.rings_.push_back(ring);
+            ++logger.rings_version_;
+        }
+
+        ~ThreadRing() {
+            ring->Close();
+        }
+
+        std::shared_ptr<log_detail::RecordRing> ring;
+    };
+
+    log_detail::RecordRing& GetThreadRing() {
+        thread_local ThreadRing thread_ring{*this};
+        return *thread_ring.ring;
+    }
+
+    template <class... Ts>
+    void LogDirect(Ts&&... args) {
+        const auto ticks = static_cast<int64_t>(GetTime().time_since_epoch().count());
+        const uint32_t format_id = log_detail::GetFormatId<std::remove_reference_t<Ts>...>();
+        const size_t size = log_detail::RECORD_HEADER_SIZE
+                          + (log_detail::GetArgSize<std::remove_reference_t<Ts>>(args) + ... + 0);
+        Push(size, [&](char* out) {
+            log_detail::WriteValue(out, ticks);
+            log_detail::WriteValue(out, format_id);
+            (log_detail::WriteArg<std::remove_reference_t<Ts>>(out, args), ...);
+        });
+    }
+
+    template <typename Write>
+    void Push(size_t size, const Write& write) {
+        auto& ring = GetThreadRing();
+        if (ring.IsTooLarge(size)) {
+            // Запись больше половины буфера передаётся фоновому потоку через кучу
+            auto record = std::make_unique<std::string>(size, '\0');
+            write(record->data());
+            PushEntry(ring, [&ring, &record] {
+                return ring.TryPushLarge(record);
+            });
+        } else {
+            PushEntry(ring, [&ring, size, &write] {
+                return ring.TryPush(size, write);
+            });
+        }
+    }
+
+    // Помещает запись в буфер функцией try_push. Если буфер заполнен, ждёт или отбрасывает
+    // запись в зависимости от политики
+    template <typename TryPush>
+    void PushEntry(log_detail::RecordRing& ring, const TryPush& try_push) {
+        if (try_push()) {
+            return;
+        }
+        if (policy_.load(std::memory_order_relaxed) == OverflowPolicy::DROP) {
+            ring.AddDropped();
+            return;
+        }
+        WakeWriter();
+        while (!try_push()) {
+            std::this_thread::yield();
+        }
+    }
+
+    void WakeWriter() {
+        {
+            std::lock_guard lock{mutex_};
+            wake_requested_ = true;
+        }
+        wake_cv_.notify_one();
+    }
+
+    void Run() {
+        std::vector<std::shared_ptr<log_detail::RecordRing>> rings;
+        uint64_t rings_version = 0;
+        uint64_t output_version = 0;
+        uint64_t flushed = 0;
+        auto poll_interval = MIN_POLL_INTERVAL;
+        while (true) {
+            bool stopping;
+            uint64_t flush_requested;
+            {
+                std::lock_guard lock{mutex_};
+                stopping = stopping_;
+                flush_requested = flush_requested_;
+                if (rings_version != rings_version_) {
+                    rings = rings_;
+                    rings_version = rings_version_;
+                }
+                if (output_version != output_version_) {
+                    WriteBatch();
+                    file_.close();
+                    day_end_ = 0;
+                    DiscardNextFile();
+                    file_directory_ = directory_;
+                    file_mode_ = mode_;
+                    output_version = output_version_;
+                }
+            }
+
+            size_t processed = 0;
+            for (const auto& ring : rings) {
+                processed += ring->Drain([this](std::string_view record) {
+                    FormatRecord(record);
+                });
+                if (const uint64_t dropped = ring->TakeDropped(); dropped != 0) {
+                    ReportDropped(dropped);
+                }
+            }
+
+            if (processed != 0) {
+                poll_interval = MIN_POLL_INTERVAL;
+            }
+            if (processed != 0 && batch_.size() < BATCH_SIZE && !stopping
+                && flush_requested == flushed) {
+                continue;
+            }
+            WriteBatch();
+            if (flush_requested != flushed) {
+                file_.flush();
+                std::lock_guard lock{mutex_};
+                flushed_ = flushed = flush_requested;
+                flushed_cv_.notify_all();
+            }
+            if (processed != 0) {
+                continue;
+            }
+            if (stopping) {
+                break;
+            }
+            RemoveClosedRings(rings);
+
+            // Без записей фоновый поток проверяет буферы всё реже, чтобы не просыпаться
+            // впустую, а вызывающие потоки не тратят время на то, чтобы его будить
+            std::unique_lock lock{mutex_};
+            wake_cv_.wait_for(lock, poll_interval, [this, flushed] {
+                return stopping_ || flush_requested_ != flushed || wake_requested_;
+            });
+            wake_requested_ = false;
+            poll_interval = std::min(poll_interval * 2, MAX_POLL_INTERVAL);
+        }
+        file_.close();
+        DiscardNextFile();
+    }
+
+    void RemoveClosedRings(std::vector<std::shared_ptr<log_detail::RecordRing>>& rings) {
+        std::erase_if(rings, [](const auto& ring) {
+            return ring->IsClosed() && ring->IsEmpty();
+        });
+        std::lock_guard lock{mutex_};
+        const auto removed = std::erase_if(rings_, [](const auto& ring) {
+            return ring->IsClosed() && ring->IsEmpty();
+        });
+        if (removed != 0) {
+            ++rings_version_;
+        }
+    }
+
+    void FormatRecord(std::string_view record) {
+        // Формат и литералы регистрируются до публикации записи, поэтому уже видны в реестре
+        if (log_detail::Registry::GetInstance().HasNewerThan(dictionary_)) {
+            log_detail::Registry::GetInstance().CopyNewTo(dictionary_);
+        }
+        auto header = record;
+        const auto [ticks, format_id] = log_detail::ReadRecordHeader(header);
+        SwitchFile(log_detail::ToTimeT(ticks));
+        if (file_mode_ == LogMode::BINARY) {
+            AppendBinaryRecord(record, format_id, header);
+        } else {
+            log_detail::AppendRecordText(batch_, GetTimestampCache(), dictionary_, record);
+        }
+        if (batch_.size() >= BATCH_SIZE) {
+            WriteBatch();
+        }
+    }
+
+    // Дописывает запись в двоичный журнал вместе с определениями, которых ещё нет в файле
+    void AppendBinaryRecord(std::string_view record, uint32_t format_id, std::string_view values) {
+        using log_detail::AppendValue;
+        using log_detail::EntryKind;
+
+        const auto& format = dictionary_.GetFormat(format_id);
+        if (MarkWritten(written_formats_, format_id)) {
+            batch_ += static_cast<char>(EntryKind::FORMAT);
+            AppendValue(batch_, format_id);
+            AppendValue(batch_, static_cast<uint32_t>(format.size()));
+            for (const auto type : format) {
+                batch_ += static_cast<char>(type);
+            }
+        }
+        log_detail::VisitValues(format, values, [this](log_detail::ArgType type,
+                                                       std::string_view value) {
+            if (type != log_detail::ArgType::LITERAL) {
+                return;
+            }
+            const auto id = log_detail::ReadValue<uint32_t>(value);
+            if (MarkWritten(written_literals_, id)) {
+                const auto literal = dictionary_.GetLiteral(id);
+                batch_ += static_cast<char>(EntryKind::LITERAL);
+                AppendValue(batch_, id);
+                AppendValue(batch_, static_cast<uint32_t>(literal.size()));
+                batch_ += literal;
+            }
+        });
+        batch_ += static_cast<char>(EntryKind::RECORD);
+        AppendValue(batch_, static_cast<uint32_t>(record.size()));
+        batch_ += record;
+    }
+
+    // Отмечает определение записанным в текущий файл. Возвращает false, если оно уже там есть
+    static bool MarkWritten(std::vector<bool>& written, uint32_t id) {
+        if (id >= written.size()) {
+            written.resize(id + 1);
+        }
+        if (written[id]) {
+            return false;
+        }
+        written[id] = true;
+        return true;
+    }
+
+    void ReportDropped(uint64_t dropped) {
+        dropped_.fetch_add(dropped, std::memory_order_relaxed);
+        const auto ticks = static_cast<int64_t>(GetTime().time_since_epoch().count());
+        SwitchFile(log_detail::ToTimeT(ticks));
+        if (file_mode_ == LogMode::BINARY) {
+            batch_ += static_cast<char>(log_detail::EntryKind::DROPPED);
+            log_detail::AppendValue(batch_, ticks);
+            log_detail::AppendValue(batch_, dropped);
+        } else {
+            log_detail::AppendDroppedText(batch_, GetTimestampCache(), ticks, dropped);
+        }
+    }
+
+    std::filesystem::path GetFilePath(std::time_t t) const {
+        std::string name = "sample_log_"s;
+        name += GetFileTimeStamp(t);
+        name += file_mode_ == LogMode::BINARY ? ".bin"sv : ".log"sv;
+        return file_directory_ / name;
+    }
+
+    // Открывает файл дня, к которому относится время t.
+    // Незадолго до конца дня файл следующего дня открывается заранее в отдельном потоке,
+    // так что смена дня сводится к замене потока вывода
+    void SwitchFile(std::time_t t) {
+        if (t < day_start_ || t >= day_end_) {
+            WriteBatch();
+            file_.close();
+            std::tie(day_start_, day_end_) = GetTimestampCache().GetDayBounds(t);
+            auto path = GetFilePath(t);
+            if (next_file_.valid() && next_file_path_ == path) {
+                file_ = std::move(next_file_.get().file);
+            } else {
+                DiscardNextFile();
+                file_.open(path, std::ios::app | std::ios::binary);
+            }
+            if (file_mode_ == LogMode::BINARY) {
+                // Номера форматов и литералов определяются в каждом файле заново
+                batch_ += log_detail::BINARY_MAGIC;
+                written_formats_.clear();
+                written_literals_.clear();
+            }
+        }
+        if (t >= day_end_ - PREPARE_AHEAD && !next_file_.valid()) {
+            next_file_path_ = GetFilePath(day_end_);
+            next_file_ = std::async(std::launch::async, log_detail::PrepareFile, next_file_path_);
+        }
+    }
+
+    void DiscardNextFile() {
+        if (next_file_.valid()) {
+            log_detail::DiscardFile(next_file_.get());
+        }
+    }
+
+    void WriteBatch() {
+        if (!batch_.empty()) {
+            file_.write(batch_.data(), static_cast<std::streamsize>(batch_.size()));
+            batch_.clear();
+        }
+    }
+
+    std::atomic<int64_t> manual_ts_ = NO_MANUAL_TS;
+    std::atomic<OverflowPolicy> policy_ = OverflowPolicy::BLOCK;
+    std::atomic<uint64_t> dropped_ = 0;
+
+    // Защищает поля ниже, которые разделяют вызывающие потоки и фоновый поток
+    std::mutex mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable flushed_cv_;
+    bool stopping_ = false;
+    // Вызывающий поток ждёт места в буфере и просит фоновый поток проснуться
+    bool wake_requested_ = false;
+    uint64_t flush_requested_ = 0;
+    uint64_t flushed_ = 0;
+    std::vector<std::shared_ptr<log_detail::RecordRing>> rings_;
+    uint64_t rings_version_ = 0;
+    std::filesystem::path directory_ = "/var/log"s;
+    LogMode mode_ = LogMode::TEXT;
+    // Увеличивается при смене каталога или формата файлов
+    uint64_t output_version_ = 0;
+
+    // Поля фонового потока
+    std::filesystem::path file_directory_ = "/var/log"s;
+    LogMode file_mode_ = LogMode::TEXT;
+    log_detail::Dictionary dictionary_;
+    std::vector<bool> written_formats_;
+    std::vector<bool> written_literals_;
+    std::ofstream file_;
+    std::time_t day_start_ = 0;
+    std::time_t day_end_ = 0;
+    std::future<log_detail::PreparedFile> next_file_;
+    std::filesystem::path next_file_path_;
+    std::string batch_;
+
+    std::thread writer_;
 };
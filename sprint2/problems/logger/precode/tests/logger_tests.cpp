@@ -0,0 +1,440 @@
+#define BOOST_TEST_MODULE logger tests
+#include <boost/test/unit_test.hpp>
+
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../log_decoder.h"
+#include "../my_logger.h"
+
+using namespace std::literals;
+namespace fs = std::filesystem;
+
+extern char** environ;
+
+namespace {
+
+// Каталог журнала для дочернего процесса теста Records_with_a_new_format_survive_shutdown
+constexpr auto SHUTDOWN_DIRECTORY_ENV = "LOGGER_TESTS_SHUTDOWN_DIRECTORY";
+
+// В дочернем процессе журнал создаётся раньше реестра форматов, а последняя запись
+// с новым форматом делается перед самым выходом, пока фоновый поток не догнал записи
+[[maybe_unused]] const bool SHUTDOWN_CHILD = [] {
+    const char* directory = std::getenv(SHUTDOWN_DIRECTORY_ENV);
+    if (directory == nullptr) {
+        return false;
+    }
+    Logger& logger = Logger::GetInstance();
+    logger.SetTimestamp(std::chrono::system_clock::time_point{});
+    logger.SetLogDirectory(directory);
+    for (int i = 0; i < 200'000; ++i) {
+        LOG(i);
+    }
+    LOG("last record "sv, 1.5, ' ', true);
+    std::exit(EXIT_SUCCESS);
+}();
+
+struct Point {
+    int x = 0;
+    int y = 0;
+};
+
+std::ostream& operator<<(std::ostream& out, const Point& point) {
+    return out << '(' << point.x << ", "sv << point.y << ')';
+}
+
+// Местное время в полдень или в указанное время заданного дня
+std::chrono::system_clock::time_point MakeTime(int year, int month, int day, int hour = 12,
+                                               int minute = 0, int second = 0) {
+    std::tm tm{};
+    tm.tm_year = year - 1900;
+    tm.tm_mon = month - 1;
+    tm.tm_mday = day;
+    tm.tm_hour = hour;
+    tm.tm_min = minute;
+    tm.tm_sec = second;
+    tm.tm_isdst = -1;
+    return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+}
+
+std::string FormatTime(std::chrono::system_clock::time_point time) {
+    const auto t = std::chrono::system_clock::to_time_t(time);
+    std::tm tm;
+    localtime_r(&t, &tm);
+    std::ostringstream out;
+    out << std::put_time(&tm, "%F %T");
+    return out.str();
+}
+
+template <typename... Ts>
+std::string ToOstream(const Ts&... args) {
+    std::ostringstream out;
+    ((out << args), ...);
+    return out.str();
+}
+
+std::string ReadFile(const fs::path& path) {
+    std::ifstream input{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+}
+
+std::vector<std::string> ReadLines(const fs::path& path) {
+    std::ifstream input{path, std::ios::binary};
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(input, line);) {
+        lines.push_back(std::move(line));
+    }
+    return lines;
+}
+
+// Текст записи без времени
+std::string_view GetMessage(std::string_view line) {
+    const auto pos = line.find(": "sv);
+    return pos == std::string_view::npos ? ""sv : line.substr(pos + 2);
+}
+
+// Каталог журнала теста. Журнал пишет в него с настройками по умолчанию
+// и временем 10 марта 2024 года, 12:00
+struct LogFixture {
+    LogFixture() {
+        static int counter = 0;
+        directory = fs::temp_directory_path()
+                  / ("logger_tests_"s + std::to_string(::getpid()) + "_"s
+                     + std::to_string(counter++));
+        fs::remove_all(directory);
+        fs::create_directories(directory);
+        logger.Flush();
+        logger.SetMode(LogMode::TEXT);
+        logger.SetOverflowPolicy(OverflowPolicy::BLOCK);
+        logger.SetTimestamp(NOON);
+        logger.SetLogDirectory(directory);
+    }
+
+    ~LogFixture() {
+        // Файлы закрываются, когда фоновый поток переходит в другой каталог
+        logger.Flush();
+        logger.SetLogDirectory(fs::temp_directory_path());
+        logger.Flush();
+        fs::remove_all(directory);
+    }
+
+    const std::chrono::system_clock::time_point NOON = MakeTime(2024, 3, 10);
+    const fs::path TEXT_FILE = "sample_log_2024_03_10.log";
+    const fs::path BINARY_FILE = "sample_log_2024_03_10.bin";
+
+    Logger& logger = Logger::GetInstance();
+    fs::path directory;
+};
+
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(Logger_tests, LogFixture)
+
+BOOST_AUTO_TEST_CASE(Flush_writes_records_made_before_it) {
+    LOG("first"sv);
+    logger.Flush();
+    BOOST_TEST(ReadLines(directory / TEXT_FILE)
+               == std::vector{FormatTime(NOON) + ": first"s}, boost::test_tools::per_element());
+
+    LOG("second "sv, 2);
+    logger.Flush();
+    const auto lines = ReadLines(directory / TEXT_FILE);
+    BOOST_REQUIRE(lines.size() == 2u);
+    BOOST_TEST(lines[1] == FormatTime(NOON) + ": second 2"s);
+}
+
+BOOST_AUTO_TEST_CASE(Text_output_matches_ostream_for_every_argument_type) {
+    const char const_array[] = "const array";
+    char mutable_array[] = "mutable array";
+    const char* pointer = "pointer";
+    const std::string string = "string";
+    const short int16 = -12345;
+    const unsigned short uint16 = 65535;
+    const long long int64 = std::numeric_limits<long long>::min();
+    const unsigned long long uint64 = std::numeric_limits<unsigned long long>::max();
+
+    // BOOL, CHAR, INT16..UINT64, FLOAT, DOUBLE, STRING и LITERAL, а также тип с operator<<
+    const auto expected = {
+        ToOstream(true, ' ', false),
+        ToOstream('x', static_cast<signed char>('y'), static_cast<unsigned char>('z')),
+        ToOstream(int16, ' ', -7, ' ', -7L, ' ', int64),
+        ToOstream(uint16, ' ', 4'000'000'000u, ' ', 7UL, ' ', uint64),
+        ToOstream(3.14159f, ' ', 1e-7f, ' ', 123456789.0f, ' ', -0.0f),
+        ToOstream(2.718281828, ' ', 1e20, ' ', 0.1, ' ', -1.5L, ' ',
+                  std::numeric_limits<double>::infinity()),
+        ToOstream(string, ' ', "view"sv, ' ', pointer, ' ', mutable_array, ' ', const_array),
+        ToOstream("literal", ' ', Point{1, -2}),
+    };
+
+    LOG(true, ' ', false);
+    LOG('x', static_cast<signed char>('y'), static_cast<unsigned char>('z'));
+    LOG(int16, ' ', -7, ' ', -7L, ' ', int64);
+    LOG(uint16, ' ', 4'000'000'000u, ' ', 7UL, ' ', uint64);
+    LOG(3.14159f, ' ', 1e-7f, ' ', 123456789.0f, ' ', -0.0f);
+    LOG(2.718281828, ' ', 1e20, ' ', 0.1, ' ', -1.5L, ' ', std::numeric_limits<double>::infinity());
+    LOG(string, ' ', "view"sv, ' ', pointer, ' ', mutable_array, ' ', const_array);
+    LOG(LOG_LITERAL("literal"), ' ', Point{1, -2});
+    logger.Flush();
+
+    const auto lines = ReadLines(directory / TEXT_FILE);
+    BOOST_REQUIRE(lines.size() == expected.size());
+    size_t i = 0;
+    for (const auto& message : expected) {
+        BOOST_TEST(lines[i++] == FormatTime(NOON) + ": "s + message);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Binary_log_decodes_to_the_text_log) {
+    const auto log_all = [](int i) {
+        const std::string name = "record #"s + std::to_string(i);
+        LOG(LOG_LITERAL("Binary "), name, ' ', i, ' ', i * 0.5, ' ', i % 2 == 0, ' ', "done"sv);
+        LOG(static_cast<short>(-i), ' ', static_cast<unsigned long long>(i) << 40, ' ', 1.25f,
+            ' ', Point{i, i});
+    };
+
+    for (int i = 0; i < 100; ++i) {
+        log_all(i);
+    }
+    logger.Flush();
+    logger.SetMode(LogMode::BINARY);
+    for (int i = 0; i < 100; ++i) {
+        log_all(i);
+    }
+    logger.Flush();
+
+    const std::string binary = ReadFile(directory / BINARY_FILE);
+    BOOST_REQUIRE(binary.starts_with(log_detail::BINARY_MAGIC));
+    std::ostringstream decoded;
+    log_detail::BinaryLogDecoder{decoded}.Decode(binary);
+    BOOST_TEST(decoded.str() == ReadFile(directory / TEXT_FILE));
+}
+
+BOOST_AUTO_TEST_CASE(Char_arrays_on_the_stack_are_stored_by_value) {
+    // Массив на стеке каждый раз лежит по одному адресу, но содержит другой текст
+    const auto log_digit = [](int i) {
+        const char digit[] = {static_cast<char>('0' + i), '\0'};
+        LOG("digit=", digit);
+    };
+    const auto expected = [&] {
+        std::string text;
+        for (int i = 0; i < 5; ++i) {
+            text += FormatTime(NOON) + ": digit="s + std::to_string(i) + '\n';
+        }
+        return text;
+    }();
+
+    for (int i = 0; i < 5; ++i) {
+        log_digit(i);
+    }
+    logger.Flush();
+    BOOST_TEST(ReadFile(directory / TEXT_FILE) == expected);
+
+    logger.SetMode(LogMode::BINARY);
+    for (int i = 0; i < 5; ++i) {
+        log_digit(i);
+    }
+    logger.Flush();
+    std::ostringstream decoded;
+    log_detail::BinaryLogDecoder{decoded}.Decode(ReadFile(directory / BINARY_FILE));
+    BOOST_TEST(decoded.str() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(Literal_text_is_written_to_the_binary_log_once) {
+    static constexpr char ARRAY[] = "static array";
+    logger.SetMode(LogMode::BINARY);
+    for (int i = 0; i < 100; ++i) {
+        LOG(LOG_LITERAL("unique literal text"), i, ' ', log_detail::Literal{ARRAY});
+    }
+    logger.Flush();
+
+    const std::string binary = ReadFile(directory / BINARY_FILE);
+    const auto count = [&binary](std::string_view text) {
+        size_t result = 0;
+        for (auto pos = binary.find(text); pos != std::string::npos;
+             pos = binary.find(text, pos + 1)) {
+            ++result;
+        }
+        return result;
+    };
+    BOOST_TEST(count("unique literal text"sv) == 1u);
+    BOOST_TEST(count("static array"sv) == 1u);
+
+    std::ostringstream decoded;
+    log_detail::BinaryLogDecoder{decoded}.Decode(binary);
+    BOOST_TEST(decoded.str().find(": unique literal text99 static array\n"sv) != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(Decoder_rejects_too_large_definition_numbers) {
+    std::string binary{log_detail::BINARY_MAGIC};
+    binary += static_cast<char>(log_detail::EntryKind::LITERAL);
+    const uint32_t id = std::numeric_limits<uint32_t>::max();
+    const uint32_t size = 1;
+    binary.append(reinterpret_cast<const char*>(&id), sizeof(id));
+    binary.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    binary += 'x';
+
+    std::ostringstream decoded;
+    BOOST_CHECK_THROW(log_detail::BinaryLogDecoder{decoded}.Decode(binary), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(Records_of_each_thread_keep_their_order) {
+    constexpr int THREAD_COUNT = 4;
+    constexpr int RECORD_COUNT = 20'000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < RECORD_COUNT; ++i) {
+                LOG("thread "sv, t, " record "sv, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    logger.Flush();
+
+    std::vector<int> next(THREAD_COUNT, 0);
+    size_t out_of_order = 0;
+    for (const auto& line : ReadLines(directory / TEXT_FILE)) {
+        int t = -1;
+        int i = -1;
+        if (std::sscanf(std::string{GetMessage(line)}.c_str(), "thread %d record %d", &t, &i) != 2
+            || t < 0 || t >= THREAD_COUNT) {
+            ++out_of_order;
+            continue;
+        }
+        out_of_order += i != next[t]++;
+    }
+    BOOST_TEST(out_of_order == 0u);
+    BOOST_TEST(next == std::vector<int>(THREAD_COUNT, RECORD_COUNT),
+               boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(BLOCK_keeps_all_records_including_ones_larger_than_the_ring) {
+    const std::string chunk(200 * 1024, 'a');
+    const std::string huge(600 * 1024, 'h');
+    const uint64_t dropped_before = logger.GetDroppedCount();
+    for (int i = 0; i < 50; ++i) {
+        LOG(i, ' ', chunk);
+        if (i % 10 == 0) {
+            LOG(i, ' ', huge);
+        }
+    }
+    logger.Flush();
+
+    const auto lines = ReadLines(directory / TEXT_FILE);
+    BOOST_REQUIRE(lines.size() == 55u);
+    size_t line = 0;
+    for (int i = 0; i < 50; ++i) {
+        BOOST_TEST(GetMessage(lines[line++]) == std::to_string(i) + ' ' + chunk);
+        if (i % 10 == 0) {
+            BOOST_TEST(GetMessage(lines[line++]) == std::to_string(i) + ' ' + huge);
+        }
+    }
+    BOOST_TEST(logger.GetDroppedCount() == dropped_before);
+}
+
+BOOST_AUTO_TEST_CASE(DROP_counts_and_reports_dropped_records) {
+    // Фоновый поток не может открыть канал без читателя, поэтому буфер потока переполняется
+    const auto fifo = directory / TEXT_FILE;
+    BOOST_REQUIRE(::mkfifo(fifo.c_str(), 0600) == 0);
+    logger.SetOverflowPolicy(OverflowPolicy::DROP);
+    const uint64_t dropped_before = logger.GetDroppedCount();
+
+    constexpr int RECORD_COUNT = 100;
+    const std::string chunk(100 * 1024, 'd');
+    for (int i = 0; i < RECORD_COUNT; ++i) {
+        LOG(i, ' ', chunk);
+    }
+    // Запись больше половины буфера тоже отбрасывается только при нехватке места
+    LOG("huge "sv, std::string(600 * 1024, 'h'));
+
+    std::string content;
+    std::thread reader{[&content, &fifo] {
+        content = ReadFile(fifo);
+    }};
+    logger.Flush();
+    // Смена каталога закрывает канал, и читатель получает конец файла
+    logger.SetLogDirectory(fs::temp_directory_path());
+    logger.Flush();
+    reader.join();
+
+    uint64_t reported = 0;
+    int previous = -1;
+    size_t records = 0;
+    size_t out_of_order = 0;
+    std::istringstream lines{content};
+    for (std::string line; std::getline(lines, line);) {
+        const auto message = GetMessage(line);
+        if (message.starts_with("Dropped "sv)) {
+            reported += std::stoull(std::string{message.substr(8)});
+        } else if (message.starts_with("huge "sv)) {
+            ++records;
+        } else {
+            const int i = std::stoi(std::string{message});
+            out_of_order += i <= previous;
+            previous = i;
+            ++records;
+        }
+    }
+    BOOST_TEST(out_of_order == 0u);
+    BOOST_TEST(reported > 0u);
+    BOOST_TEST(reported == logger.GetDroppedCount() - dropped_before);
+    BOOST_TEST(records + reported == RECORD_COUNT + 1u);
+}
+
+BOOST_AUTO_TEST_CASE(Day_change_switches_to_the_next_file) {
+    logger.SetTimestamp(MakeTime(2024, 3, 10, 23, 59, 59));
+    LOG("before midnight"sv);
+    logger.SetTimestamp(MakeTime(2024, 3, 11, 0, 0, 1));
+    LOG("after midnight"sv);
+    logger.Flush();
+
+    const auto first_day = ReadLines(directory / TEXT_FILE);
+    const auto second_day = ReadLines(directory / "sample_log_2024_03_11.log");
+    BOOST_REQUIRE(first_day.size() == 1u);
+    BOOST_REQUIRE(second_day.size() == 1u);
+    BOOST_TEST(first_day[0] == "2024-03-10 23:59:59: before midnight"s);
+    BOOST_TEST(second_day[0] == "2024-03-11 00:00:01: after midnight"s);
+}
+
+BOOST_AUTO_TEST_CASE(Records_with_a_new_format_survive_shutdown) {
+    const std::string env = SHUTDOWN_DIRECTORY_ENV + "="s + directory.string();
+    std::vector<char*> child_environ{const_cast<char*>(env.c_str())};
+    for (char** var = environ; *var != nullptr; ++var) {
+        child_environ.push_back(*var);
+    }
+    child_environ.push_back(nullptr);
+    char program[] = "/proc/self/exe";
+    char* argv[] = {program, nullptr};
+
+    pid_t pid;
+    BOOST_REQUIRE(posix_spawn(&pid, program, nullptr, nullptr, argv, child_environ.data()) == 0);
+    int status = 0;
+    BOOST_REQUIRE(waitpid(pid, &status, 0) == pid);
+    BOOST_TEST(WIFEXITED(status));
+    BOOST_TEST(WEXITSTATUS(status) == EXIT_SUCCESS);
+
+    std::vector<std::string> lines;
+    for (const auto& entry : fs::directory_iterator{directory}) {
+        lines = ReadLines(entry.path());
+    }
+    BOOST_REQUIRE(lines.size() == 200'001u);
+    BOOST_TEST(GetMessage(lines[199'999]) == "199999"sv);
+    BOOST_TEST(GetMessage(lines.back()) == "last record 1.5 1"sv);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,51 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../log_decoder.h"
+
+/*
+ * Переводит двоичный журнал (LogMode::BINARY) в текстовый.
+ * Использование: log_decoder <sample_log_YYYY_MM_DD.bin> [<output.log>]
+ * Без второго аргумента текст выводится в стандартный вывод.
+ */
+
+using namespace std::literals;
+
+int main(int argc, const char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: log_decoder <binary log> [<text log>]"sv << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream input{argv[1], std::ios::binary};
+    if (!input) {
+        std::cerr << "Failed to open "sv << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string data{std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+    if (!data.starts_with(log_detail::BINARY_MAGIC)) {
+        std::cerr << argv[1] << " is not a binary log"sv << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream file;
+    if (argc == 3) {
+        file.open(argv[2], std::ios::binary);
+        if (!file) {
+            std::cerr << "Failed to open "sv << argv[2] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    try {
+        log_detail::BinaryLogDecoder{argc == 3 ? file : std::cout}.Decode(data);
+    } catch (const std::exception& e) {
+        std::cerr << argv[1] << ": "sv << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "../src/loot_generator.h"
+
+/*
+ * Измеряет время вызова LootGenerator::Generate для 10000 карт за один тик игры.
+ * Сравнивает текущую реализацию с прежней, вызывавшей std::pow на каждый Generate.
+ * Оба варианта получают генератор случайных чисел через std::function.
+ */
+
+using namespace std::literals;
+
+namespace {
+
+constexpr size_t MAP_COUNT = 10'000;
+constexpr int TICK_COUNT = 1'000;
+constexpr loot_gen::LootGenerator::TimeInterval TICK = 50ms;
+
+// Линейный конгруэнтный генератор: дешёвый и одинаковый для обоих вариантов
+struct FastRandom {
+    double operator()() noexcept {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<double>(state >> 11) * 0x1.0p-53;
+    }
+    uint64_t state = 1;
+};
+
+// Прежняя реализация LootGenerator::Generate: точка отсчёта для сравнения
+class PowLootGenerator {
+public:
+    using RandomGenerator = loot_gen::LootGenerator::RandomGenerator;
+    using TimeInterval = loot_gen::LootGenerator::TimeInterval;
+
+    PowLootGenerator(TimeInterval base_interval, double probability, RandomGenerator random_gen)
+        : base_interval_{base_interval}
+        , probability_{probability}
+        , random_generator_{std::move(random_gen)} {
+    }
+
+    unsigned Generate(TimeInterval time_delta, unsigned loot_count, unsigned looter_count) {
+        time_without_loot_ += time_delta;
+        const unsigned loot_shortage = loot_count > looter_count ? 0u : looter_count - loot_count;
+        const double ratio = std::chrono::duration<double>{time_without_loot_} / base_interval_;
+        const double probability = std::clamp(
+            (1.0 - std::pow(1.0 - probability_, ratio)) * random_generator_(), 0.0, 1.0);
+        const unsigned generated_loot = static_cast<unsigned>(std::round(loot_shortage * probability));
+        if (generated_loot > 0) {
+            time_without_loot_ = {};
+        }
+        return generated_loot;
+    }
+
+private:
+    TimeInterval base_interval_;
+    double probability_;
+    TimeInterval time_without_loot_{};
+    RandomGenerator random_generator_;
+};
+
+template <typename Generator>
+void RunBenchmark(std::string_view name) {
+    std::vector<Generator> generators;
+    generators.reserve(MAP_COUNT);
+    for (size_t i = 0; i < MAP_COUNT; ++i) {
+        generators.emplace_back(5s, 0.5, FastRandom{i + 1});
+    }
+
+    unsigned total_loot = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < TICK_COUNT; ++tick) {
+        for (auto& generator : generators) {
+            total_loot += generator.Generate(TICK, tick % 4, 4);
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const double ns_per_call = elapsed.count() * 1e9 / (MAP_COUNT * TICK_COUNT);
+    const double us_per_tick = elapsed.count() * 1e6 / TICK_COUNT;
+    std::cout << name << ": "sv << ns_per_call << " ns/call, "sv << us_per_tick << " us/tick"sv
+              << " (loot: "sv << total_loot << ')' << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    RunBenchmark<PowLootGenerator>("std::pow (before)"sv);
+    RunBenchmark<loot_gen::LootGenerator>("log1p/expm1 (LootGenerator)"sv);
+}
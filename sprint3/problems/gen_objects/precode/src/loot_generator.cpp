@@ -5,13 +5,21 @@
 
 namespace loot_gen {
 
+LootGenerator::LootGenerator(TimeInterval base_interval, double probability,
+                             RandomGenerator random_gen)
+    : base_interval_{base_interval}
+    , log_no_loot_probability_{std::log1p(-probability)}
+    , random_generator_{std::move(random_gen)} {
+}
+
 unsigned LootGenerator::Generate(TimeInterval time_delta, unsigned loot_count,
                                  unsigned looter_count) {
     time_without_loot_ += time_delta;
     const unsigned loot_shortage = loot_count > looter_count ? 0u : looter_count - loot_count;
     const double ratio = std::chrono::duration<double>{time_without_loot_} / base_interval_;
-    const double probability
-        = std::clamp((1.0 - std::pow(1.0 - probability_, ratio)) * random_generator_(), 0.0, 1.0);
+    // 1 - exp(x) == -expm1(x). При ratio == 0 трофей не успевает появиться
+    const double loot_probability = ratio > 0 ? -std::expm1(ratio * log_no_loot_probability_) : 0.0;
+    const double probability = std::clamp(loot_probability * random_generator_(), 0.0, 1.0);
     const unsigned generated_loot = static_cast<unsigned>(std::round(loot_shortage * probability));
     if (generated_loot > 0) {
         time_without_loot_ = {};
@@ -18,11 +18,7 @@ public:
      * random_generator - генератор псевдослучайных чисел в диапазоне от [0 до 1]
      */
     LootGenerator(TimeInterval base_interval, double probability,
-                  RandomGenerator random_gen = DefaultGenerator)
-        : base_interval_{base_interval}
-        , probability_{probability}
-        , random_generator_{std::move(random_gen)} {
-    }
+                  RandomGenerator random_gen = DefaultGenerator);
 
     /*
      * Возвращает количество трофеев, которые должны появиться на карте спустя
@@ -40,7 +36,9 @@ private:
         return 1.0;
     };
     TimeInterval base_interval_;
-    double probability_;
+    // log(1 - probability): вероятность (1 - probability)^ratio вычисляется как
+    // exp(ratio * log(1 - probability)) без вызова std::pow на каждый Generate
+    double log_no_loot_probability_;
     TimeInterval time_without_loot_{};
     RandomGenerator random_generator_;
 };
@@ -0,0 +1,107 @@
+#include "loot_spawner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace loot_gen {
+
+namespace {
+
+constexpr uint32_t PHILOX_M0 = 0xD2511F53;
+constexpr uint32_t PHILOX_M1 = 0xCD9E8D57;
+constexpr uint32_t PHILOX_W0 = 0x9E3779B9;
+constexpr uint32_t PHILOX_W1 = 0xBB67AE85;
+constexpr int PHILOX_ROUNDS = 10;
+
+// Возвращает старшую и младшую половины произведения a * b
+inline void MulHiLo(uint32_t a, uint32_t b, uint32_t& hi, uint32_t& lo) noexcept {
+    const uint64_t product = static_cast<uint64_t>(a) * b;
+    hi = static_cast<uint32_t>(product >> 32);
+    lo = static_cast<uint32_t>(product);
+}
+
+// Равномерно распределённое число в диапазоне [0, 1) из 53 случайных бит
+inline double ToUnitInterval(uint32_t hi, uint32_t lo) noexcept {
+    const uint64_t bits = ((static_cast<uint64_t>(hi) << 32) | lo) >> 11;
+    return static_cast<double>(bits) * 0x1.0p-53;
+}
+
+// Равномерно распределённое число в диапазоне [0, bound) без деления
+inline unsigned ToBounded(uint32_t value, unsigned bound) noexcept {
+    return static_cast<unsigned>((static_cast<uint64_t>(value) * bound) >> 32);
+}
+
+double RoadLength(const RoadSegment& road) noexcept {
+    return std::hypot(road.x1 - road.x0, road.y1 - road.y0);
+}
+
+}  // namespace
+
+Philox4x32::Counter Philox4x32::operator()(Counter counter) const noexcept {
+    Key key = key_;
+    for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+        uint32_t hi0, lo0, hi1, lo1;
+        MulHiLo(PHILOX_M0, counter[0], hi0, lo0);
+        MulHiLo(PHILOX_M1, counter[2], hi1, lo1);
+        counter = {hi1 ^ counter[1] ^ key[0], lo1, hi0 ^ counter[3] ^ key[1], lo0};
+        key[0] += PHILOX_W0;
+        key[1] += PHILOX_W1;
+    }
+    return counter;
+}
+
+LootSpawner::LootSpawner(std::span<const RoadSegment> roads, unsigned loot_type_count,
+                         uint64_t seed)
+    : roads_(roads.begin(), roads.end())
+    , loot_type_count_{loot_type_count}
+    , rng_{seed} {
+    if (roads_.empty()) {
+        throw std::invalid_argument("Map must have at least one road to spawn loot");
+    }
+    if (loot_type_count_ == 0) {
+        throw std::invalid_argument("Map must have at least one loot type to spawn loot");
+    }
+
+    cumulative_length_.reserve(roads_.size());
+    double total_length = 0;
+    for (const auto& road : roads_) {
+        total_length += RoadLength(road);
+        cumulative_length_.push_back(total_length);
+    }
+}
+
+void LootSpawner::Spawn(unsigned count, LootArrays& loot) {
+    const size_t first = loot.Size();
+    loot.x.resize(first + count);
+    loot.y.resize(first + count);
+    loot.type.resize(first + count);
+
+    const double total_length = GetTotalRoadLength();
+    const size_t last_road = roads_.size() - 1;
+
+    // Итерации цикла не зависят друг от друга: i-й трофей определяется только
+    // значением счётчика counter_ + i
+    for (unsigned i = 0; i < count; ++i) {
+        const uint64_t n = counter_ + i;
+        const auto random = rng_({static_cast<uint32_t>(n), static_cast<uint32_t>(n >> 32), 0, 0});
+
+        const double distance = ToUnitInterval(random[0], random[1]) * total_length;
+        const size_t road_index = std::min<size_t>(
+            std::upper_bound(cumulative_length_.begin(), cumulative_length_.end(), distance)
+                - cumulative_length_.begin(),
+            last_road);
+        const RoadSegment& road = roads_[road_index];
+        const double road_start = road_index == 0 ? 0.0 : cumulative_length_[road_index - 1];
+        const double road_length = cumulative_length_[road_index] - road_start;
+        const double t
+            = road_length > 0 ? std::clamp((distance - road_start) / road_length, 0.0, 1.0) : 0.0;
+
+        loot.x[first + i] = road.x0 + (road.x1 - road.x0) * t;
+        loot.y[first + i] = road.y0 + (road.y1 - road.y0) * t;
+        loot.type[first + i] = ToBounded(random[2], loot_type_count_);
+    }
+    counter_ += count;
+}
+
+}  // namespace loot_gen
@@ -0,0 +1,98 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace loot_gen {
+
+/*
+ * Счётчиковый генератор псевдослучайных чисел Philox4x32-10.
+ * Результат зависит только от ключа (seed) и значения счётчика, поэтому
+ * i-е случайное число можно получить без вычисления предыдущих.
+ * Это позволяет генерировать трофеи параллельно и воспроизводить их по seed.
+ */
+class Philox4x32 {
+public:
+    using Counter = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    explicit Philox4x32(uint64_t seed) noexcept
+        : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)} {
+    }
+
+    Counter operator()(Counter counter) const noexcept;
+
+private:
+    Key key_;
+};
+
+/*
+ * Дорога, на которой может появиться трофей. Задаётся начальной и конечной точками.
+ */
+struct RoadSegment {
+    double x0 = 0;
+    double y0 = 0;
+    double x1 = 0;
+    double y1 = 0;
+};
+
+/*
+ * Массивы трофеев игрового сеанса (структура массивов).
+ * i-й трофей имеет координаты (x[i], y[i]) и тип type[i].
+ */
+struct LootArrays {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<unsigned> type;
+
+    size_t Size() const noexcept {
+        return type.size();
+    }
+};
+
+/*
+ *  Размещает пачку трофеев в случайных точках дорог карты за один проход.
+ *  Точка выбирается равномерно по суммарной длине дорог: длинная дорога получает
+ *  пропорционально больше трофеев, чем короткая.
+ */
+class LootSpawner {
+public:
+    /*
+     * roads - дороги карты (не пустой список)
+     * loot_type_count - количество типов трофеев на карте (> 0)
+     * seed - начальное значение генератора
+     */
+    LootSpawner(std::span<const RoadSegment> roads, unsigned loot_type_count, uint64_t seed);
+
+    /*
+     * Добавляет count трофеев в конец массивов loot.
+     * Каждый трофей вычисляется независимо от остальных по номеру в последовательности,
+     * поэтому при одинаковых seed и счётчике результат всегда одинаков.
+     */
+    void Spawn(unsigned count, LootArrays& loot);
+
+    // Номер следующего трофея в последовательности. Позволяет сохранить и восстановить
+    // состояние генератора.
+    uint64_t GetCounter() const noexcept {
+        return counter_;
+    }
+
+    void SetCounter(uint64_t counter) noexcept {
+        counter_ = counter;
+    }
+
+    double GetTotalRoadLength() const noexcept {
+        return cumulative_length_.back();
+    }
+
+private:
+    std::vector<RoadSegment> roads_;
+    // cumulative_length_[i] - суммарная длина дорог [0, i]
+    std::vector<double> cumulative_length_;
+    unsigned loot_type_count_;
+    Philox4x32 rng_;
+    uint64_t counter_ = 0;
+};
+
+}  // namespace loot_gen
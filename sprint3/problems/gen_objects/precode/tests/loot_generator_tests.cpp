@@ -71,4 +71,14 @@ SCENARIO("Loot generation") {
             }
         }
     }
+
+    GIVEN("a loot generator with probability 1") {
+        LootGenerator gen{1s, 1.0};
+
+        WHEN("no time has passed") {
+            THEN("no loot is generated") {
+                CHECK(gen.Generate(0ms, 0, 4) == 0);
+            }
+        }
+    }
 }
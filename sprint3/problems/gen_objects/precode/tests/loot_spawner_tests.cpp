@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/loot_spawner.h"
+
+SCENARIO("Philox random number generator") {
+    using loot_gen::Philox4x32;
+
+    GIVEN("a zero key") {
+        const Philox4x32 rng{0};
+        THEN("it matches the reference implementation") {
+            const Philox4x32::Counter expected{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+            CHECK(rng({0, 0, 0, 0}) == expected);
+        }
+    }
+
+    GIVEN("a key with all bits set") {
+        const Philox4x32 rng{~uint64_t{0}};
+        THEN("it matches the reference implementation") {
+            const Philox4x32::Counter expected{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd};
+            CHECK(rng({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}) == expected);
+        }
+    }
+}
+
+SCENARIO("Bulk loot spawning") {
+    using loot_gen::LootArrays;
+    using loot_gen::LootSpawner;
+    using loot_gen::RoadSegment;
+
+    GIVEN("a map with a short and a long road") {
+        const std::vector<RoadSegment> roads{
+            {0, 0, 10, 0},
+            {0, 0, 0, 30},
+        };
+        constexpr unsigned LOOT_TYPES = 3;
+
+        WHEN("many loot items are spawned") {
+            LootSpawner spawner{roads, LOOT_TYPES, 42};
+            LootArrays loot;
+            constexpr unsigned COUNT = 40000;
+            spawner.Spawn(COUNT, loot);
+
+            THEN("every item lies on a road and has a valid type") {
+                REQUIRE(loot.Size() == COUNT);
+                REQUIRE(loot.x.size() == COUNT);
+                REQUIRE(loot.y.size() == COUNT);
+                for (size_t i = 0; i < COUNT; ++i) {
+                    INFO("item " << i << ": (" << loot.x[i] << ", " << loot.y[i] << ")");
+                    const bool on_horizontal = loot.y[i] == 0 && loot.x[i] >= 0 && loot.x[i] <= 10;
+                    const bool on_vertical = loot.x[i] == 0 && loot.y[i] >= 0 && loot.y[i] <= 30;
+                    REQUIRE((on_horizontal || on_vertical));
+                    REQUIRE(loot.type[i] < LOOT_TYPES);
+                }
+            }
+
+            THEN("items are distributed proportionally to road length") {
+                unsigned on_long_road = 0;
+                for (size_t i = 0; i < COUNT; ++i) {
+                    on_long_road += loot.y[i] > 0 ? 1 : 0;
+                }
+                const double share = static_cast<double>(on_long_road) / COUNT;
+                CHECK(share > 0.73);
+                CHECK(share < 0.77);
+            }
+
+            THEN("the counter advances by the number of items") {
+                CHECK(spawner.GetCounter() == COUNT);
+            }
+        }
+
+        WHEN("two spawners share a seed") {
+            LootSpawner first{roads, LOOT_TYPES, 7};
+            LootSpawner second{roads, LOOT_TYPES, 7};
+
+            THEN("spawning in one batch or in several batches gives the same loot") {
+                LootArrays one_batch;
+                first.Spawn(100, one_batch);
+
+                LootArrays many_batches;
+                second.Spawn(30, many_batches);
+                second.Spawn(70, many_batches);
+
+                CHECK(one_batch.x == many_batches.x);
+                CHECK(one_batch.y == many_batches.y);
+                CHECK(one_batch.type == many_batches.type);
+            }
+
+            THEN("restoring the counter reproduces the loot") {
+                LootArrays expected;
+                first.Spawn(10, expected);
+                first.Spawn(10, expected);
+
+                LootArrays restored;
+                second.SetCounter(10);
+                second.Spawn(10, restored);
+
+                CHECK(std::equal(restored.x.begin(), restored.x.end(), expected.x.begin() + 10));
+                CHECK(std::equal(restored.type.begin(), restored.type.end(),
+                                 expected.type.begin() + 10));
+            }
+        }
+    }
+
+    GIVEN("invalid map parameters") {
+        THEN("spawner can't be constructed") {
+            CHECK_THROWS_AS((LootSpawner{{}, 1, 0}), std::invalid_argument);
+            const std::vector<RoadSegment> roads{{0, 0, 1, 0}};
+            CHECK_THROWS_AS((LootSpawner{roads, 0, 0}), std::invalid_argument);
+        }
+    }
+}
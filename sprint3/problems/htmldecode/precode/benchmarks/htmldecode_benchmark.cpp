@@ -0,0 +1,121 @@
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "../src/htmldecode.h"
+
+/*
+ * Измеряет скорость декодирования HTML-документа размером около 8 МБ:
+ * обычной разметки с редкими мнемониками и исходного кода с мнемониками
+ * почти в каждой строке. Сравнивает посимвольное декодирование, которое сверяет
+ * каждую мнемонику через substr, с HtmlDecode, HtmlDecodeInPlace,
+ * HtmlDecodeTo с std::back_inserter и потоковым HtmlDecoder с частями по 64 КБ.
+ */
+
+using namespace std::literals;
+
+namespace {
+
+constexpr size_t DOCUMENT_SIZE = 8 << 20;
+constexpr int ROUNDS = 10;
+
+std::string NaiveHtmlDecode(std::string_view str) {
+    static constexpr std::pair<std::string_view, char> MNEMONICS[] = {
+        {"lt"sv, '<'}, {"gt"sv, '>'}, {"amp"sv, '&'}, {"apos"sv, '\''}, {"quot"sv, '"'},
+        {"LT"sv, '<'}, {"GT"sv, '>'}, {"AMP"sv, '&'}, {"APOS"sv, '\''}, {"QUOT"sv, '"'},
+    };
+    std::string result;
+    size_t i = 0;
+    while (i < str.size()) {
+        bool decoded = false;
+        if (str[i] == '&') {
+            for (const auto& [name, value] : MNEMONICS) {
+                if (str.substr(i + 1, name.size()) == name) {
+                    result += value;
+                    i += 1 + name.size();
+                    if (i < str.size() && str[i] == ';') {
+                        ++i;
+                    }
+                    decoded = true;
+                    break;
+                }
+            }
+        }
+        if (!decoded) {
+            result += str[i++];
+        }
+    }
+    return result;
+}
+
+std::string MakeDocument(std::string_view fragment) {
+    std::string document;
+    document.reserve(DOCUMENT_SIZE + fragment.size());
+    while (document.size() < DOCUMENT_SIZE) {
+        document += fragment;
+    }
+    return document;
+}
+
+template <typename Decode>
+void Report(std::string_view name, const std::string& document, Decode&& decode) {
+    size_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        checksum += decode(document);
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  "sv << name << ": "sv
+              << static_cast<double>(document.size()) * ROUNDS / seconds / (1 << 20)
+              << " MiB/s (checksum "sv << checksum << ")"sv << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    const std::pair<std::string_view, std::string> documents[] = {
+        {"markup"sv,
+         MakeDocument(
+             "<div class=\"post\"><h2>Tom &amp; Jerry</h2><p>Lorem ipsum dolor sit amet, "
+             "consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore "
+             "magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco.</p>"
+             "<a href=\"/posts?id=1&page=2\">Read more</a></div>\n"sv)},
+        {"escaped source code"sv,
+         MakeDocument("<pre>if (a &lt; b &amp;&amp; c &gt;= d) { s = &quot;it&apos;s&quot;; }\n"
+                      "for (int i = 0; i &LT; n; ++i) v[i] &AMP;= mask;</pre>\n"sv)},
+    };
+
+    for (const auto& [name, document] : documents) {
+        std::cout << name << ", "sv << document.size() << " bytes:"sv << std::endl;
+        Report("naive loop"sv, document, [](const std::string& str) {
+            return NaiveHtmlDecode(str).size();
+        });
+        Report("HtmlDecode"sv, document, [](const std::string& str) {
+            return HtmlDecode(str).size();
+        });
+        std::string in_place;
+        Report("HtmlDecodeInPlace (with copy)"sv, document, [&in_place](const std::string& str) {
+            in_place = str;
+            HtmlDecodeInPlace(in_place);
+            return in_place.size();
+        });
+        Report("HtmlDecodeTo, back_inserter"sv, document, [](const std::string& str) {
+            std::string result;
+            HtmlDecodeTo(str, std::back_inserter(result));
+            return result.size();
+        });
+        Report("HtmlDecoder, 64 KiB chunks"sv, document, [](const std::string& str) {
+            constexpr size_t CHUNK_SIZE = 64 << 10;
+            HtmlDecoder decoder;
+            std::string result;
+            for (size_t pos = 0; pos < str.size(); pos += CHUNK_SIZE) {
+                decoder.Decode(std::string_view{str}.substr(pos, CHUNK_SIZE), result);
+            }
+            decoder.Finish(result);
+            return result.size();
+        });
+    }
+}
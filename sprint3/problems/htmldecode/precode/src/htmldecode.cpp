@@ -1,6 +1,76 @@
 #include "htmldecode.h"
 
+#include <algorithm>
+
+using namespace html_detail;
+
 std::string HtmlDecode(std::string_view str) {
-    //    
-    return {str.begin(), str.end()};
+    //     ,     
+    std::string result(str.size(), '\0');
+    result.resize(static_cast<size_t>(HtmlDecodeTo(str, result.data()) - result.data()));
+    return result;
+}
+
+void HtmlDecodeInPlace(std::string& str) {
+    str.resize(static_cast<size_t>(HtmlDecodeTo(str, str.data()) - str.data()));
+}
+
+void HtmlDecoder::Decode(std::string_view chunk, std::string& out) {
+    if (pending_size_ != 0) {
+        //       .
+        //   MAX_MNEMONIC_SIZE  ,   
+        std::array<char, MAX_MNEMONIC_SIZE> buffer = pending_;
+        const size_t taken = std::min(chunk.size(), buffer.size() - pending_size_);
+        std::copy_n(chunk.data(), taken, buffer.data() + pending_size_);
+        const size_t size = pending_size_ + taken;
+        const MatchResult match =
+            MatchMnemonic(buffer.data(), buffer.data() + size, /* at_end = */ false);
+        if (match.status == MatchStatus::NEED_MORE) {
+            pending_ = buffer;
+            pending_size_ = size;
+            return;
+        }
+        if (match.status == MatchStatus::MATCHED) {
+            out += match.value;
+            chunk.remove_prefix(match.size - pending_size_);
+        } else {
+            //  '&'     ,    
+            out.append(pending_.data(), pending_size_);
+        }
+        pending_size_ = 0;
+    }
+
+    //       ,    '&':
+    //    ';'    '&'
+    size_t complete_size = chunk.size();
+    const size_t tail_start = chunk.size() - std::min(chunk.size(), MAX_MNEMONIC_SIZE - 1);
+    if (const size_t amp = chunk.rfind('&'); amp != std::string_view::npos && amp >= tail_start) {
+        const char* const end = chunk.data() + chunk.size();
+        if (MatchMnemonic(chunk.data() + amp, end, /* at_end = */ false).status
+            == MatchStatus::NEED_MORE) {
+            complete_size = amp;
+        }
+    }
+
+    const size_t old_size = out.size();
+    out.resize(old_size + complete_size);
+    char* const out_end = HtmlDecodeTo(chunk.substr(0, complete_size), out.data() + old_size);
+    out.resize(static_cast<size_t>(out_end - out.data()));
+
+    pending_size_ = chunk.size() - complete_size;
+    std::copy_n(chunk.data() + complete_size, pending_size_, pending_.data());
+}
+
+void HtmlDecoder::Finish(std::string& out) {
+    if (pending_size_ == 0) {
+        return;
+    }
+    const char* const end = pending_.data() + pending_size_;
+    const MatchResult match = MatchMnemonic(pending_.data(), end, /* at_end = */ true);
+    if (match.status == MatchStatus::MATCHED) {
+        out += match.value;
+    } else {
+        out.append(pending_.data(), pending_size_);
+    }
+    pending_size_ = 0;
 }
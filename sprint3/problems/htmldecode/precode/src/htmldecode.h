@@ -1,6 +1,12 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 /*
  * Декодирует основные HTML-мнемоники:
@@ -18,4 +24,179 @@
  * - M&amp;M&APOSs декодируется в M&M's
  * - &amp;lt; декодируется в &lt;
  */
-std::string HtmlDecode(std::string_view str);
\ No newline at end of file
+std::string HtmlDecode(std::string_view str);
+
+/*
+ * Декодирует строку str на месте. Результат не длиннее исходной строки,
+ * поэтому записывается в её же буфер без выделения памяти.
+ */
+void HtmlDecodeInPlace(std::string& str);
+
+namespace html_detail {
+
+struct Mnemonic {
+    std::string_view name;
+    char value;
+};
+
+inline constexpr Mnemonic MNEMONICS[] = {
+    {"lt", '<'}, {"gt", '>'}, {"amp", '&'}, {"apos", '\''}, {"quot", '"'},
+};
+
+// Длина самой длинной мнемоники вместе с '&' и ';'
+inline constexpr size_t MAX_MNEMONIC_SIZE = 6;
+
+/*
+ * Префиксное дерево мнемоник, построенное при компиляции.
+ * Переходы хранятся по номеру буквы в алфавите, нулевой переход означает его отсутствие
+ * (в корень ничего не ведёт). Ни одна мнемоника не является началом другой,
+ * поэтому узлы со значением - всегда листья.
+ */
+struct TrieNode {
+    std::array<uint8_t, 26> next{};
+    char value = 0;
+};
+
+inline constexpr size_t TRIE_SIZE = [] {
+    // Корень и по узлу на каждую букву: с запасом, точный размер не важен
+    size_t size = 1;
+    for (const auto& mnemonic : MNEMONICS) {
+        size += mnemonic.name.size();
+    }
+    return size;
+}();
+
+inline constexpr std::array<TrieNode, TRIE_SIZE> TRIE = [] {
+    std::array<TrieNode, TRIE_SIZE> trie{};
+    size_t size = 1;
+    for (const auto& mnemonic : MNEMONICS) {
+        size_t node = 0;
+        for (const char c : mnemonic.name) {
+            auto& next = trie[node].next[c - 'a'];
+            if (next == 0) {
+                next = static_cast<uint8_t>(size++);
+            }
+            node = next;
+        }
+        trie[node].value = mnemonic.value;
+    }
+    return trie;
+}();
+
+enum class MatchStatus {
+    MATCHED,
+    NOT_MATCHED,
+    // Данных не хватает, чтобы решить: строка оборвалась внутри возможной мнемоники
+    NEED_MORE,
+};
+
+struct MatchResult {
+    MatchStatus status;
+    // Для MATCHED - декодированный символ и длина мнемоники вместе с '&' и ';'
+    char value = 0;
+    size_t size = 0;
+};
+
+/*
+ * Сопоставляет мнемонику, начинающуюся с символа '&' в позиции p.
+ * Если at_end == false, за end могут последовать ещё данные, и при обрыве строки внутри
+ * возможной мнемоники (или перед возможным ';') возвращается NEED_MORE.
+ */
+constexpr MatchResult MatchMnemonic(const char* p, const char* end, bool at_end) noexcept {
+    const char* q = p + 1;
+    if (q == end) {
+        return {at_end ? MatchStatus::NOT_MATCHED : MatchStatus::NEED_MORE};
+    }
+    // Регистр всей мнемоники задаёт её первая буква
+    const char first = (*q >= 'A' && *q <= 'Z') ? 'A' : 'a';
+    size_t node = 0;
+    while (TRIE[node].value == 0) {
+        if (q == end) {
+            return {at_end ? MatchStatus::NOT_MATCHED : MatchStatus::NEED_MORE};
+        }
+        const auto letter = static_cast<unsigned char>(*q - first);
+        if (letter >= 26 || TRIE[node].next[letter] == 0) {
+            return {MatchStatus::NOT_MATCHED};
+        }
+        node = TRIE[node].next[letter];
+        ++q;
+    }
+    if (q == end && !at_end) {
+        return {MatchStatus::NEED_MORE};
+    }
+    if (q != end && *q == ';') {
+        ++q;
+    }
+    return {MatchStatus::MATCHED, TRIE[node].value, static_cast<size_t>(q - p)};
+}
+
+// Копирует [first, last) в out. Для char* допускается перекрытие при out <= first
+template <typename OutputIt>
+OutputIt CopyPlain(const char* first, const char* last, OutputIt out) {
+    if constexpr (std::is_same_v<OutputIt, char*>) {
+        const auto size = static_cast<size_t>(last - first);
+        if (out != first) {
+            std::memmove(out, first, size);
+        }
+        return out + size;
+    } else {
+        return std::copy(first, last, out);
+    }
+}
+
+}  // namespace html_detail
+
+/*
+ * Декодирует строку str за один проход и записывает результат в out.
+ * Символы '&' ищутся через memchr, текст между ними копируется целиком.
+ * Декодированные символы повторно не просматриваются.
+ * Если OutputIt - char*, out может совпадать с началом str.
+ * Возвращает итератор на конец результата.
+ */
+template <typename OutputIt>
+OutputIt HtmlDecodeTo(std::string_view str, OutputIt out) {
+    using namespace html_detail;
+    const char* in = str.data();
+    const char* const end = in + str.size();
+    while (in != end) {
+        const auto* amp = static_cast<const char*>(std::memchr(in, '&', static_cast<size_t>(end - in)));
+        if (!amp) {
+            return CopyPlain(in, end, out);
+        }
+        out = CopyPlain(in, amp, out);
+        const MatchResult match = MatchMnemonic(amp, end, /* at_end = */ true);
+        if (match.status == MatchStatus::MATCHED) {
+            *out++ = match.value;
+            in = amp + match.size;
+        } else {
+            *out++ = '&';
+            in = amp + 1;
+        }
+    }
+    return out;
+}
+
+/*
+ * Потоковый декодер для текста, поступающего частями.
+ * Мнемоника может быть разорвана между частями: её начало запоминается
+ * до следующего вызова Decode.
+ * Пример:
+ *     HtmlDecoder decoder;
+ *     std::string result;
+ *     decoder.Decode("M&am"sv, result);
+ *     decoder.Decode("p;M"sv, result);
+ *     decoder.Finish(result);  // result == "M&M"
+ */
+class HtmlDecoder {
+public:
+    // Дописывает в out декодированную часть chunk
+    void Decode(std::string_view chunk, std::string& out);
+
+    // Дописывает в out остаток, отложенный до следующей части
+    void Finish(std::string& out);
+
+private:
+    // Начало мнемоники, оборванной в конце предыдущей части
+    std::array<char, html_detail::MAX_MNEMONIC_SIZE> pending_{};
+    size_t pending_size_ = 0;
+};
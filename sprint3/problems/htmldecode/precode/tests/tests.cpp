@@ -1,5 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <iterator>
+#include <sstream>
+
 #include "../src/htmldecode.h"
 
 using namespace std::literals;
@@ -9,4 +12,71 @@ TEST_CASE("Text without mnemonics", "[HtmlDecode]") {
     CHECK(HtmlDecode("hello"sv) == "hello"s);
 }
 
-// Напишите недостающие тесты самостоятельно
+TEST_CASE("Text with mnemonics", "[HtmlDecode]") {
+    CHECK(HtmlDecode("&lt;&gt;&amp;&apos;&quot;"sv) == "<>&'\""s);
+    CHECK(HtmlDecode("&LT;&GT;&AMP;&APOS;&QUOT;"sv) == "<>&'\""s);
+    CHECK(HtmlDecode("x &lt y &gt z"sv) == "x < y > z"s);
+    CHECK(HtmlDecode("M&amp;M&APOSs"sv) == "M&M's"s);
+    CHECK(HtmlDecode("&quot"sv) == "\""s);
+    CHECK(HtmlDecode("&lt;;"sv) == "<;"s);
+}
+
+TEST_CASE("Decoded text is not scanned again", "[HtmlDecode]") {
+    CHECK(HtmlDecode("&amp;lt;"sv) == "&lt;"s);
+    CHECK(HtmlDecode("&amp;amp;amp;"sv) == "&amp;amp;"s);
+    CHECK(HtmlDecode("&ampgt"sv) == "&gt"s);
+}
+
+TEST_CASE("Not mnemonics", "[HtmlDecode]") {
+    CHECK(HtmlDecode("&Lt; &lT; &Amp &aMP"sv) == "&Lt; &lT; &Amp &aMP"s);
+    CHECK(HtmlDecode("&"sv) == "&"s);
+    CHECK(HtmlDecode("&&"sv) == "&&"s);
+    CHECK(HtmlDecode("&am"sv) == "&am"s);
+    CHECK(HtmlDecode("&nbsp; &copy;"sv) == "&nbsp; &copy;"s);
+    CHECK(HtmlDecode("&&lt"sv) == "&<"s);
+    CHECK(HtmlDecode("a & b"sv) == "a & b"s);
+}
+
+TEST_CASE("In-place decoding", "[HtmlDecode]") {
+    std::string str = "if (a &lt; b &AMP;&amp; c &gt; d) &quot;ok&quot;"s;
+    HtmlDecodeInPlace(str);
+    CHECK(str == "if (a < b && c > d) \"ok\""s);
+
+    std::string plain = "no mnemonics here"s;
+    HtmlDecodeInPlace(plain);
+    CHECK(plain == "no mnemonics here"s);
+}
+
+TEST_CASE("Decoding to an output iterator", "[HtmlDecode]") {
+    std::ostringstream out;
+    HtmlDecodeTo("M&amp;M&APOSs &amp;lt;"sv, std::ostreambuf_iterator<char>{out});
+    CHECK(out.str() == "M&M's &lt;"s);
+
+    std::string appended = "prefix: "s;
+    HtmlDecodeTo("&lt;tag&gt;"sv, std::back_inserter(appended));
+    CHECK(appended == "prefix: <tag>"s);
+}
+
+TEST_CASE("Streaming decoding", "[HtmlDecoder]") {
+    const auto text = "M&amp;M&APOSs &amp;lt; &quot&lt;&gt &am &Lt; &&&apos;&"sv;
+    const auto expected = HtmlDecode(text);
+
+    // Текст разбивается на части всех длин, в том числе внутри мнемоник
+    for (size_t chunk_size = 1; chunk_size <= text.size(); ++chunk_size) {
+        HtmlDecoder decoder;
+        std::string result;
+        for (size_t pos = 0; pos < text.size(); pos += chunk_size) {
+            decoder.Decode(text.substr(pos, chunk_size), result);
+        }
+        decoder.Finish(result);
+        CHECK(result == expected);
+    }
+
+    HtmlDecoder decoder;
+    std::string result;
+    decoder.Decode("M&am"sv, result);
+    decoder.Decode(""sv, result);
+    decoder.Decode("p;M"sv, result);
+    decoder.Finish(result);
+    CHECK(result == "M&M"s);
+}
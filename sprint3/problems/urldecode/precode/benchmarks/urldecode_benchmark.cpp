@@ -0,0 +1,133 @@
+#include <chrono>
+#include <charconv>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../src/urldecode.h"
+
+/*
+ * Сравнивает UrlDecode, UrlDecodeInPlace и UrlDecoder с посимвольным декодированием
+ * на типичных путях и строках запроса, на длинном пути без спецсимволов
+ * и на неудобных входных данных: строках из одних %-последовательностей и одних '+'.
+ */
+
+using namespace std::literals;
+
+namespace {
+
+constexpr size_t TOTAL_BYTES = 200'000'000;
+
+// Посимвольное декодирование: каждый символ дописывается в строку по одному
+std::string NaiveUrlDecode(std::string_view str) {
+    std::string result;
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (str[i] == '%') {
+            if (i + 2 >= str.size()) {
+                throw std::invalid_argument("Incomplete %-escape sequence");
+            }
+            int value = 0;
+            const auto [ptr, ec] = std::from_chars(str.data() + i + 1, str.data() + i + 3, value, 16);
+            if (ec != std::errc{} || ptr != str.data() + i + 3) {
+                throw std::invalid_argument("Invalid %-escape sequence");
+            }
+            result += static_cast<char>(value);
+            i += 2;
+        } else if (str[i] == '+') {
+            result += ' ';
+        } else {
+            result += str[i];
+        }
+    }
+    return result;
+}
+
+struct Input {
+    std::string_view name;
+    std::vector<std::string> strings;
+    size_t bytes = 0;
+};
+
+Input MakeInput(std::string_view name, std::vector<std::string> strings) {
+    Input input{name, std::move(strings)};
+    for (const auto& str : input.strings) {
+        input.bytes += str.size();
+    }
+    return input;
+}
+
+template <typename Decode>
+void Report(std::string_view name, const Input& input, Decode&& decode) {
+    const size_t rounds = TOTAL_BYTES / input.bytes + 1;
+    size_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; ++round) {
+        for (const auto& str : input.strings) {
+            checksum += decode(str);
+        }
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  "sv << name << ": "sv
+              << static_cast<double>(rounds * input.bytes) / seconds / (1 << 20) << " MiB/s ("sv
+              << seconds * 1e9 / static_cast<double>(rounds * input.strings.size())
+              << " ns per string, checksum "sv << checksum << ")"sv << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    std::string long_path;
+    while (long_path.size() < 4000) {
+        long_path += "/static/assets/images/backgrounds/level"s;
+    }
+    std::string escapes;
+    std::string pluses;
+    for (size_t i = 0; i < 1000; ++i) {
+        escapes += "%D0%B0"sv;
+        pluses += "++++++"sv;
+    }
+
+    const std::vector<Input> inputs = {
+        MakeInput("typical"sv, {"/index.html"s, "/images/cat%20photo.jpg"s,
+                                "/api/v1/maps/map1"s, "/search?q=%D0%BA%D0%BE%D1%82+%D0%B8+%D0%BF%D1%91%D1%81"s,
+                                "/static/js/app.bundle.min.js?v=20240101"s,
+                                "/docs/Getting+Started%3A+a+guide%20for%20new%20players.html"s}),
+        MakeInput("long clean path"sv, {long_path}),
+        MakeInput("only escapes"sv, {escapes}),
+        MakeInput("only pluses"sv, {pluses}),
+    };
+
+    for (const auto& input : inputs) {
+        std::cout << input.name << ":"sv << std::endl;
+        Report("naive loop"sv, input, [](const std::string& str) {
+            return NaiveUrlDecode(str).size();
+        });
+        Report("UrlDecode"sv, input, [](const std::string& str) {
+            return UrlDecode(str).size();
+        });
+        std::string buffer;
+        Report("UrlDecodeTo"sv, input, [&buffer](const std::string& str) {
+            buffer.resize(str.size());
+            return static_cast<size_t>(UrlDecodeTo(str, buffer.data()) - buffer.data());
+        });
+        std::string in_place;
+        Report("UrlDecodeInPlace"sv, input, [&in_place](const std::string& str) {
+            in_place = str;
+            UrlDecodeInPlace(in_place);
+            return in_place.size();
+        });
+        std::string streamed;
+        Report("UrlDecoder, 64-byte chunks"sv, input, [&streamed](const std::string& str) {
+            UrlDecoder decoder;
+            streamed.clear();
+            for (size_t pos = 0; pos < str.size(); pos += 64) {
+                decoder.Decode(std::string_view{str}.substr(pos, 64), streamed);
+            }
+            decoder.Finish();
+            return streamed.size();
+        });
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 /*
 Возвращает URL-декодированное представление строки str.
@@ -8,3 +9,51 @@
 В случае ошибки выбрасывает исключение std::invalid_argument
 */
 std::string UrlDecode(std::string_view str);
+
+/*
+Проверяет, есть ли в строке str символы '%' или '+', то есть отличается ли
+её декодированное представление от неё самой.
+*/
+bool HasUrlEscapes(std::string_view str) noexcept;
+
+/*
+Декодирует строку str на месте: результат не длиннее исходной строки,
+поэтому записывается в её же буфер без выделения памяти.
+В случае ошибки выбрасывает исключение std::invalid_argument,
+содержимое str при этом не определено.
+*/
+void UrlDecodeInPlace(std::string& str);
+
+/*
+Декодирует строку str в буфер out, в котором должно быть не меньше str.size() байт.
+Буфер out может совпадать с началом str. Возвращает указатель на конец результата.
+В случае ошибки выбрасывает исключение std::invalid_argument
+*/
+char* UrlDecodeTo(std::string_view str, char* out);
+
+/*
+Потоковый декодер для строки, поступающей частями.
+%-последовательность может быть разорвана между частями: её начало
+запоминается до следующего вызова Decode.
+Пример:
+    UrlDecoder decoder;
+    std::string result;
+    decoder.Decode("Hello%2"sv, result);
+    decoder.Decode("0World"sv, result);
+    decoder.Finish();  // result == "Hello World"
+*/
+class UrlDecoder {
+public:
+    // Дописывает в out декодированную часть chunk.
+    // Выбрасывает std::invalid_argument при некорректной %-последовательности
+    void Decode(std::string_view chunk, std::string& out);
+
+    // Завершает декодирование. Выбрасывает std::invalid_argument,
+    // если строка оборвалась внутри %-последовательности
+    void Finish();
+
+private:
+    // Начало %-последовательности, оборванной в конце предыдущей части
+    char pending_[3] = {};
+    size_t pending_size_ = 0;
+};
@@ -3,9 +3,91 @@
 
 #include "../src/urldecode.h"
 
-BOOST_AUTO_TEST_CASE(UrlDecode_tests) {
-    using namespace std::literals;
+using namespace std::literals;
 
+BOOST_AUTO_TEST_CASE(UrlDecode_tests) {
     BOOST_TEST(UrlDecode(""sv) == ""s);
-    // Напишите остальные тесты для функции UrlDecode самостоятельно
-}
\ No newline at end of file
+    BOOST_TEST(UrlDecode("Hello World"sv) == "Hello World"s);
+    BOOST_TEST(UrlDecode("Hello+World%20%21"sv) == "Hello World !"s);
+    BOOST_TEST(UrlDecode("%2b%2B%7e%7E"sv) == "++~~"s);
+    BOOST_TEST(UrlDecode("%D0%BF%D1%80%D0%B8%D0%B2%D0%B5%D1%82"sv) == "привет"s);
+    BOOST_TEST(UrlDecode("%00"sv) == "\0"s);
+    BOOST_TEST(UrlDecode("+++"sv) == "   "s);
+    BOOST_TEST(UrlDecode("%25"sv) == "%"s);
+
+    BOOST_CHECK_THROW(UrlDecode("%"sv), std::invalid_argument);
+    BOOST_CHECK_THROW(UrlDecode("abc%2"sv), std::invalid_argument);
+    BOOST_CHECK_THROW(UrlDecode("%2G"sv), std::invalid_argument);
+    BOOST_CHECK_THROW(UrlDecode("%G2"sv), std::invalid_argument);
+    BOOST_CHECK_THROW(UrlDecode("%%20"sv), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(UrlDecode_long_strings_tests) {
+    // Длинные строки проверяются блоками по 16 и 32 байта, поэтому спецсимволы
+    // расставляются на каждой позиции относительно начала блока
+    const std::string plain(100, 'a');
+    BOOST_TEST(UrlDecode(plain) == plain);
+    for (size_t pos = 0; pos + 3 <= plain.size(); ++pos) {
+        std::string encoded = plain;
+        encoded.replace(pos, 3, "%41"s);
+        std::string expected = plain;
+        expected.replace(pos, 3, "A"s);
+        BOOST_TEST(UrlDecode(encoded) == expected);
+
+        std::string with_plus = plain;
+        with_plus[pos] = '+';
+        std::string expected_space = plain;
+        expected_space[pos] = ' ';
+        BOOST_TEST(UrlDecode(with_plus) == expected_space);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(HasUrlEscapes_tests) {
+    BOOST_TEST(!HasUrlEscapes(""sv));
+    BOOST_TEST(!HasUrlEscapes("/api/v1/maps/map1"sv));
+    BOOST_TEST(HasUrlEscapes("/file%20name.html"sv));
+    BOOST_TEST(HasUrlEscapes("a+b"sv));
+    BOOST_TEST(HasUrlEscapes(std::string(40, 'a') + "%"s));
+}
+
+BOOST_AUTO_TEST_CASE(UrlDecodeInPlace_tests) {
+    std::string str = "/static/some+file%20name%2Ehtml?q=%D1%8F"s;
+    UrlDecodeInPlace(str);
+    BOOST_TEST(str == "/static/some file name.html?q=я"s);
+
+    std::string empty;
+    UrlDecodeInPlace(empty);
+    BOOST_TEST(empty.empty());
+
+    std::string invalid = "abc%zz"s;
+    BOOST_CHECK_THROW(UrlDecodeInPlace(invalid), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(UrlDecoder_tests) {
+    const auto encoded = "Hello+World%20%21%D0%BF%D1%80%D0%B8%D0%B2%D0%B5%D1%82+%25"sv;
+    const auto expected = UrlDecode(encoded);
+
+    // Строка разбивается на части всех длин, в том числе внутри %-последовательностей
+    for (size_t chunk_size = 1; chunk_size <= encoded.size(); ++chunk_size) {
+        UrlDecoder decoder;
+        std::string result;
+        for (size_t pos = 0; pos < encoded.size(); pos += chunk_size) {
+            decoder.Decode(encoded.substr(pos, chunk_size), result);
+        }
+        decoder.Finish();
+        BOOST_TEST(result == expected);
+    }
+
+    {
+        UrlDecoder decoder;
+        std::string result;
+        decoder.Decode("abc%4"sv, result);
+        BOOST_CHECK_THROW(decoder.Finish(), std::invalid_argument);
+    }
+    {
+        UrlDecoder decoder;
+        std::string result;
+        decoder.Decode("%"sv, result);
+        BOOST_CHECK_THROW(decoder.Decode("xy"sv, result), std::invalid_argument);
+    }
+}
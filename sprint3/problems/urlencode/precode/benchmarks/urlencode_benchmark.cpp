@@ -0,0 +1,112 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../src/urlencode.h"
+
+/*
+ * Измеряет пропускную способность UrlEncode и UrlEncodeTo с повторно используемым
+ * буфером в сравнении с посимвольным кодированием, которое проверяет символ
+ * цепочкой условий и дописывает результат в строку по одному символу.
+ * Входные данные: типичные пути и строки запроса, длинный путь без символов,
+ * требующих кодирования, текст в UTF-8 и строка из одних зарезервированных символов.
+ */
+
+using namespace std::literals;
+
+namespace {
+
+constexpr size_t TOTAL_BYTES = 200'000'000;
+
+std::string NaiveUrlEncode(std::string_view str) {
+    static constexpr char HEX_DIGITS[] = "0123456789ABCDEF";
+    std::string result;
+    for (const char c : str) {
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-'
+            || c == '.' || c == '_' || c == '~') {
+            result += c;
+        } else if (c == ' ') {
+            result += '+';
+        } else {
+            const auto code = static_cast<unsigned char>(c);
+            result += '%';
+            result += HEX_DIGITS[code >> 4];
+            result += HEX_DIGITS[code & 0xF];
+        }
+    }
+    return result;
+}
+
+struct Input {
+    std::string_view name;
+    std::vector<std::string> strings;
+    size_t bytes = 0;
+};
+
+Input MakeInput(std::string_view name, std::vector<std::string> strings) {
+    Input input{name, std::move(strings)};
+    for (const auto& str : input.strings) {
+        input.bytes += str.size();
+    }
+    return input;
+}
+
+template <typename Encode>
+void Report(std::string_view name, const Input& input, Encode&& encode) {
+    const size_t rounds = TOTAL_BYTES / input.bytes + 1;
+    size_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; ++round) {
+        for (const auto& str : input.strings) {
+            checksum += encode(str);
+        }
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  "sv << name << ": "sv
+              << static_cast<double>(rounds * input.bytes) / seconds / (1 << 20) << " MiB/s ("sv
+              << seconds * 1e9 / static_cast<double>(rounds * input.strings.size())
+              << " ns per string, checksum "sv << checksum << ")"sv << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    std::string long_path;
+    while (long_path.size() < 4000) {
+        long_path += "static-assets.images_backgrounds~level"s;
+    }
+    std::string utf8_text;
+    std::string reserved;
+    while (utf8_text.size() < 4000) {
+        utf8_text += "Съешь же ещё этих мягких французских булок, да выпей чаю. "s;
+        reserved += "!#$&'()*+,/:;=?@[]"s;
+    }
+
+    const std::vector<Input> inputs = {
+        MakeInput("typical"sv, {"index.html"s, "cat photo.jpg"s, "map1"s, "кот и пёс"s,
+                                "app.bundle.min.js?v=20240101"s,
+                                "Getting Started: a guide for new players"s}),
+        MakeInput("long safe path"sv, {long_path}),
+        MakeInput("UTF-8 text"sv, {utf8_text}),
+        MakeInput("only reserved"sv, {reserved}),
+    };
+
+    for (const auto& input : inputs) {
+        std::cout << input.name << ":"sv << std::endl;
+        Report("naive loop"sv, input, [](const std::string& str) {
+            return NaiveUrlEncode(str).size();
+        });
+        Report("UrlEncode"sv, input, [](const std::string& str) {
+            return UrlEncode(str).size();
+        });
+        std::string buffer;
+        Report("UrlEncodeTo, reused buffer"sv, input, [&buffer](const std::string& str) {
+            buffer.clear();
+            UrlEncodeTo(str, buffer);
+            return buffer.size();
+        });
+    }
+}
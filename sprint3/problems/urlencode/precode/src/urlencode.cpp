@@ -1,6 +1,182 @@
 #include "urlencode.h"
 
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Битовая карта символов, которые выводятся без изменений: буквы английского алфавита,
+// цифры и -._~. Зарезервированные символы !#$&'()*+,/:;=?@[], пробел
+// и все остальные символы в неё не входят
+constexpr std::array<uint64_t, 4> SAFE_CHARS = [] {
+    std::array<uint64_t, 4> bits{};
+    const auto add = [&bits](unsigned char c) {
+        bits[c >> 6] |= uint64_t{1} << (c & 63);
+    };
+    for (char c = 'a'; c <= 'z'; ++c) {
+        add(c);
+        add(c - 'a' + 'A');
+    }
+    for (char c = '0'; c <= '9'; ++c) {
+        add(c);
+    }
+    for (char c : {'-', '.', '_', '~'}) {
+        add(c);
+    }
+    return bits;
+}();
+
+constexpr char HEX_DIGITS[] = "0123456789ABCDEF";
+
+bool IsSafe(char c) noexcept {
+    const auto code = static_cast<unsigned char>(c);
+    return (SAFE_CHARS[code >> 6] >> (code & 63)) & 1;
+}
+
+#if defined(__SSE2__)
+// Маска байтов c, попадающих в диапазон [lo, hi] (сравнение без знака)
+__m128i InRange(__m128i c, char lo, char hi) noexcept {
+    const __m128i offset = _mm_sub_epi8(c, _mm_set1_epi8(lo));
+    const __m128i width = _mm_set1_epi8(static_cast<char>(hi - lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(offset, width), offset);
+}
+
+// Маска байтов, входящих в SAFE_CHARS
+__m128i SafeMask(__m128i c) noexcept {
+    // Установленный бит 0x20 превращает заглавные буквы в строчные
+    const __m128i letters = InRange(_mm_or_si128(c, _mm_set1_epi8(0x20)), 'a', 'z');
+    const __m128i digits = InRange(c, '0', '9');
+    const __m128i punct = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('-')), _mm_cmpeq_epi8(c, _mm_set1_epi8('.'))),
+        _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('_')), _mm_cmpeq_epi8(c, _mm_set1_epi8('~'))));
+    return _mm_or_si128(_mm_or_si128(letters, digits), punct);
+}
+#endif
+
+#if defined(__AVX2__)
+__m256i InRange(__m256i c, char lo, char hi) noexcept {
+    const __m256i offset = _mm256_sub_epi8(c, _mm256_set1_epi8(lo));
+    const __m256i width = _mm256_set1_epi8(static_cast<char>(hi - lo));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(offset, width), offset);
+}
+
+__m256i SafeMask(__m256i c) noexcept {
+    const __m256i letters = InRange(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), 'a', 'z');
+    const __m256i digits = InRange(c, '0', '9');
+    const __m256i punct = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('-')),
+                        _mm256_cmpeq_epi8(c, _mm256_set1_epi8('.'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('_')),
+                        _mm256_cmpeq_epi8(c, _mm256_set1_epi8('~'))));
+    return _mm256_or_si256(_mm256_or_si256(letters, digits), punct);
+}
+#endif
+
+// Возвращает указатель на первый символ в [p, end), требующий кодирования, либо end.
+// Участки без таких символов проверяются по 32 (AVX2) или 16 (SSE2) байт за шаг
+const char* FindUnsafe(const char* p, const char* end) noexcept {
+#if defined(__AVX2__)
+    while (end - p >= 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const auto mask = ~static_cast<unsigned>(_mm256_movemask_epi8(SafeMask(chunk)));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+#endif
+#if defined(__SSE2__)
+    while (end - p >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const auto mask = ~static_cast<unsigned>(_mm_movemask_epi8(SafeMask(chunk))) & 0xFFFF;
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+#endif
+    while (p != end && IsSafe(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+}  // namespace
+
+size_t UrlEncodedSize(std::string_view str) noexcept {
+    // Пробел заменяется одним символом, остальные символы, требующие кодирования, - тремя.
+    // В блоке такие символы подсчитываются сложением байтов маски (psadbw),
+    // без ветвлений на каждый символ
+    const char* p = str.data();
+    const char* const end = p + str.size();
+    size_t escaped = 0;
+#if defined(__AVX2__)
+    __m256i sums32 = _mm256_setzero_si256();
+    for (; end - p >= 32; p += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i not_escaped =
+            _mm256_or_si256(SafeMask(chunk), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')));
+        const __m256i ones = _mm256_andnot_si256(not_escaped, _mm256_set1_epi8(1));
+        sums32 = _mm256_add_epi64(sums32, _mm256_sad_epu8(ones, _mm256_setzero_si256()));
+    }
+    alignas(32) uint64_t lanes32[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes32), sums32);
+    escaped += lanes32[0] + lanes32[1] + lanes32[2] + lanes32[3];
+#endif
+#if defined(__SSE2__)
+    __m128i sums = _mm_setzero_si128();
+    for (; end - p >= 16; p += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i not_escaped =
+            _mm_or_si128(SafeMask(chunk), _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')));
+        const __m128i ones = _mm_andnot_si128(not_escaped, _mm_set1_epi8(1));
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(ones, _mm_setzero_si128()));
+    }
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), sums);
+    escaped += lanes[0] + lanes[1];
+#endif
+    for (; p != end; ++p) {
+        escaped += !IsSafe(*p) && *p != ' ';
+    }
+    return str.size() + 2 * escaped;
+}
+
+void UrlEncodeTo(std::string_view str, std::string& out) {
+    const size_t old_size = out.size();
+    out.resize(old_size + UrlEncodedSize(str));
+
+    const char* in = str.data();
+    const char* const end = in + str.size();
+    char* dst = out.data() + old_size;
+    while (in != end) {
+        const char* unsafe = FindUnsafe(in, end);
+        const auto safe_size = static_cast<size_t>(unsafe - in);
+        std::memcpy(dst, in, safe_size);
+        dst += safe_size;
+        in = unsafe;
+        // Подряд идущие символы, требующие кодирования, обрабатываются без поиска
+        while (in != end && !IsSafe(*in)) {
+            const auto c = static_cast<unsigned char>(*in++);
+            if (c == ' ') {
+                *dst++ = '+';
+            } else {
+                dst[0] = '%';
+                dst[1] = HEX_DIGITS[c >> 4];
+                dst[2] = HEX_DIGITS[c & 0xF];
+                dst += 3;
+            }
+        }
+    }
+}
+
 std::string UrlEncode(std::string_view str) {
-    // Напишите реализацию самостоятельно
-    return {str.begin(), str.end()};
+    std::string result;
+    UrlEncodeTo(str, result);
+    return result;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 /*
  * URL-кодирует строку str.
@@ -10,3 +11,15 @@
  * Зарезервированные символы: !#$&'()*+,/:;=?@[]
  */
 std::string UrlEncode(std::string_view str);
+
+/*
+ * Дописывает URL-кодированную строку str в конец out.
+ * Память в out выделяется не более одного раза, а при повторном использовании
+ * одного и того же буфера обычно не выделяется вовсе.
+ */
+void UrlEncodeTo(std::string_view str, std::string& out);
+
+/*
+ * Возвращает длину URL-кодированного представления строки str.
+ */
+size_t UrlEncodedSize(std::string_view str) noexcept;
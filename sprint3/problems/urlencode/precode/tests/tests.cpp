@@ -6,6 +6,65 @@ using namespace std::literals;
 
 TEST(UrlEncodeTestSuite, OrdinaryCharsAreNotEncoded) {
     EXPECT_EQ(UrlEncode("hello"sv), "hello"s);
+    EXPECT_EQ(UrlEncode("AZaz09-._~"sv), "AZaz09-._~"s);
 }
 
-/* Напишите остальные тесты самостоятельно */
+TEST(UrlEncodeTestSuite, EmptyString) {
+    EXPECT_EQ(UrlEncode(""sv), ""s);
+}
+
+TEST(UrlEncodeTestSuite, SpaceIsReplacedWithPlus) {
+    EXPECT_EQ(UrlEncode("Hello World"sv), "Hello+World"s);
+    EXPECT_EQ(UrlEncode("   "sv), "+++"s);
+}
+
+TEST(UrlEncodeTestSuite, ReservedCharsAreEncoded) {
+    EXPECT_EQ(UrlEncode("!#$&'()*+,/:;=?@[]"sv),
+              "%21%23%24%26%27%28%29%2A%2B%2C%2F%3A%3B%3D%3F%40%5B%5D"s);
+}
+
+TEST(UrlEncodeTestSuite, OtherCharsAreEncoded) {
+    EXPECT_EQ(UrlEncode("\x01\x1F\x7F"sv), "%01%1F%7F"s);
+    EXPECT_EQ(UrlEncode("\0"sv), "%00"s);
+    EXPECT_EQ(UrlEncode("%\"<>\\^`{|}"sv), "%25%22%3C%3E%5C%5E%60%7B%7C%7D"s);
+    EXPECT_EQ(UrlEncode("привет"sv), "%D0%BF%D1%80%D0%B8%D0%B2%D0%B5%D1%82"s);
+}
+
+TEST(UrlEncodeTestSuite, EveryCharIsClassifiedOnEveryPosition) {
+    // Длинные строки проверяются блоками по 16 и 32 байта, поэтому каждый символ
+    // ставится на каждую позицию относительно начала блока
+    const std::string plain(40, 'a');
+    for (int code = 0; code < 256; ++code) {
+        const char c = static_cast<char>(code);
+        std::string expected_char;
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+            || "-._~"sv.find(c) != std::string_view::npos) {
+            expected_char = c;
+        } else if (c == ' ') {
+            expected_char = "+"s;
+        } else {
+            static constexpr char HEX[] = "0123456789ABCDEF";
+            expected_char = {'%', HEX[code >> 4], HEX[code & 0xF]};
+        }
+        for (size_t pos = 0; pos < plain.size(); ++pos) {
+            std::string str = plain;
+            str[pos] = c;
+            const std::string expected
+                = plain.substr(0, pos) + expected_char + plain.substr(pos + 1);
+            ASSERT_EQ(UrlEncode(str), expected) << "code " << code << ", position " << pos;
+            ASSERT_EQ(UrlEncodedSize(str), expected.size());
+        }
+    }
+}
+
+TEST(UrlEncodeTestSuite, UrlEncodeToAppendsToBuffer) {
+    std::string out = "/search?q="s;
+    UrlEncodeTo("cats & dogs"sv, out);
+    EXPECT_EQ(out, "/search?q=cats+%26+dogs"s);
+
+    out.clear();
+    const auto capacity = out.capacity();
+    UrlEncodeTo("a b"sv, out);
+    EXPECT_EQ(out, "a+b"s);
+    EXPECT_EQ(out.capacity(), capacity);
+}
@@ -0,0 +1,69 @@
+#include "leaderboard.h"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+
+namespace retirement {
+
+Leaderboard::Leaderboard(RetiredPlayerRepository& repository, size_t capacity)
+    : repository_{repository}
+    , capacity_{capacity} {
+    if (capacity_ == 0) {
+        throw std::invalid_argument("Leaderboard capacity must be positive");
+    }
+}
+
+void Leaderboard::Warm() {
+    auto records = repository_.GetRecords(0, capacity_);
+    std::lock_guard lock{mutex_};
+    top_.Clear();
+    // Если хранилище вернуло ровно capacity записей, за ними могут быть и другие
+    complete_ = records.size() < capacity_;
+    for (auto& record : records) {
+        top_.Insert(std::move(record));
+    }
+}
+
+void Leaderboard::Add(std::span<const RetiredPlayer> players) {
+    std::lock_guard lock{mutex_};
+    for (const auto& player : players) {
+        AddLocked(player);
+    }
+}
+
+void Leaderboard::AddLocked(const RetiredPlayer& player) {
+    if (top_.Size() == capacity_) {
+        complete_ = false;
+        if (!RecordOrder{}(player, top_.At(capacity_ - 1))) {
+            return;
+        }
+        top_.EraseAt(capacity_ - 1);
+    }
+    top_.Insert(player);
+}
+
+std::vector<RetiredPlayer> Leaderboard::GetRecords(size_t start, size_t max_items) const {
+    {
+        std::shared_lock lock{mutex_};
+        if (complete_ || (start <= top_.Size() && max_items <= top_.Size() - start)) {
+            cache_hits_.fetch_add(1, std::memory_order_relaxed);
+            std::vector<RetiredPlayer> records;
+            if (start < top_.Size()) {
+                records.reserve(std::min(max_items, top_.Size() - start));
+                top_.Copy(start, max_items, std::back_inserter(records));
+            }
+            return records;
+        }
+    }
+    repository_reads_.fetch_add(1, std::memory_order_relaxed);
+    return repository_.GetRecords(start, max_items);
+}
+
+size_t Leaderboard::GetCachedCount() const {
+    std::shared_lock lock{mutex_};
+    return top_.Size();
+}
+
+}  // namespace retirement
@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <shared_mutex>
+#include <span>
+#include <vector>
+
+#include "retired_player.h"
+#include "skip_list.h"
+
+namespace retirement {
+
+/*
+ * Кэш первых capacity записей таблицы рекордов для /api/v1/game/records.
+ *
+ * Кэш заполняется из хранилища при старте сервера и пополняется потоком записи
+ * после сохранения очередной пачки (см. RetiredPlayerWriter::Config::on_saved).
+ * Страницы, целиком попадающие в первые capacity записей, читаются из памяти
+ * за O(log n + размер страницы), за остальными кэш обращается к хранилищу.
+ */
+class Leaderboard {
+public:
+    struct Stats {
+        uint64_t cache_hits = 0;
+        uint64_t repository_reads = 0;
+    };
+
+    Leaderboard(RetiredPlayerRepository& repository, size_t capacity);
+
+    // Загружает первые capacity записей из хранилища.
+    // Вызывается до запуска потока записи, чтобы не пропустить сохраняемые записи
+    void Warm();
+
+    // Учитывает новые записи, уже сохранённые в хранилище
+    void Add(std::span<const RetiredPlayer> players);
+
+    // Возвращает не более max_items записей, начиная с номера start
+    std::vector<RetiredPlayer> GetRecords(size_t start, size_t max_items) const;
+
+    size_t GetCachedCount() const;
+
+    Stats GetStats() const noexcept {
+        return {cache_hits_.load(std::memory_order_relaxed),
+                repository_reads_.load(std::memory_order_relaxed)};
+    }
+
+private:
+    void AddLocked(const RetiredPlayer& player);
+
+    RetiredPlayerRepository& repository_;
+    size_t capacity_;
+
+    mutable std::shared_mutex mutex_;
+    util::IndexableSkipList<RetiredPlayer, RecordOrder> top_;
+    // true, пока в хранилище нет записей помимо тех, что находятся в кэше
+    bool complete_ = true;
+
+    mutable std::atomic<uint64_t> cache_hits_{0};
+    mutable std::atomic<uint64_t> repository_reads_{0};
+};
+
+}  // namespace retirement
@@ -0,0 +1,77 @@
+#include "postgres.h"
+
+#include <pqxx/zview.hxx>
+#include <string>
+
+namespace postgres {
+
+using namespace std::literals;
+using pqxx::operator"" _zv;
+
+RetiredPlayerRepositoryImpl::RetiredPlayerRepositoryImpl(pqxx::connection write_connection,
+                                                         ConnectionPool& read_pool)
+    : write_connection_{std::move(write_connection)}
+    , read_pool_{read_pool} {
+    pqxx::work work{write_connection_};
+    work.exec(R"(
+CREATE TABLE IF NOT EXISTS retired_players (
+    id SERIAL PRIMARY KEY,
+    name varchar(100) NOT NULL,
+    score integer NOT NULL,
+    play_time_ms integer NOT NULL
+);
+)"_zv);
+    work.exec(R"(
+CREATE INDEX IF NOT EXISTS retired_players_score_idx
+    ON retired_players (score DESC, play_time_ms, name);
+)"_zv);
+    work.commit();
+}
+
+void RetiredPlayerRepositoryImpl::SaveBatch(std::span<const retirement::RetiredPlayer> players) {
+    if (players.empty()) {
+        return;
+    }
+
+    pqxx::work work{write_connection_};
+    // Все записи пачки вставляются одним многострочным INSERT
+    std::string query = "INSERT INTO retired_players (name, score, play_time_ms) VALUES "s;
+    query.reserve(query.size() + players.size() * 64);
+    bool first = true;
+    for (const auto& player : players) {
+        if (!first) {
+            query += ',';
+        }
+        first = false;
+        query += '(';
+        query += work.quote(player.name);
+        query += ',';
+        query += std::to_string(player.score);
+        query += ',';
+        query += std::to_string(player.play_time.count());
+        query += ')';
+    }
+    query += ';';
+    work.exec(query);
+    work.commit();
+}
+
+std::vector<retirement::RetiredPlayer> RetiredPlayerRepositoryImpl::GetRecords(size_t start,
+                                                                               size_t max_items) {
+    auto connection = read_pool_.GetConnection();
+    pqxx::read_transaction read{*connection};
+    std::vector<retirement::RetiredPlayer> records;
+    records.reserve(max_items);
+    const auto result = read.exec("SELECT name, score, play_time_ms FROM retired_players "
+                                  "ORDER BY score DESC, play_time_ms, name "
+                                  "OFFSET "s
+                                  + std::to_string(start) + " LIMIT "s + std::to_string(max_items)
+                                  + ";"s);
+    for (const auto& row : result) {
+        records.push_back({row[0].as<std::string>(), row[1].as<retirement::Score>(),
+                           std::chrono::milliseconds{row[2].as<int>()}});
+    }
+    return records;
+}
+
+}  // namespace postgres
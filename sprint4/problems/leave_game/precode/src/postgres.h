@@ -0,0 +1,27 @@
+#pragma once
+#include <pqxx/connection>
+#include <pqxx/transaction>
+
+#include "connection_pool.h"
+#include "retired_player.h"
+
+namespace postgres {
+
+// Хранит записи об ушедших на пенсию игроках в таблице retired_players.
+// SaveBatch вызывается только из потока записи и владеет собственным соединением,
+// а GetRecords вызывается из потоков обработки запросов и берёт соединения из пула
+// read_pool, поэтому чтение таблицы рекордов не ждёт окончания вставки пачки
+class RetiredPlayerRepositoryImpl : public retirement::RetiredPlayerRepository {
+public:
+    RetiredPlayerRepositoryImpl(pqxx::connection write_connection, ConnectionPool& read_pool);
+
+    void SaveBatch(std::span<const retirement::RetiredPlayer> players) override;
+
+    std::vector<retirement::RetiredPlayer> GetRecords(size_t start, size_t max_items) override;
+
+private:
+    pqxx::connection write_connection_;
+    ConnectionPool& read_pool_;
+};
+
+}  // namespace postgres
@@ -0,0 +1,47 @@
+#pragma once
+#include <chrono>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace retirement {
+
+using Score = unsigned;
+
+// Запись о собаке, ушедшей на пенсию
+struct RetiredPlayer {
+    std::string name;
+    Score score = 0;
+    std::chrono::milliseconds play_time{0};
+
+    [[nodiscard]] bool operator==(const RetiredPlayer&) const = default;
+};
+
+// Порядок таблицы рекордов: по убыванию счёта, затем по возрастанию времени игры и имени
+struct RecordOrder {
+    bool operator()(const RetiredPlayer& lhs, const RetiredPlayer& rhs) const noexcept {
+        if (lhs.score != rhs.score) {
+            return lhs.score > rhs.score;
+        }
+        if (lhs.play_time != rhs.play_time) {
+            return lhs.play_time < rhs.play_time;
+        }
+        return lhs.name < rhs.name;
+    }
+};
+
+// Хранилище записей об ушедших на пенсию игроках
+class RetiredPlayerRepository {
+public:
+    // Сохраняет все записи players за одно обращение к хранилищу.
+    // В случае ошибки выбрасывает исключение, и ни одна запись не считается сохранённой
+    virtual void SaveBatch(std::span<const RetiredPlayer> players) = 0;
+
+    // Возвращает не более max_items записей, начиная с номера start, в порядке RecordOrder
+    virtual std::vector<RetiredPlayer> GetRecords(size_t start, size_t max_items) = 0;
+
+protected:
+    ~RetiredPlayerRepository() = default;
+};
+
+}  // namespace retirement
@@ -0,0 +1,147 @@
+#include "retired_player_writer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace retirement {
+
+RetiredPlayerWriter::RetiredPlayerWriter(RetiredPlayerRepository& repository, Config config)
+    : repository_{repository}
+    , config_{std::move(config)} {
+    if (config_.queue_capacity == 0 || config_.max_batch_size == 0 || config_.max_attempts == 0) {
+        throw std::invalid_argument("Invalid retired player writer config");
+    }
+    pending_.reserve(config_.queue_capacity);
+    worker_ = std::jthread{[this](std::stop_token stop) {
+        Run(std::move(stop));
+    }};
+}
+
+RetiredPlayerWriter::~RetiredPlayerWriter() {
+    worker_.request_stop();
+    worker_.join();
+}
+
+void RetiredPlayerWriter::Enqueue(RetiredPlayer player) {
+    std::unique_lock lock{mutex_};
+    if (pending_.size() >= config_.queue_capacity) {
+        ++metrics_.producer_waits;
+        has_space_.wait(lock, [this] {
+            return pending_.size() < config_.queue_capacity;
+        });
+    }
+    PushLocked(std::move(player));
+}
+
+bool RetiredPlayerWriter::TryEnqueue(RetiredPlayer player) {
+    std::lock_guard lock{mutex_};
+    if (pending_.size() >= config_.queue_capacity) {
+        ++metrics_.rejected;
+        return false;
+    }
+    PushLocked(std::move(player));
+    return true;
+}
+
+void RetiredPlayerWriter::PushLocked(RetiredPlayer&& player) {
+    pending_.push_back(std::move(player));
+    ++metrics_.enqueued;
+    metrics_.queue_depth = pending_.size();
+    metrics_.max_queue_depth = std::max(metrics_.max_queue_depth, pending_.size());
+    // Поток записи будится, только когда накопилась целая пачка,
+    // остальные записи он заберёт по истечении flush_interval
+    if (pending_.size() == config_.max_batch_size) {
+        has_records_.notify_one();
+    }
+}
+
+void RetiredPlayerWriter::Flush() {
+    std::unique_lock lock{mutex_};
+    const uint64_t target = metrics_.enqueued;
+    flush_requested_ = true;
+    has_records_.notify_one();
+    processed_.wait(lock, [this, target] {
+        return metrics_.written + metrics_.dropped >= target;
+    });
+}
+
+RetiredPlayerWriter::Metrics RetiredPlayerWriter::GetMetrics() const {
+    std::lock_guard lock{mutex_};
+    return metrics_;
+}
+
+void RetiredPlayerWriter::Run(std::stop_token stop) {
+    std::vector<RetiredPlayer> batch;
+    batch.reserve(config_.queue_capacity);
+    for (;;) {
+        {
+            std::unique_lock lock{mutex_};
+            has_records_.wait_for(lock, stop, config_.flush_interval, [this] {
+                return pending_.size() >= config_.max_batch_size || flush_requested_;
+            });
+            flush_requested_ = false;
+            if (pending_.empty()) {
+                if (stop.stop_requested()) {
+                    break;
+                }
+                continue;
+            }
+            batch.clear();
+            std::swap(batch, pending_);
+            metrics_.queue_depth = 0;
+        }
+        has_space_.notify_all();
+
+        for (size_t offset = 0; offset < batch.size(); offset += config_.max_batch_size) {
+            const size_t count = std::min(config_.max_batch_size, batch.size() - offset);
+            WriteBatch(std::span{batch}.subspan(offset, count));
+        }
+    }
+}
+
+void RetiredPlayerWriter::WriteBatch(std::span<const RetiredPlayer> batch) {
+    for (unsigned attempt = 1; attempt <= config_.max_attempts; ++attempt) {
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            repository_.SaveBatch(batch);
+        } catch (...) {
+            {
+                std::lock_guard lock{mutex_};
+                ++metrics_.failed_attempts;
+            }
+            if (attempt < config_.max_attempts) {
+                std::this_thread::sleep_for(config_.retry_delay);
+            }
+            continue;
+        }
+
+        const auto latency = std::chrono::steady_clock::now() - start;
+        // Пачка уже сохранена, поэтому ошибка обработчика не отменяет её запись
+        bool callback_failed = false;
+        if (config_.on_saved) {
+            try {
+                config_.on_saved(batch);
+            } catch (...) {
+                callback_failed = true;
+            }
+        }
+        {
+            std::lock_guard lock{mutex_};
+            metrics_.callback_failures += callback_failed ? 1 : 0;
+            metrics_.written += batch.size();
+            ++metrics_.batches;
+            metrics_.last_batch_latency = latency;
+            metrics_.total_write_time += latency;
+        }
+        processed_.notify_all();
+        return;
+    }
+
+    {
+        std::lock_guard lock{mutex_};
+        metrics_.dropped += batch.size();
+    }
+    processed_.notify_all();
+}
+
+}  // namespace retirement
@@ -0,0 +1,107 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "retired_player.h"
+
+namespace retirement {
+
+/*
+ * Фоновый поток записи ушедших на пенсию игроков.
+ *
+ * Игровой тик лишь помещает записи в ограниченную очередь, а отдельный поток
+ * забирает их пачками и сохраняет в хранилище. Поэтому задержки базы данных
+ * не останавливают игровой цикл, пока очередь не заполнена. Если очередь заполнена,
+ * Enqueue ждёт освобождения места (обратное давление), а TryEnqueue возвращает false.
+ */
+class RetiredPlayerWriter {
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    struct Config {
+        // Максимальное количество записей, ожидающих сохранения
+        size_t queue_capacity = 4096;
+        // Максимальное количество записей, сохраняемых за одно обращение к хранилищу
+        size_t max_batch_size = 256;
+        // Как долго поток записи ждёт накопления пачки
+        Duration flush_interval = std::chrono::milliseconds{100};
+        // Количество попыток сохранить пачку, после которых она отбрасывается
+        unsigned max_attempts = 3;
+        // Пауза между неудачными попытками
+        Duration retry_delay = std::chrono::milliseconds{100};
+        // Вызывается в потоке записи после успешного сохранения каждой пачки.
+        // Исключения обработчика не прерывают поток записи, а учитываются в callback_failures
+        std::function<void(std::span<const RetiredPlayer>)> on_saved;
+    };
+
+    struct Metrics {
+        uint64_t enqueued = 0;
+        uint64_t written = 0;
+        uint64_t dropped = 0;
+        uint64_t batches = 0;
+        uint64_t failed_attempts = 0;
+        // Сколько раз Enqueue ждал освобождения места в очереди
+        uint64_t producer_waits = 0;
+        // Сколько раз TryEnqueue не смог поместить запись в очередь
+        uint64_t rejected = 0;
+        // Сколько раз on_saved завершился исключением
+        uint64_t callback_failures = 0;
+        size_t queue_depth = 0;
+        size_t max_queue_depth = 0;
+        Duration last_batch_latency{};
+        Duration total_write_time{};
+    };
+
+    explicit RetiredPlayerWriter(RetiredPlayerRepository& repository)
+        : RetiredPlayerWriter(repository, Config{}) {
+    }
+
+    RetiredPlayerWriter(RetiredPlayerRepository& repository, Config config);
+
+    RetiredPlayerWriter(const RetiredPlayerWriter&) = delete;
+    RetiredPlayerWriter& operator=(const RetiredPlayerWriter&) = delete;
+
+    // Сохраняет все помещённые в очередь записи и останавливает поток записи
+    ~RetiredPlayerWriter();
+
+    // Помещает запись в очередь. Если очередь заполнена, ждёт освобождения места
+    void Enqueue(RetiredPlayer player);
+
+    // Помещает запись в очередь, если в ней есть место
+    [[nodiscard]] bool TryEnqueue(RetiredPlayer player);
+
+    // Ждёт, пока будут обработаны все записи, помещённые в очередь до вызова Flush
+    void Flush();
+
+    Metrics GetMetrics() const;
+
+private:
+    void Run(std::stop_token stop);
+    void WriteBatch(std::span<const RetiredPlayer> batch);
+    void PushLocked(RetiredPlayer&& player);
+
+    RetiredPlayerRepository& repository_;
+    Config config_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable_any has_records_;
+    std::condition_variable_any has_space_;
+    std::condition_variable_any processed_;
+    // Очередь заполняется производителями, поток записи забирает её целиком,
+    // обменивая с опустевшим буфером предыдущей пачки
+    std::vector<RetiredPlayer> pending_;
+    // Flush просит поток записи не дожидаться накопления пачки
+    bool flush_requested_ = false;
+    Metrics metrics_;
+
+    std::jthread worker_;
+};
+
+}  // namespace retirement
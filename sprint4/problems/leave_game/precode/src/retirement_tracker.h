@@ -0,0 +1,60 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "timer_wheel.h"
+
+namespace retirement {
+
+using DogId = uint32_t;
+
+/*
+ * Отслеживает простой собак и определяет, какие из них пора отправить на пенсию.
+ * Собака уходит на пенсию, если простояла без движения dogRetirementTime.
+ *
+ * Стоимость каждой операции не зависит от количества собак на карте,
+ * а Tick обрабатывает только собак, срок простоя которых истёк.
+ */
+class RetirementTracker {
+public:
+    using Duration = std::chrono::milliseconds;
+
+    explicit RetirementTracker(Duration retirement_time)
+        : retirement_time_{retirement_time} {
+    }
+
+    // Собака остановилась (или только что вошла в игру) в момент now
+    void OnDogStopped(DogId dog_id, Duration now) {
+        wheel_.Schedule(dog_id, now + retirement_time_);
+    }
+
+    // Собака начала движение: счётчик простоя сбрасывается
+    void OnDogMoved(DogId dog_id) {
+        wheel_.Cancel(dog_id);
+    }
+
+    // Собака покинула игру по другой причине
+    void OnDogRemoved(DogId dog_id) {
+        wheel_.Cancel(dog_id);
+    }
+
+    // Продвигает время до now и возвращает собак, которые должны уйти на пенсию
+    std::vector<DogId> Tick(Duration now) {
+        std::vector<DogId> retired;
+        wheel_.Advance(now, [&retired](DogId dog_id) {
+            retired.push_back(dog_id);
+        });
+        return retired;
+    }
+
+    size_t GetIdleDogCount() const noexcept {
+        return wheel_.Size();
+    }
+
+private:
+    Duration retirement_time_;
+    TimerWheel<DogId> wheel_;
+};
+
+}  // namespace retirement
@@ -0,0 +1,188 @@
+#pragma once
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace util {
+
+/*
+ * Упорядоченный список на основе skip list с доступом по порядковому номеру.
+ *
+ * Каждая ссылка хранит, на сколько элементов она перескакивает, поэтому вставка,
+ * удаление и поиск элемента по номеру выполняются за O(log n), а чтение страницы
+ * из k элементов, начиная с номера i, - за O(log n + k).
+ * Равные элементы хранятся в порядке вставки.
+ */
+template <typename T, typename Less = std::less<T>>
+class IndexableSkipList {
+public:
+    explicit IndexableSkipList(Less less = Less{})
+        : less_{std::move(less)} {
+        for (auto& link : head_.links) {
+            link = {nullptr, 1};
+        }
+    }
+
+    IndexableSkipList(const IndexableSkipList&) = delete;
+    IndexableSkipList& operator=(const IndexableSkipList&) = delete;
+
+    ~IndexableSkipList() {
+        Clear();
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Вставляет value и возвращает его порядковый номер
+    size_t Insert(T value) {
+        std::array<Node*, MAX_LEVEL> chain;
+        std::array<size_t, MAX_LEVEL> chain_steps;
+        Node* node = &head_;
+        size_t steps = 0;
+        for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+            // Проходим мимо равных элементов, чтобы сохранить порядок вставки
+            while (node->links[level].next && !less_(value, node->links[level].next->value)) {
+                steps += node->links[level].width;
+                node = node->links[level].next;
+            }
+            chain[level] = node;
+            chain_steps[level] = steps;
+        }
+
+        const int height = RandomHeight();
+        Node* inserted = new Node{std::move(value), height};
+        for (int level = 0; level < height; ++level) {
+            Link& prev = chain[level]->links[level];
+            const size_t distance = steps - chain_steps[level];
+            inserted->links[level] = {prev.next, prev.width - distance};
+            prev = {inserted, distance + 1};
+        }
+        for (int level = height; level < MAX_LEVEL; ++level) {
+            ++chain[level]->links[level].width;
+        }
+        ++size_;
+        return steps;
+    }
+
+    // Возвращает элемент с порядковым номером index < Size()
+    const T& At(size_t index) const {
+        return FindNode(index)->value;
+    }
+
+    // Удаляет элемент с порядковым номером index < Size()
+    void EraseAt(size_t index) {
+        assert(index < size_);
+        std::array<Node*, MAX_LEVEL> chain;
+        Node* node = &head_;
+        // Номер узла node, если считать head_ элементом с номером 0
+        size_t position = 0;
+        for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+            while (node->links[level].next && position + node->links[level].width <= index) {
+                position += node->links[level].width;
+                node = node->links[level].next;
+            }
+            chain[level] = node;
+        }
+
+        Node* erased = chain[0]->links[0].next;
+        for (int level = 0; level < MAX_LEVEL; ++level) {
+            Link& prev = chain[level]->links[level];
+            if (prev.next == erased) {
+                prev = {erased->links[level].next, prev.width + erased->links[level].width - 1};
+            } else {
+                --prev.width;
+            }
+        }
+        delete erased;
+        --size_;
+    }
+
+    // Добавляет в out не более count элементов, начиная с номера start
+    template <typename OutputIt>
+    OutputIt Copy(size_t start, size_t count, OutputIt out) const {
+        if (start >= size_) {
+            return out;
+        }
+        for (const Node* node = FindNode(start); node && count > 0; node = node->links[0].next) {
+            *out++ = node->value;
+            --count;
+        }
+        return out;
+    }
+
+    void Clear() noexcept {
+        Node* node = head_.links[0].next;
+        while (node) {
+            Node* next = node->links[0].next;
+            delete node;
+            node = next;
+        }
+        for (auto& link : head_.links) {
+            link = {nullptr, 1};
+        }
+        size_ = 0;
+    }
+
+private:
+    static constexpr int MAX_LEVEL = 16;
+
+    struct Node;
+
+    struct Link {
+        Node* next = nullptr;
+        // Разность порядковых номеров next и узла, которому принадлежит ссылка
+        size_t width = 1;
+    };
+
+    struct Node {
+        Node() = default;
+        Node(T v, int height)
+            : value(std::move(v))
+            , links(height) {
+        }
+
+        T value{};
+        std::vector<Link> links = std::vector<Link>(MAX_LEVEL);
+    };
+
+    const Node* FindNode(size_t index) const {
+        assert(index < size_);
+        const Node* node = &head_;
+        size_t position = 0;
+        // Номер узла считается с единицы, так как head_ имеет номер 0
+        const size_t target = index + 1;
+        for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+            while (node->links[level].next && position + node->links[level].width <= target) {
+                position += node->links[level].width;
+                node = node->links[level].next;
+            }
+        }
+        return node;
+    }
+
+    // Высота узла имеет геометрическое распределение с параметром 1/4
+    int RandomHeight() {
+        int height = 1;
+        uint32_t bits = random_();
+        while (height < MAX_LEVEL && (bits & 3) == 0) {
+            ++height;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    Less less_;
+    Node head_;
+    size_t size_ = 0;
+    std::minstd_rand random_{0x5eed};
+};
+
+}  // namespace util
@@ -0,0 +1,244 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace retirement {
+
+/*
+ * Иерархическое колесо таймеров.
+ *
+ * Хранит для каждого ключа (например, id собаки) момент срабатывания и позволяет
+ * за O(1) добавить, перенести или отменить таймер. Advance выдаёт только те ключи,
+ * чей срок истёк, не просматривая остальные.
+ *
+ * Время измеряется в тиках длительностью resolution от момента создания колеса.
+ * Нулевой уровень колеса содержит 256 слотов по одному тику, каждый следующий из
+ * трёх уровней - 64 слота, каждый из которых в 64 раза шире слота предыдущего уровня.
+ * Таймеры дальше 2^26 тиков от текущего момента хранятся на последнем уровне
+ * и перераспределяются по мере приближения срока.
+ */
+template <typename Key, typename Hasher = std::hash<Key>>
+class TimerWheel {
+public:
+    using Duration = std::chrono::milliseconds;
+
+    explicit TimerWheel(Duration resolution = Duration{1})
+        : resolution_{resolution} {
+        if (resolution_ <= Duration::zero()) {
+            throw std::invalid_argument("Timer wheel resolution must be positive");
+        }
+        slots_.fill(NIL);
+    }
+
+    // Устанавливает или переносит таймер key на момент deadline
+    void Schedule(const Key& key, Duration deadline) {
+        const uint64_t deadline_tick = ToTick(deadline);
+        if (auto it = key_to_node_.find(key); it != key_to_node_.end()) {
+            Unlink(it->second);
+            nodes_[it->second].deadline = deadline_tick;
+            Link(it->second, current_tick_ + 1);
+            return;
+        }
+
+        const uint32_t index = AllocateNode(key, deadline_tick);
+        try {
+            key_to_node_.emplace(key, index);
+        } catch (...) {
+            FreeNode(index);
+            throw;
+        }
+        // Слот текущего тика уже обработан, поэтому просроченные таймеры
+        // сработают на следующем тике
+        Link(index, current_tick_ + 1);
+    }
+
+    // Отменяет таймер key. Возвращает false, если таймер не был установлен
+    bool Cancel(const Key& key) {
+        auto it = key_to_node_.find(key);
+        if (it == key_to_node_.end()) {
+            return false;
+        }
+        Unlink(it->second);
+        FreeNode(it->second);
+        key_to_node_.erase(it);
+        return true;
+    }
+
+    bool Contains(const Key& key) const {
+        return key_to_node_.contains(key);
+    }
+
+    size_t Size() const noexcept {
+        return key_to_node_.size();
+    }
+
+    Duration GetTime() const noexcept {
+        return current_tick_ * resolution_;
+    }
+
+    /*
+     * Продвигает время колеса до момента now и вызывает on_expired(key) для каждого
+     * таймера, срок которого наступил. Сработавшие таймеры удаляются из колеса
+     * до вызова on_expired, поэтому внутри него можно снова вызывать Schedule.
+     */
+    template <typename Fn>
+    void Advance(Duration now, Fn&& on_expired) {
+        const uint64_t target_tick = now.count() / resolution_.count();
+        expired_.clear();
+        while (current_tick_ < target_tick) {
+            if (key_to_node_.empty()) {
+                current_tick_ = target_tick;
+                break;
+            }
+            ++current_tick_;
+            Cascade();
+            CollectSlot(static_cast<uint32_t>(current_tick_ & LEVEL0_MASK));
+        }
+        for (const Key& key : expired_) {
+            on_expired(key);
+        }
+    }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+    static constexpr int LEVEL0_BITS = 8;
+    static constexpr int LEVEL_BITS = 6;
+    static constexpr int LEVEL_COUNT = 4;
+    static constexpr uint64_t LEVEL0_SIZE = uint64_t{1} << LEVEL0_BITS;
+    static constexpr uint64_t LEVEL_SIZE = uint64_t{1} << LEVEL_BITS;
+    static constexpr uint64_t LEVEL0_MASK = LEVEL0_SIZE - 1;
+    static constexpr uint64_t LEVEL_MASK = LEVEL_SIZE - 1;
+    static constexpr uint64_t MAX_DELTA = uint64_t{1} << (LEVEL0_BITS + LEVEL_BITS * (LEVEL_COUNT - 1));
+    static constexpr size_t SLOT_COUNT = LEVEL0_SIZE + LEVEL_SIZE * (LEVEL_COUNT - 1);
+
+    struct Node {
+        Key key;
+        uint64_t deadline;
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+        uint32_t slot = NIL;
+    };
+
+    uint64_t ToTick(Duration time) const {
+        const auto ticks = (time.count() + resolution_.count() - 1) / resolution_.count();
+        return ticks > 0 ? static_cast<uint64_t>(ticks) : 0;
+    }
+
+    // Номер слота, в который попадает таймер со сроком deadline.
+    // Таймеры со сроком раньше earliest попадают в слот тика earliest
+    uint32_t SlotFor(uint64_t deadline, uint64_t earliest) const noexcept {
+        deadline = std::max(deadline, earliest);
+        uint64_t delta = deadline - current_tick_;
+        if (delta < LEVEL0_SIZE) {
+            return static_cast<uint32_t>(deadline & LEVEL0_MASK);
+        }
+        if (delta >= MAX_DELTA) {
+            deadline = current_tick_ + MAX_DELTA - 1;
+            delta = MAX_DELTA - 1;
+        }
+        uint32_t level_offset = LEVEL0_SIZE;
+        int shift = LEVEL0_BITS;
+        for (int level = 1; level < LEVEL_COUNT; ++level, shift += LEVEL_BITS) {
+            if (delta < (uint64_t{1} << (shift + LEVEL_BITS)) || level == LEVEL_COUNT - 1) {
+                return level_offset + static_cast<uint32_t>((deadline >> shift) & LEVEL_MASK);
+            }
+            level_offset += LEVEL_SIZE;
+        }
+        return level_offset - LEVEL_SIZE;
+    }
+
+    void Link(uint32_t index, uint64_t earliest) {
+        Node& node = nodes_[index];
+        node.slot = SlotFor(node.deadline, earliest);
+        node.prev = NIL;
+        node.next = slots_[node.slot];
+        if (node.next != NIL) {
+            nodes_[node.next].prev = index;
+        }
+        slots_[node.slot] = index;
+    }
+
+    void Unlink(uint32_t index) {
+        Node& node = nodes_[index];
+        if (node.prev != NIL) {
+            nodes_[node.prev].next = node.next;
+        } else {
+            slots_[node.slot] = node.next;
+        }
+        if (node.next != NIL) {
+            nodes_[node.next].prev = node.prev;
+        }
+        node.prev = node.next = node.slot = NIL;
+    }
+
+    uint32_t AllocateNode(const Key& key, uint64_t deadline) {
+        if (free_head_ != NIL) {
+            const uint32_t index = free_head_;
+            free_head_ = nodes_[index].next;
+            nodes_[index] = Node{key, deadline};
+            return index;
+        }
+        nodes_.push_back(Node{key, deadline});
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+
+    void FreeNode(uint32_t index) noexcept {
+        nodes_[index].next = free_head_;
+        free_head_ = index;
+    }
+
+    // Когда младший уровень совершает полный оборот, таймеры из очередного слота
+    // следующего уровня перераспределяются по более мелким слотам
+    void Cascade() {
+        uint64_t tick = current_tick_;
+        if ((tick & LEVEL0_MASK) != 0) {
+            return;
+        }
+        tick >>= LEVEL0_BITS;
+        uint32_t level_offset = LEVEL0_SIZE;
+        for (int level = 1; level < LEVEL_COUNT; ++level) {
+            const uint32_t slot = level_offset + static_cast<uint32_t>(tick & LEVEL_MASK);
+            uint32_t index = slots_[slot];
+            slots_[slot] = NIL;
+            while (index != NIL) {
+                const uint32_t next = nodes_[index].next;
+                // Таймеры текущего тика попадают в слот, который будет обработан следом
+                Link(index, current_tick_);
+                index = next;
+            }
+            if ((tick & LEVEL_MASK) != 0) {
+                break;
+            }
+            tick >>= LEVEL_BITS;
+            level_offset += LEVEL_SIZE;
+        }
+    }
+
+    void CollectSlot(uint32_t slot) {
+        uint32_t index = slots_[slot];
+        slots_[slot] = NIL;
+        while (index != NIL) {
+            const uint32_t next = nodes_[index].next;
+            expired_.push_back(nodes_[index].key);
+            key_to_node_.erase(nodes_[index].key);
+            FreeNode(index);
+            index = next;
+        }
+    }
+
+    Duration resolution_;
+    uint64_t current_tick_ = 0;
+    std::array<uint32_t, SLOT_COUNT> slots_;
+    std::vector<Node> nodes_;
+    uint32_t free_head_ = NIL;
+    std::unordered_map<Key, uint32_t, Hasher> key_to_node_;
+    std::vector<Key> expired_;
+};
+
+}  // namespace retirement
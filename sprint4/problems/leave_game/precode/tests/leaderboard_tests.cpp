@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/leaderboard.h"
+#include "../src/skip_list.h"
+
+using namespace std::literals;
+
+namespace {
+
+using retirement::RecordOrder;
+using retirement::RetiredPlayer;
+
+// Хранилище в памяти, возвращающее записи так же, как ORDER BY ... OFFSET ... LIMIT
+class SortedRepository : public retirement::RetiredPlayerRepository {
+public:
+    void SaveBatch(std::span<const RetiredPlayer> players) override {
+        records_.insert(records_.end(), players.begin(), players.end());
+        std::stable_sort(records_.begin(), records_.end(), RecordOrder{});
+    }
+
+    std::vector<RetiredPlayer> GetRecords(size_t start, size_t max_items) override {
+        ++reads;
+        if (start >= records_.size()) {
+            return {};
+        }
+        const auto first = records_.begin() + start;
+        return {first, first + std::min(max_items, records_.size() - start)};
+    }
+
+    int reads = 0;
+
+private:
+    std::vector<RetiredPlayer> records_;
+};
+
+RetiredPlayer MakePlayer(std::mt19937& rng, int i) {
+    std::uniform_int_distribution<unsigned> score{0, 50};
+    std::uniform_int_distribution<int> play_time{0, 20};
+    return {"dog"s + std::to_string(i), score(rng), std::chrono::seconds{play_time(rng)}};
+}
+
+}  // namespace
+
+SCENARIO("Indexable skip list") {
+    GIVEN("a skip list filled with random values") {
+        util::IndexableSkipList<int> list;
+        std::vector<int> expected;
+        std::mt19937 rng{1};
+        std::uniform_int_distribution<int> value{0, 1000};
+        for (int i = 0; i < 2000; ++i) {
+            const int v = value(rng);
+            const size_t index = list.Insert(v);
+            const auto pos = std::upper_bound(expected.begin(), expected.end(), v);
+            REQUIRE(index == static_cast<size_t>(pos - expected.begin()));
+            expected.insert(pos, v);
+        }
+
+        THEN("elements are accessible by index in sorted order") {
+            REQUIRE(list.Size() == expected.size());
+            for (size_t i = 0; i < expected.size(); i += 37) {
+                REQUIRE(list.At(i) == expected[i]);
+            }
+        }
+
+        WHEN("elements are erased by index") {
+            for (int i = 0; i < 1000; ++i) {
+                const size_t index = rng() % expected.size();
+                list.EraseAt(index);
+                expected.erase(expected.begin() + index);
+            }
+
+            THEN("pages match the remaining elements") {
+                std::vector<int> page;
+                list.Copy(500, 100, std::back_inserter(page));
+                CHECK(page == std::vector(expected.begin() + 500, expected.begin() + 600));
+
+                page.clear();
+                list.Copy(expected.size() - 10, 100, std::back_inserter(page));
+                CHECK(page == std::vector(expected.end() - 10, expected.end()));
+            }
+        }
+    }
+}
+
+SCENARIO("Leaderboard") {
+    std::mt19937 rng{42};
+    SortedRepository repository;
+
+    GIVEN("a repository with more records than the cache can hold") {
+        std::vector<RetiredPlayer> initial;
+        for (int i = 0; i < 300; ++i) {
+            initial.push_back(MakePlayer(rng, i));
+        }
+        repository.SaveBatch(initial);
+
+        retirement::Leaderboard leaderboard{repository, 100};
+        leaderboard.Warm();
+        repository.reads = 0;
+
+        WHEN("new records are saved") {
+            for (int i = 300; i < 400; ++i) {
+                const std::vector players{MakePlayer(rng, i)};
+                repository.SaveBatch(players);
+                leaderboard.Add(players);
+            }
+
+            THEN("pages within the cache are served from memory") {
+                CHECK(leaderboard.GetCachedCount() == 100);
+                CHECK(leaderboard.GetRecords(0, 100) == repository.GetRecords(0, 100));
+                CHECK(leaderboard.GetRecords(37, 20) == repository.GetRecords(37, 20));
+                CHECK(leaderboard.GetStats().cache_hits == 2);
+            }
+
+            THEN("pages beyond the cache are read from the repository") {
+                CHECK(leaderboard.GetRecords(90, 20) == repository.GetRecords(90, 20));
+                CHECK(leaderboard.GetStats().repository_reads == 1);
+            }
+        }
+    }
+
+    GIVEN("a repository with fewer records than the cache can hold") {
+        std::vector<RetiredPlayer> initial;
+        for (int i = 0; i < 30; ++i) {
+            initial.push_back(MakePlayer(rng, i));
+        }
+        repository.SaveBatch(initial);
+
+        retirement::Leaderboard leaderboard{repository, 100};
+        leaderboard.Warm();
+
+        THEN("every page is served from memory") {
+            CHECK(leaderboard.GetRecords(20, 100) == repository.GetRecords(20, 100));
+            CHECK(leaderboard.GetRecords(200, 100).empty());
+            CHECK(leaderboard.GetStats().repository_reads == 0);
+        }
+    }
+}
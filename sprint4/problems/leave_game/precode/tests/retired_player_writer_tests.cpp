@@ -0,0 +1,198 @@
+#include <catch2/catch_test_macros.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/retired_player_writer.h"
+
+using namespace std::literals;
+
+namespace {
+
+using retirement::RetiredPlayer;
+using retirement::RetiredPlayerWriter;
+
+// Хранилище в памяти вместо базы данных
+class InMemoryRepository : public retirement::RetiredPlayerRepository {
+public:
+    void SaveBatch(std::span<const RetiredPlayer> players) override {
+        std::unique_lock lock{mutex_};
+        opened_.wait(lock, [this] {
+            return open_;
+        });
+        if (failures_left_ > 0) {
+            --failures_left_;
+            throw std::runtime_error("Connection lost");
+        }
+        batch_sizes_.push_back(players.size());
+        players_.insert(players_.end(), players.begin(), players.end());
+    }
+
+    std::vector<RetiredPlayer> GetRecords(size_t, size_t) override {
+        return {};
+    }
+
+    void SetOpen(bool open) {
+        {
+            std::lock_guard lock{mutex_};
+            open_ = open;
+        }
+        opened_.notify_all();
+    }
+
+    void FailNext(unsigned count) {
+        std::lock_guard lock{mutex_};
+        failures_left_ = count;
+    }
+
+    std::vector<RetiredPlayer> GetPlayers() const {
+        std::lock_guard lock{mutex_};
+        return players_;
+    }
+
+    std::vector<size_t> GetBatchSizes() const {
+        std::lock_guard lock{mutex_};
+        return batch_sizes_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable opened_;
+    bool open_ = true;
+    unsigned failures_left_ = 0;
+    std::vector<RetiredPlayer> players_;
+    std::vector<size_t> batch_sizes_;
+};
+
+RetiredPlayer MakePlayer(int i) {
+    return {"dog"s + std::to_string(i), static_cast<unsigned>(i), std::chrono::milliseconds{i}};
+}
+
+}  // namespace
+
+SCENARIO("Retired player writer") {
+    GIVEN("a writer with small batches") {
+        InMemoryRepository repository;
+        RetiredPlayerWriter::Config config;
+        config.max_batch_size = 8;
+        config.queue_capacity = 64;
+        config.retry_delay = 1ms;
+
+        WHEN("players are enqueued and flushed") {
+            RetiredPlayerWriter writer{repository, config};
+            std::vector<RetiredPlayer> expected;
+            for (int i = 0; i < 50; ++i) {
+                expected.push_back(MakePlayer(i));
+                writer.Enqueue(MakePlayer(i));
+            }
+            writer.Flush();
+
+            THEN("all of them are saved in order in bounded batches") {
+                CHECK(repository.GetPlayers() == expected);
+                for (size_t size : repository.GetBatchSizes()) {
+                    CHECK(size <= config.max_batch_size);
+                }
+                const auto metrics = writer.GetMetrics();
+                CHECK(metrics.enqueued == 50);
+                CHECK(metrics.written == 50);
+                CHECK(metrics.dropped == 0);
+                CHECK(metrics.batches == repository.GetBatchSizes().size());
+            }
+        }
+
+        WHEN("the writer is destroyed") {
+            {
+                RetiredPlayerWriter writer{repository, config};
+                for (int i = 0; i < 20; ++i) {
+                    writer.Enqueue(MakePlayer(i));
+                }
+            }
+
+            THEN("pending players are saved") {
+                CHECK(repository.GetPlayers().size() == 20);
+            }
+        }
+
+        WHEN("a handler of saved batches is set") {
+            std::vector<RetiredPlayer> saved;
+            config.on_saved = [&saved](std::span<const RetiredPlayer> batch) {
+                saved.insert(saved.end(), batch.begin(), batch.end());
+            };
+            RetiredPlayerWriter writer{repository, config};
+            for (int i = 0; i < 20; ++i) {
+                writer.Enqueue(MakePlayer(i));
+            }
+            writer.Flush();
+
+            THEN("it receives every saved player") {
+                CHECK(saved == repository.GetPlayers());
+                CHECK(saved.size() == 20);
+            }
+        }
+
+        WHEN("the handler of saved batches throws") {
+            config.on_saved = [](std::span<const RetiredPlayer>) {
+                throw std::runtime_error("handler failed");
+            };
+            RetiredPlayerWriter writer{repository, config};
+            for (int i = 0; i < 20; ++i) {
+                writer.Enqueue(MakePlayer(i));
+            }
+            writer.Flush();
+
+            THEN("the players are saved and the failures are counted") {
+                CHECK(repository.GetPlayers().size() == 20);
+                const auto metrics = writer.GetMetrics();
+                CHECK(metrics.written == 20);
+                CHECK(metrics.callback_failures == metrics.batches);
+                CHECK(metrics.callback_failures > 0);
+            }
+        }
+
+        WHEN("the repository fails temporarily") {
+            RetiredPlayerWriter writer{repository, config};
+            repository.FailNext(config.max_attempts - 1);
+            writer.Enqueue(MakePlayer(1));
+            writer.Flush();
+
+            THEN("the batch is retried") {
+                CHECK(repository.GetPlayers() == std::vector{MakePlayer(1)});
+                CHECK(writer.GetMetrics().failed_attempts == config.max_attempts - 1);
+            }
+        }
+
+        WHEN("the repository keeps failing") {
+            RetiredPlayerWriter writer{repository, config};
+            repository.FailNext(config.max_attempts);
+            writer.Enqueue(MakePlayer(1));
+            writer.Flush();
+
+            THEN("the batch is dropped after all attempts") {
+                CHECK(repository.GetPlayers().empty());
+                CHECK(writer.GetMetrics().dropped == 1);
+            }
+        }
+
+        WHEN("the repository is too slow") {
+            repository.SetOpen(false);
+            RetiredPlayerWriter writer{repository, config};
+
+            THEN("the queue applies backpressure") {
+                // Первая пачка может быть уже забрана потоком записи
+                size_t accepted = 0;
+                for (int i = 0; i < 200; ++i) {
+                    accepted += writer.TryEnqueue(MakePlayer(i)) ? 1 : 0;
+                }
+                CHECK(accepted <= 2 * config.queue_capacity);
+                CHECK(accepted >= config.queue_capacity);
+                CHECK(writer.GetMetrics().rejected == 200 - accepted);
+
+                repository.SetOpen(true);
+                writer.Flush();
+                CHECK(repository.GetPlayers().size() == accepted);
+            }
+        }
+    }
+}
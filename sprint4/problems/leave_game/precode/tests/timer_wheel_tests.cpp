@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "../src/retirement_tracker.h"
+#include "../src/timer_wheel.h"
+
+using namespace std::literals;
+
+namespace {
+
+using Wheel = retirement::TimerWheel<int>;
+
+std::vector<int> AdvanceTo(Wheel& wheel, Wheel::Duration now) {
+    std::vector<int> expired;
+    wheel.Advance(now, [&expired](int key) {
+        expired.push_back(key);
+    });
+    std::sort(expired.begin(), expired.end());
+    return expired;
+}
+
+}  // namespace
+
+SCENARIO("Timer wheel") {
+    GIVEN("a timer wheel") {
+        Wheel wheel;
+
+        WHEN("timers are scheduled at different distances") {
+            wheel.Schedule(1, 10ms);
+            wheel.Schedule(2, 300ms);
+            wheel.Schedule(3, 20s);
+            wheel.Schedule(4, 30min);
+            wheel.Schedule(5, 48h);
+
+            THEN("each timer expires exactly when its deadline is reached") {
+                CHECK(AdvanceTo(wheel, 9ms).empty());
+                CHECK(AdvanceTo(wheel, 10ms) == std::vector{1});
+                CHECK(AdvanceTo(wheel, 299ms).empty());
+                CHECK(AdvanceTo(wheel, 300ms) == std::vector{2});
+                CHECK(AdvanceTo(wheel, 20s - 1ms).empty());
+                CHECK(AdvanceTo(wheel, 20s) == std::vector{3});
+                CHECK(AdvanceTo(wheel, 30min - 1ms).empty());
+                CHECK(AdvanceTo(wheel, 30min) == std::vector{4});
+                CHECK(AdvanceTo(wheel, 48h - 1ms).empty());
+                CHECK(AdvanceTo(wheel, 48h) == std::vector{5});
+                CHECK(wheel.Size() == 0);
+            }
+        }
+
+        WHEN("a timer is rescheduled") {
+            wheel.Schedule(1, 100ms);
+            wheel.Schedule(1, 5s);
+
+            THEN("it expires only at the new deadline") {
+                CHECK(AdvanceTo(wheel, 1s).empty());
+                CHECK(AdvanceTo(wheel, 5s) == std::vector{1});
+            }
+        }
+
+        WHEN("a timer is cancelled") {
+            wheel.Schedule(1, 100ms);
+            wheel.Schedule(2, 100ms);
+            CHECK(wheel.Cancel(1));
+            CHECK_FALSE(wheel.Cancel(1));
+
+            THEN("it never expires") {
+                CHECK(AdvanceTo(wheel, 1s) == std::vector{2});
+            }
+        }
+
+        WHEN("a timer is scheduled in the past") {
+            AdvanceTo(wheel, 1s);
+            wheel.Schedule(1, 500ms);
+
+            THEN("it expires on the next tick") {
+                CHECK(AdvanceTo(wheel, 1001ms) == std::vector{1});
+            }
+        }
+    }
+
+    GIVEN("many random timers") {
+        Wheel wheel;
+        std::mt19937 rng{42};
+        std::uniform_int_distribution<int> deadline_dist{0, 100'000};
+        std::multimap<int, int> expected;
+        for (int key = 0; key < 5000; ++key) {
+            // Несколько таймеров со сроком 0, который случайные сроки почти не дают
+            const int deadline = key < 10 ? 0 : deadline_dist(rng);
+            wheel.Schedule(key, std::chrono::milliseconds{deadline});
+            // Колесо начинает с тика 0 и проверяет сроки, начиная с тика 1,
+            // поэтому уже истёкшие таймеры срабатывают на первом тике
+            expected.emplace(std::max(deadline, 1), key);
+        }
+
+        THEN("advancing in uneven steps yields every timer in its window") {
+            int now = 0;
+            std::uniform_int_distribution<int> step_dist{1, 3000};
+            while (now < 100'000) {
+                const int next = now + step_dist(rng);
+                std::vector<int> window;
+                for (auto it = expected.upper_bound(now); it != expected.upper_bound(next); ++it) {
+                    window.push_back(it->second);
+                }
+                std::sort(window.begin(), window.end());
+                REQUIRE(AdvanceTo(wheel, std::chrono::milliseconds{next}) == window);
+                now = next;
+            }
+            CHECK(wheel.Size() == 0);
+        }
+    }
+}
+
+SCENARIO("Dog retirement") {
+    using retirement::DogId;
+    using retirement::RetirementTracker;
+
+    GIVEN("a retirement tracker") {
+        RetirementTracker tracker{15s};
+
+        WHEN("dogs stop at different times") {
+            tracker.OnDogStopped(1, 0ms);
+            tracker.OnDogStopped(2, 5s);
+
+            THEN("each retires after standing still for the retirement time") {
+                CHECK(tracker.Tick(14999ms).empty());
+                CHECK(tracker.Tick(15s) == std::vector<DogId>{1});
+                CHECK(tracker.Tick(20s) == std::vector<DogId>{2});
+                CHECK(tracker.GetIdleDogCount() == 0);
+            }
+        }
+
+        WHEN("a dog moves before its deadline") {
+            tracker.OnDogStopped(1, 0ms);
+            tracker.Tick(10s);
+            tracker.OnDogMoved(1);
+            tracker.OnDogStopped(1, 12s);
+
+            THEN("its idle time starts over") {
+                CHECK(tracker.Tick(26s).empty());
+                CHECK(tracker.Tick(27s) == std::vector<DogId>{1});
+            }
+        }
+    }
+}
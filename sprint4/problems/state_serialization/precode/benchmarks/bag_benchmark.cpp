@@ -0,0 +1,111 @@
+#include <chrono>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "../src/model.h"
+
+/*
+ * Измеряет время тика сбора и сдачи трофеев для 100000 собак:
+ * каждая собака пытается подобрать предмет, а каждый четвёртый тик сдаёт рюкзак.
+ * Сравнивает рюкзак model::Dog со встроенным буфером и рюкзак на std::vector.
+ */
+
+using namespace std::literals;
+
+namespace {
+
+constexpr size_t DOG_COUNT = 100'000;
+constexpr size_t BAG_CAPACITY = 3;
+constexpr int TICK_COUNT = 200;
+
+// Собака с прежним рюкзаком на std::vector
+class VectorBagDog {
+public:
+    explicit VectorBagDog(size_t bag_cap)
+        : bag_cap_(bag_cap) {
+        bag_.reserve(bag_cap);
+    }
+
+    bool PutToBag(model::FoundObject item) {
+        if (IsBagFull()) {
+            return false;
+        }
+        bag_.push_back(item);
+        return true;
+    }
+
+    size_t EmptyBag() noexcept {
+        auto res = bag_.size();
+        bag_.clear();
+        return res;
+    }
+
+    bool IsBagFull() const noexcept {
+        return bag_.size() >= bag_cap_;
+    }
+
+    void AddScore(model::Score score) noexcept {
+        score_ += score;
+    }
+
+    model::Score GetScore() const noexcept {
+        return score_;
+    }
+
+private:
+    // Поля, через которые проходит собака из model::Dog, чтобы расположение было похожим
+    char other_fields_[96] = {};
+    std::vector<model::FoundObject> bag_;
+    size_t bag_cap_;
+    model::Score score_ = 0;
+};
+
+template <typename Dog>
+double RunTicks(std::vector<Dog>& dogs) {
+    const auto start = std::chrono::steady_clock::now();
+    uint32_t next_id = 0;
+    for (int tick = 0; tick < TICK_COUNT; ++tick) {
+        const bool at_base = tick % 4 == 3;
+        for (auto& dog : dogs) {
+            if (at_base) {
+                dog.AddScore(static_cast<model::Score>(dog.EmptyBag()));
+            } else if (!dog.IsBagFull()) {
+                (void)dog.PutToBag({model::FoundObject::Id{next_id++}, 0});
+            }
+        }
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+               .count()
+         / TICK_COUNT;
+}
+
+template <typename Dog>
+void Report(std::string_view name, std::vector<Dog>& dogs) {
+    const double tick_ms = RunTicks(dogs);
+    uint64_t total_score = 0;
+    for (const auto& dog : dogs) {
+        total_score += dog.GetScore();
+    }
+    std::cout << name << ": "sv << tick_ms << " ms per tick (score "sv << total_score << ")"sv
+              << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    model::NameTable names;
+    const auto name = names.Intern("Dog"sv);
+
+    std::vector<VectorBagDog> vector_dogs;
+    std::vector<model::Dog> inline_dogs;
+    vector_dogs.reserve(DOG_COUNT);
+    inline_dogs.reserve(DOG_COUNT);
+    for (uint32_t id = 0; id < DOG_COUNT; ++id) {
+        vector_dogs.emplace_back(BAG_CAPACITY);
+        inline_dogs.emplace_back(model::Dog::Id{id}, names, name, geom::Point2D{}, BAG_CAPACITY);
+    }
+
+    Report("std::vector bag"sv, vector_dogs);
+    Report("inline bag"sv, inline_dogs);
+}
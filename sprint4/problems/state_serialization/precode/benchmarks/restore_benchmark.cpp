@@ -0,0 +1,104 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string_view>
+
+#include "../src/binary_archive.h"
+#include "../src/flat_snapshot.h"
+#include "../src/model_serialization.h"
+
+/*
+ * Сравнивает время перезапуска сервера с 1000000 собак: загрузку двоичного снимка
+ * с восстановлением собак через DogRepr::Restore и загрузку плоского снимка через mmap.
+ */
+
+using namespace std::literals;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t DOG_COUNT = 1'000'000;
+
+// Собаки ссылаются на имена в names, поэтому таблица должна пережить их
+std::vector<model::Dog> MakeDogs(model::NameTable& names) {
+    std::vector<model::Dog> dogs;
+    dogs.reserve(DOG_COUNT);
+    for (uint32_t id = 0; id < DOG_COUNT; ++id) {
+        auto& dog = dogs.emplace_back(model::Dog::Id{id}, names,
+                                      names.Intern("Dog #"s + std::to_string(id)),
+                                      geom::Point2D{id * 0.37, id * 0.11}, 3);
+        dog.SetSpeed({1.5, -0.25});
+        dog.AddScore(id % 1000);
+        for (uint32_t i = 0; i < id % 4; ++i) {
+            (void)dog.PutToBag({model::FoundObject::Id{id * 4 + i}, i});
+        }
+    }
+    return dogs;
+}
+
+template <typename Fn>
+double MeasureMs(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+}  // namespace
+
+int main() {
+    const auto dir = fs::temp_directory_path();
+    const auto binary_path = dir / "restore_benchmark.snapshot";
+    const auto flat_path = dir / "restore_benchmark.flat";
+
+    {
+        model::NameTable names;
+        const auto dogs = MakeDogs(names);
+        serialization::GameStateRepr state;
+        state.dogs.reserve(dogs.size());
+        serialization::FlatSnapshotBuilder builder;
+        builder.Reserve(dogs.size());
+        for (const auto& dog : dogs) {
+            state.dogs.emplace_back(dog);
+            builder.AddDog(dog);
+        }
+        std::ofstream output{binary_path, std::ios::binary};
+        serialization::BinaryOutputArchive{output} << state;
+        builder.WriteTo(flat_path);
+    }
+
+    size_t restored_count = 0;
+    const double binary_ms = MeasureMs([&] {
+        std::ifstream input{binary_path, std::ios::binary};
+        serialization::GameStateRepr state;
+        serialization::BinaryInputArchive{input} >> state;
+        model::NameTable names;
+        std::vector<model::Dog> dogs;
+        dogs.reserve(state.dogs.size());
+        for (const auto& dog : state.dogs) {
+            dogs.push_back(dog.Restore(names));
+        }
+        restored_count = dogs.size();
+    });
+    std::cout << "binary snapshot + DogRepr::Restore: "sv << binary_ms << " ms, "sv
+              << restored_count << " dogs, "sv << fs::file_size(binary_path) << " bytes"sv
+              << std::endl;
+
+    double validate_ms = 0;
+    const double flat_ms = MeasureMs([&] {
+        std::optional<serialization::MappedFlatSnapshot> snapshot;
+        validate_ms = MeasureMs([&] {
+            snapshot.emplace(flat_path);
+        });
+        model::NameTable names;
+        restored_count = snapshot->RestoreDogs(names).size();
+    });
+    std::cout << "mapped flat snapshot: "sv << flat_ms << " ms (validation "sv << validate_ms
+              << " ms), "sv << restored_count << " dogs, "sv << fs::file_size(flat_path)
+              << " bytes"sv << std::endl;
+
+    fs::remove(binary_path);
+    fs::remove(flat_path);
+}
@@ -0,0 +1,76 @@
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+
+#include "../src/binary_archive.h"
+#include "../src/model.h"
+#include "../src/model_serialization.h"
+
+/*
+ * Сравнивает время сохранения и загрузки, а также размер снимка состояния
+ * из 100000 собак в текстовом архиве Boost и в двоичном формате.
+ */
+
+using namespace std::literals;
+
+namespace {
+
+constexpr uint32_t DOG_COUNT = 100'000;
+
+serialization::GameStateRepr MakeState() {
+    serialization::GameStateRepr state;
+    state.dogs.reserve(DOG_COUNT);
+    state.players.reserve(DOG_COUNT);
+    for (uint32_t id = 0; id < DOG_COUNT; ++id) {
+        model::Dog dog{model::Dog::Id{id}, "Dog #"s + std::to_string(id),
+                       {id * 0.37, id * 0.11}, 3};
+        dog.SetSpeed({1.5, -0.25});
+        dog.AddScore(id % 1000);
+        for (uint32_t i = 0; i < id % 4; ++i) {
+            (void)dog.PutToBag({model::FoundObject::Id{id * 4 + i}, i});
+        }
+        state.dogs.emplace_back(dog);
+        state.players.push_back({"0123456789abcdef0123456789abcdef"s, id});
+    }
+    return state;
+}
+
+template <typename Fn>
+double MeasureMs(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+template <typename OutputArchive, typename InputArchive>
+void RunBenchmark(std::string_view name, const serialization::GameStateRepr& state) {
+    std::stringstream strm;
+    const double save_ms = MeasureMs([&] {
+        OutputArchive output_archive{strm};
+        output_archive << state;
+    });
+    const size_t size = strm.str().size();
+
+    serialization::GameStateRepr restored;
+    const double load_ms = MeasureMs([&] {
+        InputArchive input_archive{strm};
+        input_archive >> restored;
+    });
+
+    std::cout << name << ": save "sv << save_ms << " ms, load "sv << load_ms << " ms, size "sv
+              << size << " bytes"sv << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    const auto state = MakeState();
+    RunBenchmark<boost::archive::text_oarchive, boost::archive::text_iarchive>("text archive"sv,
+                                                                               state);
+    RunBenchmark<serialization::BinaryOutputArchive, serialization::BinaryInputArchive>(
+        "binary snapshot"sv, state);
+}
@@ -0,0 +1,435 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <boost/serialization/version.hpp>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "crc32.h"
+
+namespace serialization {
+
+/*
+ * Компактный двоичный формат снимка состояния.
+ *
+ * Архивы совместимы с функциями serialize, написанными для архивов Boost:
+ * объект сериализуется вызовом его метода serialize(ar, version) или свободной
+ * функции serialize(ar, obj, version), найденной по ADL.
+ *
+ * Каждый объект, записанный в архив оператором <<, образует отдельный кадр:
+ *   magic (u32) | версия формата (u32) | размер данных (u64) | CRC32 данных (u32) | данные
+ * Числа записываются в little-endian с шириной своего типа: bool - одним байтом,
+ * целые и перечисления - sizeof байт, float и double - 32 и 64 битами IEEE 754.
+ * Поэтому снимок читается программой, в которой типы полей имеют те же размеры,
+ * что и в записавшей его (size_t и long занимают 8 байт на 64-битных платформах).
+ * Строки и векторы записываются с префиксом длины (u64).
+ *
+ * Перед первым объектом каждого класса в кадре записывается версия класса (u8),
+ * заданная BOOST_CLASS_VERSION, и при чтении она передаётся в serialize, как это
+ * делают архивы Boost.
+ *
+ * Заголовок кадра не защищён контрольной суммой, поэтому размер данных из него
+ * не используется для выделения памяти заранее: данные читаются частями
+ * по READ_CHUNK_SIZE байт, и буфер растёт только по мере их поступления.
+ */
+class BinaryArchiveBase {
+public:
+    static constexpr uint32_t MAGIC = 0x504E5344;  // "DSNP"
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 4 + 4 + 8 + 4;
+    static constexpr size_t READ_CHUNK_SIZE = 1 << 20;
+
+protected:
+    // Целое без знака той же ширины, что и T, которым число представлено в архиве
+    template <typename T>
+    static auto GetWireType() noexcept {
+        static_assert(std::is_arithmetic_v<T>);
+        static_assert(!std::is_floating_point_v<T> || std::numeric_limits<T>::is_iec559);
+        static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+        if constexpr (sizeof(T) == 1) {
+            return uint8_t{};
+        } else if constexpr (sizeof(T) == 2) {
+            return uint16_t{};
+        } else if constexpr (sizeof(T) == 4) {
+            return uint32_t{};
+        } else {
+            return uint64_t{};
+        }
+    }
+
+    template <typename T>
+    using WireType = decltype(GetWireType<T>());
+
+    // Последовательность таких чисел в памяти совпадает с их представлением в архиве
+    template <typename T>
+    static constexpr bool IsBulkCopyable() noexcept {
+        return std::is_arithmetic_v<T> && !std::is_same_v<T, bool>
+            && std::endian::native == std::endian::little;
+    }
+
+    // Версия неизвестна: класс ещё не встречался в текущем кадре
+    static constexpr int UNKNOWN_VERSION = -1;
+
+    // Порядковый номер класса T, под которым хранится его версия в текущем кадре
+    template <typename T>
+    static size_t GetClassSlot() noexcept {
+        static const size_t slot = next_class_slot_++;
+        return slot;
+    }
+
+private:
+    inline static std::atomic<size_t> next_class_slot_{0};
+};
+
+class BinaryOutputArchive : public BinaryArchiveBase {
+public:
+    // Совместимость с функциями serialize, различающими сохранение и загрузку
+    using is_saving = std::true_type;
+    using is_loading = std::false_type;
+
+    explicit BinaryOutputArchive(std::ostream& output)
+        : output_{output} {
+    }
+
+    template <typename T>
+    BinaryOutputArchive& operator<<(const T& value) {
+        if (depth_ > 0) {
+            Save(value);
+            return *this;
+        }
+
+        buffer_.clear();
+        class_versions_.clear();
+        ++depth_;
+        try {
+            Save(value);
+        } catch (...) {
+            --depth_;
+            throw;
+        }
+        --depth_;
+        WriteFrame();
+        return *this;
+    }
+
+    template <typename T>
+    BinaryOutputArchive& operator&(const T& value) {
+        return *this << value;
+    }
+
+    // Размер данных последнего записанного кадра без заголовка
+    size_t GetLastFrameSize() const noexcept {
+        return buffer_.size();
+    }
+
+    // Записывает последовательность байт в том же виде, что и std::string
+    void SaveBytes(std::string_view bytes) {
+        SaveUnsigned(uint64_t{bytes.size()});
+        buffer_.append(bytes);
+    }
+
+    // Записывает в том же виде, что и std::string, последовательность байт,
+    // которую функция write(std::string&) дописывает прямо в буфер кадра
+    template <typename Write>
+    void SaveBytesWith(Write&& write) {
+        const size_t size_pos = buffer_.size();
+        SaveUnsigned(uint64_t{0});
+        const size_t start = buffer_.size();
+        write(buffer_);
+        uint64_t size = buffer_.size() - start;
+        for (size_t i = 0; i < sizeof(size); ++i, size >>= 8) {
+            buffer_[size_pos + i] = static_cast<char>(size & 0xFF);
+        }
+    }
+
+private:
+    template <typename T>
+    void Save(const T& value) {
+        if constexpr (std::is_enum_v<T>) {
+            Save(static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            SaveUnsigned(std::bit_cast<WireType<T>>(value));
+        } else {
+            SaveObject(value);
+        }
+    }
+
+    void Save(const std::string& str) {
+        SaveBytes(str);
+    }
+
+    template <typename T, typename Alloc>
+    void Save(const std::vector<T, Alloc>& vec) {
+        SaveUnsigned(uint64_t{vec.size()});
+        if constexpr (IsBulkCopyable<T>()) {
+            buffer_.append(reinterpret_cast<const char*>(vec.data()), vec.size() * sizeof(T));
+        } else {
+            for (const auto& item : vec) {
+                Save(item);
+            }
+        }
+    }
+
+    template <typename T>
+    void SaveObject(const T& value) {
+        // Как и архивы Boost, вызываем serialize для неконстантного объекта
+        auto& object = const_cast<T&>(value);
+        constexpr unsigned version = boost::serialization::version<T>::value;
+        static_assert(version <= UINT8_MAX);
+        const size_t slot = GetClassSlot<T>();
+        if (slot >= class_versions_.size()) {
+            class_versions_.resize(slot + 1, UNKNOWN_VERSION);
+        }
+        if (class_versions_[slot] == UNKNOWN_VERSION) {
+            class_versions_[slot] = static_cast<int>(version);
+            SaveUnsigned(uint8_t{version});
+        }
+        if constexpr (requires { object.serialize(*this, version); }) {
+            object.serialize(*this, version);
+        } else {
+            serialize(*this, object, version);
+        }
+    }
+
+    template <typename U>
+    void SaveUnsigned(U value) {
+        char bytes[sizeof(U)];
+        for (size_t i = 0; i < sizeof(U); ++i) {
+            bytes[i] = static_cast<char>(value & 0xFF);
+            if constexpr (sizeof(U) > 1) {
+                value >>= 8;
+            }
+        }
+        buffer_.append(bytes, sizeof(U));
+    }
+
+    void WriteFrame() {
+        std::string header;
+        header.reserve(HEADER_SIZE);
+        buffer_.swap(header);
+        SaveUnsigned(MAGIC);
+        SaveUnsigned(FORMAT_VERSION);
+        SaveUnsigned(uint64_t{header.size()});
+        SaveUnsigned(Crc32(header.data(), header.size()));
+        buffer_.swap(header);
+
+        output_.write(header.data(), static_cast<std::streamsize>(header.size()));
+        output_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        if (!output_) {
+            throw std::runtime_error("Failed to write snapshot");
+        }
+    }
+
+    std::ostream& output_;
+    std::string buffer_;
+    std::vector<int> class_versions_;
+    int depth_ = 0;
+};
+
+class BinaryInputArchive : public BinaryArchiveBase {
+public:
+    using is_saving = std::false_type;
+    using is_loading = std::true_type;
+
+    explicit BinaryInputArchive(std::istream& input)
+        : input_{input} {
+    }
+
+    template <typename T>
+    BinaryInputArchive& operator>>(T& value) {
+        if (depth_ > 0) {
+            Load(value);
+            return *this;
+        }
+
+        ReadFrame();
+        ++depth_;
+        try {
+            Load(value);
+        } catch (...) {
+            --depth_;
+            throw;
+        }
+        --depth_;
+        if (position_ != buffer_.size()) {
+            throw std::runtime_error("Snapshot frame has trailing data");
+        }
+        return *this;
+    }
+
+    template <typename T>
+    BinaryInputArchive& operator&(T& value) {
+        return *this >> value;
+    }
+
+    // Читает последовательность байт, записанную SaveBytes или как std::string, не копируя её.
+    // Представление указывает в буфер текущего кадра и действительно, пока жив этот буфер:
+    // его владение можно разделить с архивом через GetFrameBuffer
+    std::string_view LoadBytes() {
+        const size_t size = LoadSize(1);
+        const auto bytes = buffer_.substr(position_, size);
+        position_ += size;
+        return bytes;
+    }
+
+    // Буфер текущего кадра. Пока на него есть ссылки, архив читает следующие кадры в новый буфер
+    std::shared_ptr<const std::string> GetFrameBuffer() const noexcept {
+        return frame_;
+    }
+
+private:
+    template <typename T>
+    void Load(T& value) {
+        if constexpr (std::is_enum_v<T>) {
+            std::underlying_type_t<T> underlying;
+            Load(underlying);
+            value = static_cast<T>(underlying);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            value = LoadArithmetic<T>();
+        } else {
+            LoadObject(value);
+        }
+    }
+
+    void Load(std::string& str) {
+        const size_t size = LoadSize(1);
+        str.assign(buffer_.substr(position_, size));
+        position_ += size;
+    }
+
+    template <typename T, typename Alloc>
+    void Load(std::vector<T, Alloc>& vec) {
+        const size_t size = LoadSize(std::is_arithmetic_v<T> ? sizeof(T) : 1);
+        vec.clear();
+        if constexpr (IsBulkCopyable<T>()) {
+            vec.resize(size);
+            std::memcpy(vec.data(), buffer_.data() + position_, size * sizeof(T));
+            position_ += size * sizeof(T);
+        } else {
+            vec.reserve(size);
+            for (size_t i = 0; i < size; ++i) {
+                Load(vec.emplace_back());
+            }
+        }
+    }
+
+    template <typename T>
+    T LoadArithmetic() {
+        const auto wire = LoadUnsigned<WireType<T>>();
+        if constexpr (std::is_same_v<T, bool>) {
+            if (wire > 1) {
+                throw std::runtime_error("Snapshot value is out of range");
+            }
+            return wire != 0;
+        } else {
+            return std::bit_cast<T>(wire);
+        }
+    }
+
+    template <typename T>
+    void LoadObject(T& object) {
+        const unsigned version = LoadClassVersion<T>();
+        if constexpr (requires { object.serialize(*this, version); }) {
+            object.serialize(*this, version);
+        } else {
+            serialize(*this, object, version);
+        }
+    }
+
+    template <typename T>
+    unsigned LoadClassVersion() {
+        const size_t slot = GetClassSlot<T>();
+        if (slot >= class_versions_.size()) {
+            class_versions_.resize(slot + 1, UNKNOWN_VERSION);
+        }
+        if (class_versions_[slot] == UNKNOWN_VERSION) {
+            const unsigned version = LoadUnsigned<uint8_t>();
+            if (version > boost::serialization::version<T>::value) {
+                throw std::runtime_error("Snapshot was written by a newer version of the game");
+            }
+            class_versions_[slot] = static_cast<int>(version);
+        }
+        return static_cast<unsigned>(class_versions_[slot]);
+    }
+
+    // Читает длину последовательности и проверяет, что её элементы помещаются в кадр
+    size_t LoadSize(size_t min_item_size) {
+        const auto size = LoadUnsigned<uint64_t>();
+        if (size > (buffer_.size() - position_) / min_item_size) {
+            throw std::runtime_error("Snapshot sequence is too long");
+        }
+        return static_cast<size_t>(size);
+    }
+
+    template <typename U>
+    U LoadUnsigned() {
+        if (buffer_.size() - position_ < sizeof(U)) {
+            throw std::runtime_error("Unexpected end of snapshot");
+        }
+        U value = 0;
+        for (size_t i = 0; i < sizeof(U); ++i) {
+            value |= static_cast<U>(static_cast<unsigned char>(buffer_[position_ + i])) << (8 * i);
+        }
+        position_ += sizeof(U);
+        return value;
+    }
+
+    void ReadFrame() {
+        if (!frame_ || frame_.use_count() > 1) {
+            frame_ = std::make_shared<std::string>();
+        }
+        frame_->resize(HEADER_SIZE);
+        buffer_ = *frame_;
+        position_ = 0;
+        if (!input_.read(frame_->data(), HEADER_SIZE)) {
+            throw std::runtime_error("Failed to read snapshot header");
+        }
+        if (LoadUnsigned<uint32_t>() != MAGIC) {
+            throw std::runtime_error("Not a snapshot");
+        }
+        if (LoadUnsigned<uint32_t>() != FORMAT_VERSION) {
+            throw std::runtime_error("Unsupported snapshot format version");
+        }
+        class_versions_.clear();
+        const auto size = LoadUnsigned<uint64_t>();
+        const auto checksum = LoadUnsigned<uint32_t>();
+
+        // Повреждённый размер приводит к ошибке чтения, а не к выделению всей памяти сразу
+        frame_->clear();
+        for (uint64_t rest = size; rest > 0;) {
+            const size_t chunk = static_cast<size_t>(std::min<uint64_t>(rest, READ_CHUNK_SIZE));
+            const size_t offset = frame_->size();
+            frame_->resize(offset + chunk);
+            if (!input_.read(frame_->data() + offset, static_cast<std::streamsize>(chunk))) {
+                throw std::runtime_error("Snapshot is truncated");
+            }
+            rest -= chunk;
+        }
+        buffer_ = *frame_;
+        position_ = 0;
+        if (Crc32(buffer_.data(), buffer_.size()) != checksum) {
+            throw std::runtime_error("Snapshot checksum mismatch");
+        }
+    }
+
+    std::istream& input_;
+    std::shared_ptr<std::string> frame_;
+    // Данные текущего кадра в frame_
+    std::string_view buffer_;
+    size_t position_ = 0;
+    std::vector<int> class_versions_;
+    int depth_ = 0;
+};
+
+}  // namespace serialization
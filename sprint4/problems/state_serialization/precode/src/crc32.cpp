@@ -0,0 +1,54 @@
+#include "crc32.h"
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+namespace serialization {
+
+namespace {
+
+// Таблицы для вычисления CRC32 по 8 байт за шаг
+constexpr auto MakeCrcTables() {
+    std::array<std::array<uint32_t, 256>, 8> tables{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0u);
+        }
+        tables[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+        for (size_t t = 1; t < tables.size(); ++t) {
+            tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xFF];
+        }
+    }
+    return tables;
+}
+
+constexpr auto CRC_TABLES = MakeCrcTables();
+
+}  // namespace
+
+uint32_t Crc32(const char* data, size_t size) noexcept {
+    const auto& t = CRC_TABLES;
+    uint32_t crc = 0xFFFFFFFFu;
+    if constexpr (std::endian::native == std::endian::little) {
+        for (; size >= 8; data += 8, size -= 8) {
+            uint32_t low;
+            uint32_t high;
+            std::memcpy(&low, data, 4);
+            std::memcpy(&high, data + 4, 4);
+            low ^= crc;
+            crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF]
+                ^ t[4][low >> 24] ^ t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF]
+                ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+        }
+    }
+    for (; size > 0; ++data, --size) {
+        crc = (crc >> 8) ^ t[0][(crc ^ static_cast<uint8_t>(*data)) & 0xFF];
+    }
+    return ~crc;
+}
+
+}  // namespace serialization
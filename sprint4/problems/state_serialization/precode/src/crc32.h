@@ -0,0 +1,12 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace serialization {
+
+// CRC32 (IEEE 802.3), совпадающий с boost::crc_32_type.
+// Вычисляется по 8 байт за шаг (slicing-by-8), что в несколько раз быстрее побайтового
+// вычисления и заметно при проверке снимков в сотни мегабайт
+uint32_t Crc32(const char* data, size_t size) noexcept;
+
+}  // namespace serialization
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace serialization {
+
+/*
+ * Таблица полей - последовательность записей
+ *   id поля (u8) | длина значения (u32) | значение
+ * Числа записываются в little-endian. Читатель пропускает поля с незнакомыми id,
+ * а отсутствующие поля оставляет со значениями по умолчанию, поэтому в таблицу
+ * можно добавлять новые поля, не меняя версию класса.
+ */
+class FieldTableWriter {
+public:
+    explicit FieldTableWriter(std::string& output) noexcept
+        : output_{output} {
+    }
+
+    void Add(uint8_t id, std::string_view value) {
+        if (value.size() > UINT32_MAX) {
+            throw std::length_error("Field value is too long");
+        }
+        BeginField(id, static_cast<uint32_t>(value.size()));
+        output_.append(value);
+    }
+
+    void AddUint32(uint8_t id, uint32_t value) {
+        BeginField(id, sizeof(value));
+        AppendUint32(output_, value);
+    }
+
+    // Добавляет поле, значение которого записывает функция write(std::string&)
+    template <typename Write>
+    void AddWith(uint8_t id, uint32_t size, Write&& write) {
+        BeginField(id, size);
+        const size_t start = output_.size();
+        write(output_);
+        if (output_.size() - start != size) {
+            throw std::logic_error("Field size mismatch");
+        }
+    }
+
+    static void AppendUint32(std::string& output, uint32_t value) {
+        const char bytes[] = {static_cast<char>(value), static_cast<char>(value >> 8),
+                              static_cast<char>(value >> 16), static_cast<char>(value >> 24)};
+        output.append(bytes, sizeof(bytes));
+    }
+
+private:
+    void BeginField(uint8_t id, uint32_t size) {
+        output_.push_back(static_cast<char>(id));
+        AppendUint32(output_, size);
+    }
+
+    std::string& output_;
+};
+
+// Последовательно читает поля таблицы. Выбрасывает std::runtime_error, если таблица повреждена
+class FieldTableReader {
+public:
+    explicit FieldTableReader(std::string_view data) noexcept
+        : data_{data} {
+    }
+
+    // Читает следующее поле. Возвращает false, когда поля закончились
+    bool Next(uint8_t& id, std::string_view& value) {
+        if (data_.empty()) {
+            return false;
+        }
+        if (data_.size() < 1 + sizeof(uint32_t)) {
+            throw std::runtime_error("Field table is truncated");
+        }
+        id = static_cast<uint8_t>(data_[0]);
+        const uint32_t size = ReadUint32(data_.substr(1));
+        data_.remove_prefix(1 + sizeof(uint32_t));
+        if (size > data_.size()) {
+            throw std::runtime_error("Field table is truncated");
+        }
+        value = data_.substr(0, size);
+        data_.remove_prefix(size);
+        return true;
+    }
+
+    static uint32_t ReadUint32(std::string_view bytes) {
+        if (bytes.size() < sizeof(uint32_t)) {
+            throw std::runtime_error("Field value is too short");
+        }
+        uint32_t value = 0;
+        for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+            value |= static_cast<uint32_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+        }
+        return value;
+    }
+
+private:
+    std::string_view data_;
+};
+
+}  // namespace serialization
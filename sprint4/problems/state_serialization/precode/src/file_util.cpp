@@ -0,0 +1,78 @@
+#include "file_util.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+
+namespace serialization {
+
+using namespace std::literals;
+namespace fs = std::filesystem;
+
+void ThrowSystemError(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+FileDescriptor::~FileDescriptor() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+void WriteAll(int fd, std::string_view data, std::string_view what) {
+    while (!data.empty()) {
+        const ssize_t written = ::write(fd, data.data(), data.size());
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ThrowSystemError(std::string{what});
+        }
+        data.remove_prefix(static_cast<size_t>(written));
+    }
+}
+
+void SyncDirectory(const fs::path& directory) {
+    // Путь без каталога (parent_path() имени файла) обозначает текущий каталог
+    const fs::path& path = directory.empty() ? fs::path{"."} : directory;
+    FileDescriptor fd{::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+    if (fd.Get() < 0 || ::fsync(fd.Get()) != 0) {
+        ThrowSystemError("Failed to sync directory "s + directory.string());
+    }
+}
+
+fs::path GetTempPath(const fs::path& path) {
+    auto temp_path = path;
+    temp_path += ".tmp";
+    return temp_path;
+}
+
+void ReplaceFile(const fs::path& path, const std::function<void(const fs::path&)>& write_file) {
+    const auto temp_path = GetTempPath(path);
+    try {
+        write_file(temp_path);
+        fs::rename(temp_path, path);
+    } catch (...) {
+        std::error_code ec;
+        fs::remove(temp_path, ec);
+        throw;
+    }
+}
+
+void WriteFileAtomically(const fs::path& path, std::string_view data) {
+    ReplaceFile(path, [data](const fs::path& temp_path) {
+        FileDescriptor fd{::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+        if (fd.Get() < 0) {
+            ThrowSystemError("Failed to create "s + temp_path.string());
+        }
+        WriteAll(fd.Get(), data, "Failed to write "s + temp_path.string());
+        if (::fsync(fd.Get()) != 0) {
+            ThrowSystemError("Failed to sync "s + temp_path.string());
+        }
+    });
+    SyncDirectory(path.parent_path());
+}
+
+}  // namespace serialization
@@ -0,0 +1,59 @@
+#pragma once
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace serialization {
+
+// Выбрасывает std::system_error с текущим значением errno
+[[noreturn]] void ThrowSystemError(const std::string& what);
+
+// Закрывает файловый дескриптор при выходе из области видимости
+class FileDescriptor {
+public:
+    explicit FileDescriptor(int fd) noexcept
+        : fd_{fd} {
+    }
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    ~FileDescriptor();
+
+    int Get() const noexcept {
+        return fd_;
+    }
+
+private:
+    int fd_;
+};
+
+// Записывает data целиком, повторяя write после частичной записи и EINTR.
+// При ошибке выбрасывает std::system_error с сообщением what
+void WriteAll(int fd, std::string_view data, std::string_view what);
+
+// Сбрасывает на диск содержимое каталога: созданные, переименованные и удалённые в нём файлы.
+// Пустой путь обозначает текущий каталог
+void SyncDirectory(const std::filesystem::path& directory);
+
+// Путь временного файла, которым атомарно заменяется path
+std::filesystem::path GetTempPath(const std::filesystem::path& path);
+
+/*
+ * Атомарно заменяет файл path: write_file(temp_path) создаёт временный файл,
+ * целиком записывает его и сбрасывает на диск, после чего файл переименовывается в path.
+ * Если запись или переименование не удались, временный файл удаляется, исключение
+ * пробрасывается, а path сохраняет прежнее содержимое.
+ * Каталог не синхронизируется: вызывающий код делает это сам, например, один раз
+ * после нескольких изменений в каталоге.
+ */
+void ReplaceFile(const std::filesystem::path& path,
+                 const std::function<void(const std::filesystem::path&)>& write_file);
+
+// Атомарно заменяет файл path содержимым data и синхронизирует его каталог.
+// Если исключение выброшено при синхронизации каталога, path уже содержит data,
+// но переименование может не пережить сбой питания
+void WriteFileAtomically(const std::filesystem::path& path, std::string_view data);
+
+}  // namespace serialization
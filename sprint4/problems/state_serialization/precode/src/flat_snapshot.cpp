@@ -0,0 +1,243 @@
+#include "flat_snapshot.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include "crc32.h"
+
+namespace serialization {
+
+namespace {
+
+using namespace std::literals;
+
+template <typename T>
+uint32_t ToOffset(T value) {
+    if (value > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("Flat snapshot is too large");
+    }
+    return static_cast<uint32_t>(value);
+}
+
+template <typename T>
+void Append(std::string& out, const T* data, size_t count) {
+    out.append(reinterpret_cast<const char*>(data), count * sizeof(T));
+}
+
+}  // namespace
+
+void FlatSnapshotBuilder::Reserve(size_t dog_count) {
+    dogs_.reserve(dog_count);
+    names_.Reserve(dog_count);
+}
+
+void FlatSnapshotBuilder::AddDog(const model::Dog& dog) {
+    const auto name = dog.GetName();
+    const auto& bag = dog.GetBagContent();
+
+    FlatDogRecord record;
+    record.id = *dog.GetId();
+    record.name_index = names_.Intern(name).index;
+    record.bag_offset = ToOffset(bag_items_.size());
+    record.bag_size = ToOffset(bag.size());
+    record.bag_capacity = ToOffset(dog.GetBagCapacity());
+    record.score = dog.GetScore();
+    record.direction = static_cast<uint32_t>(dog.GetDirection());
+    record.x = dog.GetPosition().x;
+    record.y = dog.GetPosition().y;
+    record.speed_x = dog.GetSpeed().x;
+    record.speed_y = dog.GetSpeed().y;
+
+    dogs_.push_back(record);
+    bag_items_.insert(bag_items_.end(), bag.begin(), bag.end());
+}
+
+std::string FlatSnapshotBuilder::Build() const {
+    // Смещения имён в пуле строк и смещение конца пула
+    std::vector<uint32_t> name_offsets(names_.GetCount() + 1);
+    size_t string_pool_size = 0;
+    for (uint32_t i = 0; i < names_.GetCount(); ++i) {
+        name_offsets[i] = ToOffset(string_pool_size);
+        string_pool_size += names_.GetByIndex(i).size();
+    }
+    name_offsets.back() = ToOffset(string_pool_size);
+
+    FlatSnapshotHeader header;
+    header.dog_count = dogs_.size();
+    header.bag_item_count = bag_items_.size();
+    header.name_count = names_.GetCount();
+    header.string_pool_size = string_pool_size;
+
+    std::string result;
+    result.reserve(sizeof(header) + dogs_.size() * sizeof(FlatDogRecord)
+                   + bag_items_.size() * sizeof(model::FoundObject)
+                   + name_offsets.size() * sizeof(uint32_t) + string_pool_size);
+    Append(result, &header, 1);
+    Append(result, dogs_.data(), dogs_.size());
+    Append(result, bag_items_.data(), bag_items_.size());
+    Append(result, name_offsets.data(), name_offsets.size());
+    for (uint32_t i = 0; i < names_.GetCount(); ++i) {
+        result.append(names_.GetByIndex(i));
+    }
+
+    header.checksum = Crc32(result.data() + sizeof(header), result.size() - sizeof(header));
+    std::memcpy(result.data(), &header, sizeof(header));
+    return result;
+}
+
+void FlatSnapshotBuilder::WriteTo(const std::filesystem::path& path) const {
+    const auto data = Build();
+    std::ofstream output{path, std::ios::binary | std::ios::trunc};
+    output.write(data.data(), static_cast<std::streamsize>(data.size()));
+    output.flush();
+    if (!output) {
+        throw std::runtime_error("Failed to write flat snapshot "s + path.string());
+    }
+}
+
+MappedFlatSnapshot::MappedFlatSnapshot(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open flat snapshot "s + path.string());
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FlatSnapshotHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Flat snapshot is truncated");
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    // Отображение остаётся действительным и после закрытия файла
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Failed to map flat snapshot "s + path.string());
+    }
+    data_ = data;
+    ::madvise(data_, size_, MADV_SEQUENTIAL);
+
+    try {
+        Validate();
+    } catch (...) {
+        ::munmap(data_, size_);
+        throw;
+    }
+}
+
+MappedFlatSnapshot::~MappedFlatSnapshot() {
+    ::munmap(data_, size_);
+}
+
+void MappedFlatSnapshot::Validate() {
+    const auto* bytes = static_cast<const char*>(data_);
+    FlatSnapshotHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.magic != FlatSnapshotHeader::MAGIC) {
+        throw std::runtime_error("Not a flat snapshot");
+    }
+    if (header.version != FlatSnapshotHeader::FORMAT_VERSION) {
+        throw std::runtime_error("Unsupported flat snapshot version");
+    }
+
+    // Размеры проверяются делением, чтобы исключить переполнение
+    size_t rest = size_ - sizeof(header);
+    if (header.dog_count > rest / sizeof(FlatDogRecord)) {
+        throw std::runtime_error("Flat snapshot is truncated");
+    }
+    rest -= header.dog_count * sizeof(FlatDogRecord);
+    if (header.bag_item_count > rest / sizeof(model::FoundObject)) {
+        throw std::runtime_error("Flat snapshot is truncated");
+    }
+    rest -= header.bag_item_count * sizeof(model::FoundObject);
+    if (header.name_count >= rest / sizeof(uint32_t)) {
+        throw std::runtime_error("Flat snapshot is truncated");
+    }
+    rest -= (header.name_count + 1) * sizeof(uint32_t);
+    if (header.string_pool_size != rest) {
+        throw std::runtime_error("Flat snapshot size mismatch");
+    }
+    if (header.checksum != Crc32(bytes + sizeof(header), size_ - sizeof(header))) {
+        throw std::runtime_error("Flat snapshot checksum mismatch");
+    }
+
+    const char* pos = bytes + sizeof(header);
+    dogs_ = {reinterpret_cast<const FlatDogRecord*>(pos), header.dog_count};
+    pos += header.dog_count * sizeof(FlatDogRecord);
+    bag_items_ = {reinterpret_cast<const model::FoundObject*>(pos), header.bag_item_count};
+    pos += header.bag_item_count * sizeof(model::FoundObject);
+    name_offsets_ = {reinterpret_cast<const uint32_t*>(pos), header.name_count + 1};
+    pos += name_offsets_.size() * sizeof(uint32_t);
+    string_pool_ = {pos, header.string_pool_size};
+
+    if (name_offsets_.front() != 0 || name_offsets_.back() != string_pool_.size()
+        || !std::ranges::is_sorted(name_offsets_)) {
+        throw std::runtime_error("Flat snapshot contains invalid name offsets");
+    }
+    for (const auto& dog : dogs_) {
+        if (dog.name_index >= header.name_count
+            || dog.bag_offset > bag_items_.size()
+            || dog.bag_size > bag_items_.size() - dog.bag_offset
+            || dog.bag_size > dog.bag_capacity
+            || dog.direction > static_cast<uint32_t>(model::Direction::SOUTH)) {
+            throw std::runtime_error("Flat snapshot contains an invalid dog record");
+        }
+    }
+}
+
+model::Dog MappedFlatSnapshot::RestoreDog(size_t index, model::NameTable& names) const {
+    const auto& record = dogs_[index];
+    model::Dog dog{model::Dog::Id{record.id}, names, names.Intern(GetDogName(index)),
+                   geom::Point2D{record.x, record.y}, record.bag_capacity};
+    RestoreState(index, dog);
+    return dog;
+}
+
+std::vector<model::Dog> MappedFlatSnapshot::RestoreDogs(model::NameTable& names) const {
+    std::vector<model::Dog> dogs;
+    dogs.reserve(dogs_.size());
+    if (names.GetCount() == 0) {
+        // Имена пула различны, поэтому их номера в таблице совпадают с номерами в снимке
+        names.AppendUnique(string_pool_, name_offsets_);
+        for (size_t i = 0; i < dogs_.size(); ++i) {
+            const uint32_t name_index = dogs_[i].name_index;
+            EmplaceDog(dogs, i, names,
+                       {name_index, name_offsets_[name_index + 1] - name_offsets_[name_index]});
+        }
+    } else {
+        std::vector<model::NameRef> refs;
+        refs.reserve(GetNameCount());
+        for (size_t i = 0; i < GetNameCount(); ++i) {
+            refs.push_back(names.Intern(GetName(i)));
+        }
+        for (size_t i = 0; i < dogs_.size(); ++i) {
+            EmplaceDog(dogs, i, names, refs[dogs_[i].name_index]);
+        }
+    }
+    return dogs;
+}
+
+void MappedFlatSnapshot::EmplaceDog(std::vector<model::Dog>& dogs, size_t index,
+                                    const model::NameTable& names, model::NameRef name) const {
+    const auto& record = dogs_[index];
+    RestoreState(index, dogs.emplace_back(model::Dog::Id{record.id}, names, name,
+                                          geom::Point2D{record.x, record.y},
+                                          record.bag_capacity));
+}
+
+void MappedFlatSnapshot::RestoreState(size_t index, model::Dog& dog) const {
+    const auto& record = dogs_[index];
+    dog.SetSpeed({record.speed_x, record.speed_y});
+    dog.SetDirection(static_cast<model::Direction>(record.direction));
+    dog.AddScore(record.score);
+    // Вместимость проверена при загрузке снимка
+    (void)dog.PutToBag(GetDogBag(index));
+}
+
+}  // namespace serialization
@@ -0,0 +1,153 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "model.h"
+
+namespace serialization {
+
+/*
+ * Плоский снимок собак, который восстанавливается без разбора потока.
+ *
+ * Файл состоит из заголовка и четырёх непрерывных областей:
+ *   заголовок | записи собак | содержимое всех рюкзаков | смещения имён | пул строк имён
+ * Пул строк - это таблица имён снимка: каждое имя записывается в него один раз,
+ * сколько бы собак его ни носило, а имя i занимает в пуле байты
+ * [смещение i, смещение i + 1). Записи собак хранят номера своих имён и смещения
+ * своих предметов в общей области рюкзаков. При загрузке файл отображается в память (mmap),
+ * проверяется контрольная сумма, после чего собаки строятся прямо из отображённых
+ * массивов, без промежуточных представлений, а пул целиком становится таблицей
+ * имён игры.
+ * Числа хранятся в порядке байтов little-endian, совпадающем с порядком байтов машины.
+ */
+struct FlatSnapshotHeader {
+    static constexpr uint32_t MAGIC = 0x534C4650;  // "PFLS"
+    static constexpr uint32_t FORMAT_VERSION = 2;
+
+    uint32_t magic = MAGIC;
+    uint32_t version = FORMAT_VERSION;
+    uint64_t dog_count = 0;
+    uint64_t bag_item_count = 0;
+    uint64_t name_count = 0;
+    uint64_t string_pool_size = 0;
+    // CRC32 всех данных, следующих за заголовком
+    uint32_t checksum = 0;
+    uint32_t reserved = 0;
+};
+
+struct FlatDogRecord {
+    uint32_t id = 0;
+    // Номер имени в таблице имён снимка
+    uint32_t name_index = 0;
+    uint32_t bag_offset = 0;
+    uint32_t bag_size = 0;
+    uint32_t bag_capacity = 0;
+    uint32_t score = 0;
+    uint32_t direction = 0;
+    uint32_t reserved = 0;
+    double x = 0;
+    double y = 0;
+    double speed_x = 0;
+    double speed_y = 0;
+};
+
+static_assert(std::endian::native == std::endian::little);
+static_assert(std::is_trivially_copyable_v<FlatSnapshotHeader> && sizeof(FlatSnapshotHeader) == 48);
+static_assert(std::is_trivially_copyable_v<FlatDogRecord> && sizeof(FlatDogRecord) == 64);
+// Содержимое рюкзаков отображается в память прямо как массив FoundObject
+static_assert(std::is_trivially_copyable_v<model::FoundObject> && sizeof(model::FoundObject) == 8);
+
+// Собирает плоский снимок из собак
+class FlatSnapshotBuilder {
+public:
+    void Reserve(size_t dog_count);
+
+    void AddDog(const model::Dog& dog);
+
+    // Возвращает содержимое файла снимка
+    [[nodiscard]] std::string Build() const;
+
+    void WriteTo(const std::filesystem::path& path) const;
+
+private:
+    // Номера имён записей совпадают с номерами в names_
+    std::vector<FlatDogRecord> dogs_;
+    std::vector<model::FoundObject> bag_items_;
+    model::NameTable names_;
+};
+
+// Плоский снимок, отображённый в память. Выбрасывает std::runtime_error,
+// если файл повреждён или имеет неизвестный формат
+class MappedFlatSnapshot {
+public:
+    explicit MappedFlatSnapshot(const std::filesystem::path& path);
+
+    MappedFlatSnapshot(const MappedFlatSnapshot&) = delete;
+    MappedFlatSnapshot& operator=(const MappedFlatSnapshot&) = delete;
+
+    ~MappedFlatSnapshot();
+
+    size_t GetDogCount() const noexcept {
+        return dogs_.size();
+    }
+
+    const FlatDogRecord& GetDogRecord(size_t index) const {
+        return dogs_[index];
+    }
+
+    size_t GetNameCount() const noexcept {
+        return name_offsets_.size() - 1;
+    }
+
+    // Имена и содержимое рюкзаков без копирования.
+    // Действительны, пока существует объект MappedFlatSnapshot
+    std::string_view GetName(size_t name_index) const {
+        const uint32_t offset = name_offsets_[name_index];
+        return string_pool_.substr(offset, name_offsets_[name_index + 1] - offset);
+    }
+
+    std::string_view GetDogName(size_t index) const {
+        return GetName(dogs_[index].name_index);
+    }
+
+    std::span<const model::FoundObject> GetDogBag(size_t index) const {
+        const auto& dog = dogs_[index];
+        return bag_items_.subspan(dog.bag_offset, dog.bag_size);
+    }
+
+    // Восстанавливает собаку, добавляя её имя в таблицу имён игры names.
+    // Таблица должна пережить собаку
+    [[nodiscard]] model::Dog RestoreDog(size_t index, model::NameTable& names) const;
+
+    // Восстанавливает всех собак, добавляя имена снимка в таблицу имён игры names.
+    // Пустая таблица заполняется пулом строк целиком, без поиска имён.
+    // Таблица должна пережить собак
+    [[nodiscard]] std::vector<model::Dog> RestoreDogs(model::NameTable& names) const;
+
+private:
+    // Проверяет заголовок и контрольную сумму и разбивает файл на области
+    void Validate();
+
+    // Собаки строятся прямо в векторе, чтобы не перемещать их после создания
+    void EmplaceDog(std::vector<model::Dog>& dogs, size_t index, const model::NameTable& names,
+                    model::NameRef name) const;
+
+    // Переносит в собаку скорость, направление, очки и рюкзак из записи снимка
+    void RestoreState(size_t index, model::Dog& dog) const;
+
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    std::span<const FlatDogRecord> dogs_;
+    std::span<const model::FoundObject> bag_items_;
+    std::span<const uint32_t> name_offsets_;
+    std::string_view string_pool_;
+};
+
+}  // namespace serialization
@@ -1,9 +1,16 @@
 #pragma once
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "geom.h"
+#include "name_table.h"
+#include "slot_map.h"
+#include "small_vector.h"
 #include "tagged.h"
 
 namespace model {
@@ -33,6 +40,15 @@ struct FoundObject {
     [[nodiscard]] auto operator<=>(const FoundObject&) const = default;
 };
 
+// Предметы хранятся в рюкзаках и снимках плотными массивами
+static_assert(sizeof(FoundObject) == 8 && std::is_trivially_copyable_v<FoundObject>);
+
+// Предмет, лежащий на карте
+struct LostObject {
+    LostObjectType type{0u};
+    geom::Point2D position;
+};
+
 enum class Direction {
     NORTH,
     EAST,
@@ -40,12 +56,80 @@ enum class Direction {
     SOUTH,
 };
 
+/*
+ * Имя собаки: либо ссылка на строку таблицы имён игры, либо собственная копия строки.
+ * Имя из таблицы остаётся действительным, пока существует таблица. Собственная копия
+ * хранится в куче и не перемещается вместе с объектом, поэтому при перемещении
+ * представление имени остаётся действительным и не пересчитывается.
+ * Объект занимает 24 байта: представление имени и указатель на собственную копию.
+ */
+class DogName {
+public:
+    DogName() = default;
+
+    // Собственная копия имени
+    explicit DogName(std::string_view name)
+        : own_{CopyOf(name)}
+        , name_{own_.get(), name.size()} {
+    }
+
+    // Имя из таблицы имён
+    DogName(const NameTable& names, NameRef ref) noexcept
+        : name_{names.Get(ref)} {
+    }
+
+    DogName(const DogName& other)
+        : own_{other.own_ ? CopyOf(other.name_) : nullptr}
+        , name_{other.own_ ? std::string_view{own_.get(), other.name_.size()} : other.name_} {
+    }
+
+    DogName(DogName&&) noexcept = default;
+
+    DogName& operator=(const DogName& other) {
+        *this = DogName{other};
+        return *this;
+    }
+
+    DogName& operator=(DogName&&) noexcept = default;
+
+    std::string_view Get() const noexcept {
+        return name_;
+    }
+
+private:
+    static std::unique_ptr<char[]> CopyOf(std::string_view name) {
+        auto copy = std::make_unique_for_overwrite<char[]>(name.size());
+        name.copy(copy.get(), name.size());
+        return copy;
+    }
+
+    // Собственная копия имени или nullptr, если имя хранится в таблице
+    std::unique_ptr<char[]> own_;
+    std::string_view name_;
+};
+
+static_assert(sizeof(DogName) == 24);
+
 class Dog {
 public:
     using Id = util::Tagged<uint32_t, Dog>;
-    using BagContent = std::vector<FoundObject>;
+    // Сколько предметов рюкзака хранится прямо в собаке, без выделения памяти в куче.
+    // Обычно вместимость рюкзака из конфига не больше этого значения
+    static constexpr size_t BAG_INLINE_CAPACITY = 3;
+    using BagContent = util::SmallVector<FoundObject, BAG_INLINE_CAPACITY>;
+
+    // Собака, имя которой хранится в таблице имён игры names.
+    // Собака не владеет таблицей: таблица должна существовать, пока существует собака
+    Dog(Id id, const NameTable& names, NameRef name, geom::Point2D pos, size_t bag_cap)
+        : Dog(std::move(id), DogName{names, name}, pos, bag_cap) {
+    }
+
+    // Собака с собственной копией имени, не принадлежащая игре
+    Dog(Id id, std::string_view name, geom::Point2D pos, size_t bag_cap)
+        : Dog(std::move(id), DogName{name}, pos, bag_cap) {
+    }
 
-    Dog(Id id, std::string name, geom::Point2D pos, size_t bag_cap)
+    Dog(Id id, DogName name, geom::Point2D pos, size_t bag_cap)
         : id_(std::move(id))
         , name_(std::move(name))
         , position_(pos)
@@ -57,8 +141,9 @@ public:
         return id_;
     }
 
-    const std::string GetName() const noexcept {
-        return name_;
+    // Имя действительно, пока существует собака и таблица, в которой оно хранится
+    std::string_view GetName() const noexcept {
+        return name_.Get();
     }
 
     const geom::Point2D& GetPosition() const noexcept {
@@ -102,6 +187,16 @@ public:
         return true;
     }
 
+    // Кладёт в рюкзак сразу несколько предметов, если все они в нём поместятся
+    [[nodiscard]] bool PutToBag(std::span<const FoundObject> items) {
+        if (items.size() > bag_cap_ - bag_.size()) {
+            return false;
+        }
+
+        bag_.insert(bag_.end(), items.begin(), items.end());
+        return true;
+    }
+
     size_t EmptyBag() noexcept {
         auto res = bag_.size();
         bag_.clear();
@@ -123,16 +218,21 @@ public:
 
 private:
     Id id_;
-    std::string name_;
+    DogName name_;
     geom::Point2D position_;
     geom::Vec2D speed_;
     Direction direction_{Direction::NORTH};
-    std::vector<FoundObject> bag_;
-    size_t bag_cap_;
     Score score_{};
+    // Вместимость и содержимое рюкзака занимают одну строку кэша
+    alignas(64) size_t bag_cap_;
+    BagContent bag_;
 };
 
 using DogPtr = std::shared_ptr<Dog>;
 using ConstDogPtr = std::shared_ptr<const Dog>;
 
+// Собаки и предметы на карте с идентификаторами, выдаваемыми хранилищем
+using DogRegistry = util::SlotMap<Dog::Id, Dog>;
+using LostObjectRegistry = util::SlotMap<FoundObject::Id, LostObject>;
+
 }  // namespace model
@@ -1,5 +1,13 @@
+#pragma once
+#include <boost/serialization/string.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
 
+#include "field_table.h"
 #include "model.h"
 
 namespace geom {
@@ -30,58 +38,320 @@ void serialize(Archive& ar, FoundObject& obj, [[maybe_unused]] const unsigned ve
 
 namespace serialization {
 
-// DogRepr (DogRepresentation) - сериализованное представление класса Dog
+// Архив, который записывает и читает последовательности байт без копирования
+// (BinaryOutputArchive и BinaryInputArchive)
+template <typename Archive>
+concept ByteViewArchive = requires(Archive& ar, std::string_view bytes) {
+    ar.SaveBytes(bytes);
+} || requires(Archive& ar) {
+    ar.LoadBytes();
+    ar.GetFrameBuffer();
+};
+
+// DogRepr (DogRepresentation) - сериализованное представление класса Dog.
+//
+// В двоичных архивах (ByteViewArchive) поля делятся на горячие, нужные, чтобы сразу
+// после загрузки начать обслуживать игроков (id, координаты, скорость, направление,
+// вместимость рюкзака), и холодные (имя, очки, содержимое рюкзака). Горячие поля
+// загружаются сразу, а холодные записываются таблицей полей (см. FieldTableWriter)
+// и после загрузки остаются нетронутым фрагментом кадра архива: DogRepr хранит
+// представление этого фрагмента и разделяет владение буфером кадра с другими собаками
+// того же кадра, а декодирует поля при первом обращении к ним.
+// Первое обращение к холодным полям изменяет объект, поэтому его нельзя
+// выполнять одновременно из нескольких потоков.
+//
+// Версия 0 - исходный формат, в котором все поля идут подряд. Версия 1 делит поля на горячие
+// и холодные только в двоичных архивах, а текстовые архивы Boost и в ней записываются
+// и читаются в формате версии 0.
 class DogRepr {
 public:
     DogRepr() = default;
 
     explicit DogRepr(const model::Dog& dog)
         : id_(dog.GetId())
-        , name_(dog.GetName())
         , pos_(dog.GetPosition())
         , bag_capacity_(dog.GetBagCapacity())
         , speed_(dog.GetSpeed())
         , direction_(dog.GetDirection())
-        , score_(dog.GetScore())
-        , bag_content_(dog.GetBagContent()) {
+        , cold_{std::string{dog.GetName()}, dog.GetScore(),
+                {dog.GetBagContent().begin(), dog.GetBagContent().end()}} {
+    }
+
+    // Перезаписывает представление состоянием собаки dog.
+    // В отличие от конструктора, повторно использует память, выделенную под имя и рюкзак
+    void Assign(const model::Dog& dog) {
+        id_ = dog.GetId();
+        pos_ = dog.GetPosition();
+        bag_capacity_ = dog.GetBagCapacity();
+        speed_ = dog.GetSpeed();
+        direction_ = dog.GetDirection();
+        cold_.name.assign(dog.GetName());
+        cold_.score = dog.GetScore();
+        cold_.bag_content.assign(dog.GetBagContent().begin(), dog.GetBagContent().end());
+        cold_decoded_ = true;
+        cold_data_ = {};
+        cold_owner_.reset();
+    }
+
+    const model::Dog::Id& GetId() const noexcept {
+        return id_;
+    }
+
+    const geom::Point2D& GetPosition() const noexcept {
+        return pos_;
+    }
+
+    const geom::Vec2D& GetSpeed() const noexcept {
+        return speed_;
+    }
+
+    model::Direction GetDirection() const noexcept {
+        return direction_;
+    }
+
+    size_t GetBagCapacity() const noexcept {
+        return bag_capacity_;
+    }
+
+    const std::string& GetName() const {
+        return GetColdFields().name;
+    }
+
+    model::Score GetScore() const {
+        return GetColdFields().score;
+    }
+
+    const std::vector<model::FoundObject>& GetBagContent() const {
+        return GetColdFields().bag_content;
+    }
+
+    // Декодированы ли холодные поля
+    bool HasColdFields() const noexcept {
+        return cold_decoded_;
     }
 
+    // Восстанавливает собаку с собственной таблицей имён
     [[nodiscard]] model::Dog Restore() const {
-        model::Dog dog{id_, name_, pos_, bag_capacity_};
-        dog.SetSpeed(speed_);
-        dog.SetDirection(direction_);
-        dog.AddScore(score_);
-        for (const auto& item : bag_content_) {
-            if (!dog.PutToBag(item)) {
-                throw std::runtime_error("Failed to put bag content");
+        model::Dog dog{id_, GetName(), pos_, bag_capacity_};
+        RestoreState(dog);
+        return dog;
+    }
+
+    // Восстанавливает собаку, добавляя её имя в таблицу имён игры names.
+    // Таблица должна пережить собаку
+    [[nodiscard]] model::Dog Restore(model::NameTable& names) const {
+        model::Dog dog{id_, names, names.Intern(GetName()), pos_, bag_capacity_};
+        RestoreState(dog);
+        return dog;
+    }
+
+    template <typename Archive>
+    void serialize(Archive& ar, const unsigned version) {
+        if constexpr (ByteViewArchive<Archive>) {
+            if (version != 0) {
+                SerializeV1(ar);
+                return;
             }
         }
-        return dog;
+        SerializeV0(ar);
+    }
+
+private:
+    // id полей в таблице холодных полей
+    enum ColdField : uint8_t {
+        NAME = 1,
+        SCORE = 2,
+        BAG_CONTENT = 3,
+    };
+
+    struct ColdFields {
+        std::string name;
+        model::Score score = 0;
+        // Формат сериализации не зависит от того, как рюкзак хранится в model::Dog
+        std::vector<model::FoundObject> bag_content;
+    };
+
+    // Формат версии 1: горячие поля, затем фрагмент с таблицей холодных полей
+    template <ByteViewArchive Archive>
+    void SerializeV1(Archive& ar) {
+        ar&* id_;
+        ar& pos_;
+        ar& bag_capacity_;
+        ar& speed_;
+        ar& direction_;
+        if constexpr (Archive::is_saving::value) {
+            // Если холодные поля не декодировались, их фрагмент сохраняется как есть
+            if (cold_decoded_) {
+                ar.SaveBytesWith([this](std::string& out) {
+                    EncodeColdFields(out);
+                });
+            } else {
+                ar.SaveBytes(cold_data_);
+            }
+        } else {
+            cold_data_ = ar.LoadBytes();
+            cold_owner_ = ar.GetFrameBuffer();
+            cold_decoded_ = false;
+        }
     }
 
+    // Формат версии 0: все поля подряд
     template <typename Archive>
-    void serialize(Archive& ar, [[maybe_unused]] const unsigned version) {
+    void SerializeV0(Archive& ar) {
+        if constexpr (Archive::is_saving::value) {
+            GetColdFields();
+        }
         ar&* id_;
-        ar& name_;
+        ar& cold_.name;
         ar& pos_;
         ar& bag_capacity_;
         ar& speed_;
         ar& direction_;
-        ar& score_;
-        ar& bag_content_;
+        ar& cold_.score;
+        ar& cold_.bag_content;
+        if constexpr (Archive::is_loading::value) {
+            cold_decoded_ = true;
+            cold_data_ = {};
+            cold_owner_.reset();
+        }
     }
 
-private:
+    void RestoreState(model::Dog& dog) const {
+        const auto& cold = GetColdFields();
+        dog.SetSpeed(speed_);
+        dog.SetDirection(direction_);
+        dog.AddScore(cold.score);
+        if (!dog.PutToBag(cold.bag_content)) {
+            throw std::runtime_error("Failed to put bag content");
+        }
+    }
+
+    const ColdFields& GetColdFields() const {
+        if (!cold_decoded_) {
+            DecodeColdFields();
+        }
+        return cold_;
+    }
+
+    void EncodeColdFields(std::string& out) const {
+        FieldTableWriter writer{out};
+        writer.Add(NAME, cold_.name);
+        writer.AddUint32(SCORE, cold_.score);
+        const auto& bag = cold_.bag_content;
+        writer.AddWith(BAG_CONTENT, static_cast<uint32_t>(bag.size() * 8), [&bag](std::string& out) {
+            for (const auto& item : bag) {
+                FieldTableWriter::AppendUint32(out, *item.id);
+                FieldTableWriter::AppendUint32(out, item.type);
+            }
+        });
+    }
+
+    void DecodeColdFields() const {
+        ColdFields cold;
+        FieldTableReader reader{cold_data_};
+        uint8_t id = 0;
+        std::string_view value;
+        while (reader.Next(id, value)) {
+            switch (id) {
+                case NAME:
+                    cold.name.assign(value);
+                    break;
+                case SCORE:
+                    cold.score = FieldTableReader::ReadUint32(value);
+                    break;
+                case BAG_CONTENT:
+                    if (value.size() % 8 != 0) {
+                        throw std::runtime_error("Invalid bag content");
+                    }
+                    cold.bag_content.reserve(value.size() / 8);
+                    for (size_t pos = 0; pos < value.size(); pos += 8) {
+                        cold.bag_content.push_back(
+                            {model::FoundObject::Id{FieldTableReader::ReadUint32(value.substr(pos))},
+                             FieldTableReader::ReadUint32(value.substr(pos + 4))});
+                    }
+                    break;
+                default:
+                    // Поле, добавленное в более новой версии игры
+                    break;
+            }
+        }
+        cold_ = std::move(cold);
+        cold_decoded_ = true;
+        // Буфер кадра больше не нужен этой собаке
+        cold_data_ = {};
+        cold_owner_.reset();
+    }
+
+    // Горячие поля
     model::Dog::Id id_ = model::Dog::Id{0u};
-    std::string name_;
     geom::Point2D pos_;
     size_t bag_capacity_ = 0;
     geom::Vec2D speed_;
     model::Direction direction_ = model::Direction::NORTH;
-    model::Score score_ = 0;
-    model::Dog::BagContent bag_content_;
+
+    // Холодные поля и их закодированное представление во фрагменте буфера cold_owner_
+    mutable ColdFields cold_;
+    mutable std::string_view cold_data_;
+    mutable std::shared_ptr<const std::string> cold_owner_;
+    mutable bool cold_decoded_ = true;
 };
 
 /* Другие классы модели сериализуются и десериализуются похожим образом */
 
+// Предмет, лежащий на карте
+struct LostObjectRepr {
+    model::FoundObject object;
+    geom::Point2D position;
+
+    template <typename Archive>
+    void serialize(Archive& ar, [[maybe_unused]] const unsigned version) {
+        ar& object;
+        ar& position;
+    }
+};
+
+// Токен игрока и id его собаки
+struct PlayerRepr {
+    std::string token;
+    model::Dog::Id::ValueType dog_id = 0;
+
+    template <typename Archive>
+    void serialize(Archive& ar, [[maybe_unused]] const unsigned version) {
+        ar& token;
+        ar& dog_id;
+    }
+};
+
+// Состояние генератора трофеев карты
+struct LootGeneratorRepr {
+    // Время без появления трофеев, мс
+    int64_t time_without_loot = 0;
+    // Номер следующего трофея в последовательности генератора случайных чисел
+    uint64_t spawn_counter = 0;
+
+    template <typename Archive>
+    void serialize(Archive& ar, [[maybe_unused]] const unsigned version) {
+        ar& time_without_loot;
+        ar& spawn_counter;
+    }
+};
+
+// Состояние игры целиком
+struct GameStateRepr {
+    std::vector<DogRepr> dogs;
+    std::vector<LostObjectRepr> lost_objects;
+    std::vector<PlayerRepr> players;
+    LootGeneratorRepr loot_generator;
+
+    template <typename Archive>
+    void serialize(Archive& ar, [[maybe_unused]] const unsigned version) {
+        ar& dogs;
+        ar& lost_objects;
+        ar& players;
+        ar& loot_generator;
+    }
+};
+
 }  // namespace serialization
+
+BOOST_CLASS_VERSION(::serialization::DogRepr, 1)
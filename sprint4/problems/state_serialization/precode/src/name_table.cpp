@@ -0,0 +1,112 @@
+#include "name_table.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace model {
+
+NameRef NameTable::Intern(std::string_view name) {
+    if (indexed_count_ != names_.size()) {
+        // Имена, добавленные AppendUnique, индексируются при первом поиске
+        Rehash(std::bit_ceil(std::max((names_.size() + 1) * 2, size_t{8})));
+    }
+    const size_t hash = std::hash<std::string_view>{}(name);
+    if (!slots_.empty()) {
+        const size_t mask = slots_.size() - 1;
+        for (size_t pos = hash & mask; slots_[pos] != 0; pos = (pos + 1) & mask) {
+            if (names_[slots_[pos] - 1] == name) {
+                return {slots_[pos] - 1, static_cast<uint32_t>(name.size())};
+            }
+        }
+    }
+    if (name.size() > std::numeric_limits<uint32_t>::max()
+        || names_.size() >= std::numeric_limits<uint32_t>::max() - 1) {
+        throw std::length_error("Name table is full");
+    }
+
+    // Заполненность таблицы не превышает половины
+    if ((names_.size() + 1) * 2 > slots_.size()) {
+        Rehash(std::max(slots_.size() * 2, size_t{8}));
+    }
+    const auto index = static_cast<uint32_t>(names_.size());
+    names_.emplace_back(Store(name), name.size());
+    const size_t mask = slots_.size() - 1;
+    size_t pos = hash & mask;
+    while (slots_[pos] != 0) {
+        pos = (pos + 1) & mask;
+    }
+    slots_[pos] = index + 1;
+    ++indexed_count_;
+    return {index, static_cast<uint32_t>(name.size())};
+}
+
+void NameTable::AppendUnique(std::string_view pool, std::span<const uint32_t> offsets) {
+    if (offsets.size() < 2) {
+        return;
+    }
+    const size_t count = offsets.size() - 1;
+    if (count >= std::numeric_limits<uint32_t>::max() - 1 - names_.size()) {
+        throw std::length_error("Name table is full");
+    }
+    if (offsets.back() > pool.size() || !std::ranges::is_sorted(offsets)) {
+        throw std::out_of_range("Invalid name pool offsets");
+    }
+    const size_t first = offsets.front();
+    const char* data = Store(pool.substr(first, offsets.back() - first));
+    names_.reserve(names_.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+        names_.emplace_back(data + (offsets[i] - first), offsets[i + 1] - offsets[i]);
+    }
+}
+
+void NameTable::Reserve(size_t count) {
+    names_.reserve(count);
+    if (count * 2 > slots_.size()) {
+        Rehash(std::bit_ceil(count * 2));
+    }
+}
+
+void NameTable::Rehash(size_t slot_count) {
+    std::vector<uint32_t> slots(slot_count, 0);
+    const size_t mask = slot_count - 1;
+    for (uint32_t index = 0; index < names_.size(); ++index) {
+        size_t pos = std::hash<std::string_view>{}(names_[index]) & mask;
+        while (slots[pos] != 0) {
+            pos = (pos + 1) & mask;
+        }
+        slots[pos] = index + 1;
+    }
+    slots_ = std::move(slots);
+    indexed_count_ = names_.size();
+}
+
+const char* NameTable::Store(std::string_view name) {
+    if (name.empty()) {
+        return "";
+    }
+    if (name.size() > MAX_BLOCK_SIZE / 4) {
+        // Длинное имя получает собственный блок, чтобы не тратить остаток общего
+        auto& block = blocks_.emplace_back(std::make_unique_for_overwrite<char[]>(name.size()));
+        std::memcpy(block.get(), name.data(), name.size());
+        return block.get();
+    }
+    if (name.size() > block_free_) {
+        // Блоки растут вдвое, чтобы таблица из нескольких имён оставалась маленькой
+        next_block_size_ = std::max(next_block_size_, name.size());
+        block_pos_ = blocks_.emplace_back(std::make_unique_for_overwrite<char[]>(next_block_size_))
+                         .get();
+        block_free_ = next_block_size_;
+        next_block_size_ = std::min(next_block_size_ * 2, MAX_BLOCK_SIZE);
+    }
+    char* result = block_pos_;
+    std::memcpy(result, name.data(), name.size());
+    block_pos_ += name.size();
+    block_free_ -= name.size();
+    return result;
+}
+
+}  // namespace model
@@ -0,0 +1,83 @@
+#pragma once
+#include <compare>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace model {
+
+// Ссылка на имя в таблице имён: номер имени и его длина
+struct NameRef {
+    uint32_t index = 0;
+    uint32_t length = 0;
+
+    auto operator<=>(const NameRef&) const = default;
+};
+
+/*
+ * Таблица имён игры (string interner).
+ *
+ * Каждое имя хранится один раз в блоках памяти, которые никогда не перемещаются,
+ * поэтому полученные из таблицы std::string_view остаются действительными,
+ * пока существует сама таблица. Короткие имена размещаются подряд в общих блоках,
+ * размер которых растёт вдвое до 64 КБ, так что добавление имени, как правило,
+ * не выделяет память.
+ * Таблица принадлежит игре, а собаки и другие объекты хранят лишь представления
+ * её строк, поэтому таблица должна пережить всех, кто ссылается на её имена.
+ * Методы, добавляющие имена, нельзя вызывать одновременно с другими методами.
+ */
+class NameTable {
+public:
+    NameTable() = default;
+
+    NameTable(const NameTable&) = delete;
+    NameTable& operator=(const NameTable&) = delete;
+
+    // Возвращает ссылку на имя, добавляя его в таблицу, если его там ещё нет
+    NameRef Intern(std::string_view name);
+
+    // Добавляет различные имена, записанные подряд в pool: имя i занимает
+    // [offsets[i], offsets[i + 1]). Имена получают номера, начиная с GetCount().
+    // Пул копируется одним блоком, а индекс поиска по этим именам строится при
+    // следующем вызове Intern, поэтому загрузка таблицы из снимка не хеширует имена.
+    // Имён из пула не должно быть в таблице, иначе они будут храниться дважды
+    void AppendUnique(std::string_view pool, std::span<const uint32_t> offsets);
+
+    std::string_view Get(NameRef ref) const noexcept {
+        return {names_[ref.index].data(), ref.length};
+    }
+
+    std::string_view GetByIndex(uint32_t index) const noexcept {
+        return names_[index];
+    }
+
+    size_t GetCount() const noexcept {
+        return names_.size();
+    }
+
+    void Reserve(size_t count);
+
+private:
+    static constexpr size_t MIN_BLOCK_SIZE = 64;
+    static constexpr size_t MAX_BLOCK_SIZE = 64 * 1024;
+
+    const char* Store(std::string_view name);
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    size_t next_block_size_ = MIN_BLOCK_SIZE;
+    size_t block_free_ = 0;
+    char* block_pos_ = nullptr;
+
+    void Rehash(size_t slot_count);
+
+    std::vector<std::string_view> names_;
+    // Хеш-таблица с открытой адресацией: номер имени + 1 или 0 в пустых ячейках.
+    // В отличие от std::unordered_map, не выделяет память под каждое имя
+    std::vector<uint32_t> slots_;
+    // Количество первых имён names_, добавленных в slots_
+    size_t indexed_count_ = 0;
+};
+
+}  // namespace model
@@ -0,0 +1,213 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tagged.h"
+
+namespace util {
+
+/*
+ * Плотное хранилище объектов с идентификаторами Tagged-типа (slot map).
+ *
+ * Идентификатор состоит из номера ячейки (младшие INDEX_BITS бит) и поколения
+ * (старшие биты). Поиск по идентификатору - это обращение к ячейке по номеру
+ * и сравнение поколения, без вычисления хеша. При удалении поколение ячейки
+ * увеличивается, поэтому устаревшие идентификаторы больше ничего не находят,
+ * а ячейка используется повторно. Ячейка, поколение которой исчерпано,
+ * больше не используется.
+ *
+ * Сами объекты хранятся подряд в векторе (при удалении на место удалённого
+ * переносится последний), поэтому обход всех объектов идёт по непрерывной памяти.
+ * Указатели и ссылки на объекты действительны только до следующей вставки или удаления.
+ *
+ * Пример:
+ *   util::SlotMap<Dog::Id, Dog> dogs;
+ *   const auto id = dogs.Insert([&](Dog::Id id) {
+ *       return Dog{id, names, name, pos, bag_cap};
+ *   });
+ *   if (Dog* dog = dogs.Find(id)) { ... }
+ */
+template <typename Id, typename T,
+          unsigned INDEX_BITS = std::numeric_limits<typename Id::ValueType>::digits * 2 / 3>
+class SlotMap {
+    using IdValue = typename Id::ValueType;
+    static_assert(std::is_unsigned_v<IdValue>);
+    static_assert(INDEX_BITS > 0 && INDEX_BITS < std::numeric_limits<IdValue>::digits);
+
+public:
+    static constexpr IdValue INDEX_MASK = (IdValue{1} << INDEX_BITS) - 1;
+    static constexpr IdValue MAX_GENERATION
+        = std::numeric_limits<IdValue>::max() >> INDEX_BITS;
+    static constexpr size_t MAX_SLOTS = size_t{INDEX_MASK} + 1;
+
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    static IdValue GetIndex(const Id& id) noexcept {
+        return *id & INDEX_MASK;
+    }
+
+    static IdValue GetGeneration(const Id& id) noexcept {
+        return *id >> INDEX_BITS;
+    }
+
+    // Добавляет объект, созданный функцией make(Id), и возвращает его идентификатор.
+    // Выбрасывает std::length_error, если свободных ячеек не осталось
+    template <typename Make>
+        requires std::is_invocable_r_v<T, Make, Id>
+    Id Insert(Make&& make) {
+        const IdValue index = AcquireSlot();
+        const Id id{static_cast<IdValue>((slots_[index].generation << INDEX_BITS) | index)};
+        try {
+            ids_.push_back(id);
+            values_.push_back(std::forward<Make>(make)(id));
+        } catch (...) {
+            if (ids_.size() > values_.size()) {
+                ids_.pop_back();
+            }
+            ReleaseSlot(index);
+            throw;
+        }
+        Slot& slot = slots_[index];
+        slot.dense_index = static_cast<uint32_t>(values_.size() - 1);
+        slot.occupied = true;
+        return id;
+    }
+
+    Id Insert(T value) {
+        return Insert([&value](const Id&) -> T {
+            return std::move(value);
+        });
+    }
+
+    T* Find(const Id& id) noexcept {
+        const Slot* slot = FindSlot(id);
+        return slot ? &values_[slot->dense_index] : nullptr;
+    }
+
+    const T* Find(const Id& id) const noexcept {
+        const Slot* slot = FindSlot(id);
+        return slot ? &values_[slot->dense_index] : nullptr;
+    }
+
+    bool Contains(const Id& id) const noexcept {
+        return FindSlot(id) != nullptr;
+    }
+
+    // Удаляет объект. Возвращает false, если идентификатор устарел или неизвестен
+    bool Erase(const Id& id) {
+        Slot* slot = FindSlot(id);
+        if (!slot) {
+            return false;
+        }
+        const uint32_t dense_index = slot->dense_index;
+        if (dense_index + 1 != values_.size()) {
+            values_[dense_index] = std::move(values_.back());
+            ids_[dense_index] = ids_.back();
+            slots_[GetIndex(ids_[dense_index])].dense_index = dense_index;
+        }
+        values_.pop_back();
+        ids_.pop_back();
+
+        slot->occupied = false;
+        if (slot->generation < MAX_GENERATION) {
+            ++slot->generation;
+            ReleaseSlot(GetIndex(id));
+        }
+        return true;
+    }
+
+    void Clear() {
+        while (!ids_.empty()) {
+            Erase(ids_.back());
+        }
+    }
+
+    size_t Size() const noexcept {
+        return values_.size();
+    }
+
+    bool IsEmpty() const noexcept {
+        return values_.empty();
+    }
+
+    void Reserve(size_t count) {
+        values_.reserve(count);
+        ids_.reserve(count);
+        slots_.reserve(std::min(count, MAX_SLOTS));
+    }
+
+    // Идентификатор объекта, который при обходе идёт под номером dense_index
+    const Id& GetIdAt(size_t dense_index) const noexcept {
+        return ids_[dense_index];
+    }
+
+    iterator begin() noexcept {
+        return values_.begin();
+    }
+
+    iterator end() noexcept {
+        return values_.end();
+    }
+
+    const_iterator begin() const noexcept {
+        return values_.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return values_.end();
+    }
+
+private:
+    static constexpr uint32_t NO_FREE_SLOT = std::numeric_limits<uint32_t>::max();
+
+    struct Slot {
+        // Для занятой ячейки - номер объекта в values_, для свободной - следующая свободная ячейка
+        uint32_t dense_index = NO_FREE_SLOT;
+        IdValue generation = 0;
+        bool occupied = false;
+    };
+
+    IdValue AcquireSlot() {
+        if (free_head_ != NO_FREE_SLOT) {
+            const uint32_t index = free_head_;
+            free_head_ = slots_[index].dense_index;
+            return static_cast<IdValue>(index);
+        }
+        if (slots_.size() >= MAX_SLOTS || slots_.size() >= NO_FREE_SLOT) {
+            throw std::length_error("Slot map is full");
+        }
+        slots_.emplace_back();
+        return static_cast<IdValue>(slots_.size() - 1);
+    }
+
+    void ReleaseSlot(IdValue index) noexcept {
+        slots_[index].dense_index = free_head_;
+        free_head_ = static_cast<uint32_t>(index);
+    }
+
+    Slot* FindSlot(const Id& id) noexcept {
+        return const_cast<Slot*>(std::as_const(*this).FindSlot(id));
+    }
+
+    const Slot* FindSlot(const Id& id) const noexcept {
+        const IdValue index = GetIndex(id);
+        if (index >= slots_.size()) {
+            return nullptr;
+        }
+        const Slot& slot = slots_[index];
+        return slot.occupied && slot.generation == GetGeneration(id) ? &slot : nullptr;
+    }
+
+    std::vector<Slot> slots_;
+    std::vector<T> values_;
+    std::vector<Id> ids_;
+    uint32_t free_head_ = NO_FREE_SLOT;
+};
+
+}  // namespace util
@@ -0,0 +1,239 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace util {
+
+/*
+ * Вектор, хранящий до N элементов прямо внутри себя, без выделения памяти в куче.
+ * Если элементов становится больше, они переносятся в динамическую память.
+ * Размер, вместимость и встроенные элементы лежат рядом, поэтому проверка
+ * заполненности и добавление элемента во встроенный буфер обращаются
+ * к одной и той же строке кэша.
+ * Поддерживаются только тривиально копируемые типы элементов.
+ */
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(N > 0);
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+
+    static constexpr size_t INLINE_CAPACITY = N;
+
+    SmallVector() noexcept = default;
+
+    SmallVector(std::initializer_list<T> items) {
+        assign(items.begin(), items.end());
+    }
+
+    SmallVector(const SmallVector& other) {
+        assign(other.begin(), other.end());
+    }
+
+    SmallVector(SmallVector&& other) noexcept {
+        MoveFrom(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            Free();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        Free();
+    }
+
+    size_t size() const noexcept {
+        return size_;
+    }
+
+    size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Хранятся ли элементы во встроенном буфере
+    bool is_inline() const noexcept {
+        return capacity_ == N;
+    }
+
+    T* data() noexcept {
+        return is_inline() ? InlineData() : heap_;
+    }
+
+    const T* data() const noexcept {
+        return is_inline() ? InlineData() : heap_;
+    }
+
+    iterator begin() noexcept {
+        return data();
+    }
+
+    iterator end() noexcept {
+        return data() + size_;
+    }
+
+    const_iterator begin() const noexcept {
+        return data();
+    }
+
+    const_iterator end() const noexcept {
+        return data() + size_;
+    }
+
+    T& operator[](size_t index) noexcept {
+        return data()[index];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return data()[index];
+    }
+
+    T& back() noexcept {
+        return data()[size_ - 1];
+    }
+
+    const T& back() const noexcept {
+        return data()[size_ - 1];
+    }
+
+    void reserve(size_t capacity) {
+        if (capacity > capacity_) {
+            Reallocate(capacity);
+        }
+    }
+
+    void push_back(const T& item) {
+        if (size_ == capacity_) {
+            // item может быть элементом самого вектора, поэтому копируется до переноса
+            const T copy = item;
+            Reallocate(static_cast<size_t>(capacity_) * 2);
+            data()[size_++] = copy;
+            return;
+        }
+        data()[size_++] = item;
+    }
+
+    template <typename It>
+    void insert(const_iterator pos, It first, It last) {
+        if (pos != end()) {
+            throw std::logic_error("SmallVector supports insertion only at the end");
+        }
+        const auto count = static_cast<size_t>(std::distance(first, last));
+        if (count <= capacity_ - size_) {
+            std::copy(first, last, data() + size_);
+        } else {
+            // [first, last) может указывать на элементы самого вектора,
+            // поэтому старый буфер освобождается только после копирования.
+            // Вместимость растёт как минимум вдвое, как в push_back, чтобы серия
+            // вставок в конец не перераспределяла память на каждой вставке
+            const size_t capacity = std::max(size_ + count, static_cast<size_t>(capacity_) * 2);
+            T* heap = Allocate(capacity);
+            std::memcpy(static_cast<void*>(heap), data(), size_ * sizeof(T));
+            std::copy(first, last, heap + size_);
+            Replace(heap, capacity);
+        }
+        size_ += static_cast<uint32_t>(count);
+    }
+
+    // Выделяет ровно столько памяти, сколько нужно для [first, last)
+    template <typename It>
+    void assign(It first, It last) {
+        clear();
+        // Элементы самого вектора в нём помещаются, поэтому reserve не делает их недействительными
+        reserve(static_cast<size_t>(std::distance(first, last)));
+        insert(end(), first, last);
+    }
+
+    void clear() noexcept {
+        size_ = 0;
+    }
+
+    friend bool operator==(const SmallVector& lhs, const SmallVector& rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    T* InlineData() noexcept {
+        return std::launder(reinterpret_cast<T*>(storage_));
+    }
+
+    const T* InlineData() const noexcept {
+        return std::launder(reinterpret_cast<const T*>(storage_));
+    }
+
+    static T* Allocate(size_t capacity) {
+        if (capacity > UINT32_MAX) {
+            throw std::length_error("SmallVector is too large");
+        }
+        return std::allocator<T>{}.allocate(capacity);
+    }
+
+    void Reallocate(size_t capacity) {
+        T* heap = Allocate(capacity);
+        std::memcpy(static_cast<void*>(heap), data(), size_ * sizeof(T));
+        Replace(heap, capacity);
+    }
+
+    // Заменяет текущий буфер динамической памятью heap
+    void Replace(T* heap, size_t capacity) noexcept {
+        Free();
+        heap_ = heap;
+        capacity_ = static_cast<uint32_t>(capacity);
+    }
+
+    void Free() noexcept {
+        if (!is_inline()) {
+            std::allocator<T>{}.deallocate(heap_, capacity_);
+            capacity_ = N;
+        }
+    }
+
+    void MoveFrom(SmallVector& other) noexcept {
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        if (other.is_inline()) {
+            std::memcpy(storage_, other.storage_, other.size_ * sizeof(T));
+        } else {
+            heap_ = other.heap_;
+            other.capacity_ = N;
+        }
+        other.size_ = 0;
+    }
+
+    uint32_t size_ = 0;
+    uint32_t capacity_ = N;
+    // Встроенный буфер, а после переноса в кучу - указатель на динамическую память
+    union {
+        alignas(T) unsigned char storage_[N * sizeof(T)];
+        T* heap_;
+    };
+};
+
+}  // namespace util
@@ -0,0 +1,202 @@
+#include "snapshot_file_writer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <stdexcept>
+
+#include "file_util.h"
+
+namespace serialization {
+
+namespace {
+
+using namespace std::literals;
+namespace fs = std::filesystem;
+
+constexpr std::string_view SNAPSHOT_EXTENSION = ".snapshot"sv;
+constexpr size_t GENERATION_DIGITS = 20;
+
+std::string MakeFileName(std::string_view name, uint64_t generation) {
+    std::string digits = std::to_string(generation);
+    std::string result{name};
+    result += '.';
+    result.append(GENERATION_DIGITS - digits.size(), '0');
+    result += digits;
+    result += SNAPSHOT_EXTENSION;
+    return result;
+}
+
+// Извлекает номер поколения из имени файла <name>.<номер>.snapshot
+std::optional<uint64_t> ParseGeneration(std::string_view file_name, std::string_view name) {
+    if (file_name.size() != name.size() + 1 + GENERATION_DIGITS + SNAPSHOT_EXTENSION.size()
+        || !file_name.starts_with(name) || file_name[name.size()] != '.'
+        || !file_name.ends_with(SNAPSHOT_EXTENSION)) {
+        return std::nullopt;
+    }
+    const char* first = file_name.data() + name.size() + 1;
+    const char* last = first + GENERATION_DIGITS;
+    uint64_t generation = 0;
+    const auto [ptr, ec] = std::from_chars(first, last, generation);
+    if (ec != std::errc{} || ptr != last) {
+        return std::nullopt;
+    }
+    return generation;
+}
+
+std::vector<std::pair<uint64_t, fs::path>> FindGenerations(const fs::path& directory,
+                                                           std::string_view name) {
+    std::vector<std::pair<uint64_t, fs::path>> result;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator{directory, ec}) {
+        if (const auto generation = ParseGeneration(entry.path().filename().native(), name)) {
+            result.emplace_back(*generation, entry.path());
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first > rhs.first;
+    });
+    return result;
+}
+
+}  // namespace
+
+void SnapshotFileWriter::AlignedDeleter::operator()(char* buffer) const noexcept {
+    ::operator delete[](buffer, std::align_val_t{ALIGNMENT});
+}
+
+SnapshotFileWriter::SnapshotFileWriter(Config config)
+    : config_{std::move(config)} {
+    if (config_.generations == 0) {
+        throw std::invalid_argument("At least one snapshot generation must be kept");
+    }
+    if (config_.block_size == 0 || config_.block_size % ALIGNMENT != 0) {
+        throw std::invalid_argument("Block size must be a multiple of "s
+                                    + std::to_string(ALIGNMENT));
+    }
+    if (config_.name.empty() || config_.name.find('/') != std::string::npos) {
+        throw std::invalid_argument("Invalid snapshot name");
+    }
+    fs::create_directories(config_.directory);
+    if (const auto generations = FindGenerations(config_.directory, config_.name);
+        !generations.empty()) {
+        next_generation_ = generations.front().first + 1;
+    }
+    if (config_.direct_io) {
+        buffer_.reset(static_cast<char*>(
+            ::operator new[](config_.block_size, std::align_val_t{ALIGNMENT})));
+    }
+}
+
+fs::path SnapshotFileWriter::Write(std::string_view data) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto path = config_.directory / MakeFileName(config_.name, next_generation_);
+
+    bool direct_io = false;
+    try {
+        ReplaceFile(path, [this, data, &direct_io](const fs::path& temp_path) {
+            WriteFile(temp_path, data, direct_io);
+        });
+    } catch (...) {
+        std::lock_guard lock{metrics_mutex_};
+        ++metrics_.failed;
+        throw;
+    }
+    ++next_generation_;
+
+    // Новое поколение уже заменило собой файл, поэтому дальнейшие ошибки не делают
+    // запись неудачной. Старые поколения удаляются, только когда переименование
+    // сброшено на диск, а их удаление зафиксирует синхронизация при следующей записи
+    bool synced = true;
+    try {
+        SyncDirectory(config_.directory);
+        RemoveOldGenerations();
+    } catch (const std::exception&) {
+        synced = false;
+    }
+
+    const auto write_time = std::chrono::steady_clock::now() - start;
+    std::lock_guard lock{metrics_mutex_};
+    ++metrics_.written;
+    if (!synced) {
+        ++metrics_.sync_failed;
+    }
+    metrics_.total_bytes += data.size();
+    metrics_.total_write_time += write_time;
+    metrics_.last_write_time = write_time;
+    metrics_.max_write_time = std::max(metrics_.max_write_time, write_time);
+    metrics_.last_size = data.size();
+    metrics_.last_direct_io = direct_io;
+    metrics_.last_synced = synced;
+    return path;
+}
+
+void SnapshotFileWriter::WriteFile(const fs::path& path, std::string_view data, bool& direct_io) {
+    constexpr int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    int raw_fd = -1;
+    if (config_.direct_io) {
+        raw_fd = ::open(path.c_str(), flags | O_DIRECT, 0644);
+        direct_io = raw_fd >= 0;
+    }
+    if (raw_fd < 0) {
+        // Например, tmpfs не поддерживает O_DIRECT
+        raw_fd = ::open(path.c_str(), flags, 0644);
+    }
+    FileDescriptor fd{raw_fd};
+    if (fd.Get() < 0) {
+        ThrowSystemError("Failed to create "s + path.string());
+    }
+
+    const std::string write_error = "Failed to write "s + path.string();
+    if (!direct_io) {
+        WriteAll(fd.Get(), data, write_error);
+    } else {
+        // С O_DIRECT и адрес буфера, и размер блока должны быть выровнены,
+        // поэтому последний блок дополняется нулями, а затем файл обрезается
+        char* buffer = buffer_.get();
+        for (size_t offset = 0; offset < data.size(); offset += config_.block_size) {
+            const size_t size = std::min(config_.block_size, data.size() - offset);
+            const size_t aligned_size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+            std::memcpy(buffer, data.data() + offset, size);
+            std::memset(buffer + size, 0, aligned_size - size);
+            WriteAll(fd.Get(), {buffer, aligned_size}, write_error);
+        }
+        if (::ftruncate(fd.Get(), static_cast<off_t>(data.size())) != 0) {
+            ThrowSystemError("Failed to truncate "s + path.string());
+        }
+    }
+
+    if (::fsync(fd.Get()) != 0) {
+        ThrowSystemError("Failed to sync "s + path.string());
+    }
+}
+
+void SnapshotFileWriter::RemoveOldGenerations() {
+    const auto generations = FindGenerations(config_.directory, config_.name);
+    for (size_t i = config_.generations; i < generations.size(); ++i) {
+        std::error_code ec;
+        fs::remove(generations[i].second, ec);
+    }
+}
+
+SnapshotFileWriter::Metrics SnapshotFileWriter::GetMetrics() const {
+    std::lock_guard lock{metrics_mutex_};
+    return metrics_;
+}
+
+std::vector<fs::path> SnapshotFileWriter::ListGenerations(const fs::path& directory,
+                                                          std::string_view name) {
+    std::vector<fs::path> result;
+    for (auto& [generation, path] : FindGenerations(directory, name)) {
+        result.push_back(std::move(path));
+    }
+    return result;
+}
+
+}  // namespace serialization
@@ -0,0 +1,106 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace serialization {
+
+/*
+ * Атомарно записывает снимки состояния в файлы, переживая сбой посреди записи.
+ *
+ * Каждый снимок сначала целиком записывается во временный файл, сбрасывается
+ * на диск (fsync) и только затем переименовывается в файл очередного поколения
+ * <name>.<номер>.snapshot. Хранятся последние generations поколений, поэтому
+ * повреждённый или незаписанный снимок никогда не затирает предыдущий.
+ * Данные пишутся напрямую системным вызовом write большими блоками, без
+ * промежуточной буферизации std::ofstream. С direct_io файл открывается с O_DIRECT,
+ * а данные копируются в выровненный буфер; если файловая система не поддерживает
+ * O_DIRECT, используется обычная запись.
+ *
+ * Подходит в качестве Writer для StateSnapshotter:
+ *   StateSnapshotter snapshotter{[&file_writer](std::string_view data) {
+ *       file_writer.Write(data);
+ *   }};
+ */
+class SnapshotFileWriter {
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    // Выравнивание буфера, смещений и размеров блоков для O_DIRECT
+    static constexpr size_t ALIGNMENT = 4096;
+
+    struct Config {
+        std::filesystem::path directory;
+        std::string name = "state";
+        // Количество хранимых поколений снимков
+        size_t generations = 3;
+        // Размер блока записи, кратный ALIGNMENT
+        size_t block_size = size_t{1} << 20;
+        bool direct_io = false;
+    };
+
+    struct Metrics {
+        uint64_t written = 0;
+        uint64_t failed = 0;
+        // Записанные снимки, после переименования которых не удалось синхронизировать
+        // каталог. Такой снимок уже заменил собой файл поколения, но переименование
+        // может не пережить сбой питания, а старые поколения сохраняются
+        uint64_t sync_failed = 0;
+        uint64_t total_bytes = 0;
+        // Время записи, включая fsync и переименование
+        Duration total_write_time{};
+        Duration last_write_time{};
+        Duration max_write_time{};
+        size_t last_size = 0;
+        // Использовался ли O_DIRECT при последней записи
+        bool last_direct_io = false;
+        // Синхронизирован ли каталог после последней записи
+        bool last_synced = false;
+
+        // Пропускная способность записи, байт в секунду
+        double GetThroughput() const noexcept {
+            const auto seconds = std::chrono::duration<double>(total_write_time).count();
+            return seconds > 0 ? total_bytes / seconds : 0.0;
+        }
+    };
+
+    // Выбрасывает std::invalid_argument при некорректной конфигурации
+    explicit SnapshotFileWriter(Config config);
+
+    SnapshotFileWriter(const SnapshotFileWriter&) = delete;
+    SnapshotFileWriter& operator=(const SnapshotFileWriter&) = delete;
+
+    // Записывает снимок очередного поколения и возвращает путь к нему.
+    // При ошибке записи выбрасывает std::system_error, а предыдущие поколения остаются
+    // нетронутыми. Ошибка синхронизации каталога после переименования не считается
+    // ошибкой записи и учитывается в Metrics::sync_failed
+    std::filesystem::path Write(std::string_view data);
+
+    Metrics GetMetrics() const;
+
+    // Возвращает файлы поколений снимков в каталоге, начиная с самого нового
+    static std::vector<std::filesystem::path> ListGenerations(
+        const std::filesystem::path& directory, std::string_view name);
+
+private:
+    struct AlignedDeleter {
+        void operator()(char* buffer) const noexcept;
+    };
+
+    void WriteFile(const std::filesystem::path& path, std::string_view data, bool& direct_io);
+    void RemoveOldGenerations();
+
+    Config config_;
+    uint64_t next_generation_ = 0;
+    std::unique_ptr<char, AlignedDeleter> buffer_;
+
+    mutable std::mutex metrics_mutex_;
+    Metrics metrics_;
+};
+
+}  // namespace serialization
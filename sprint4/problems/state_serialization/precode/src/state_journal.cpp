@@ -0,0 +1,218 @@
+#include "state_journal.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include "binary_archive.h"
+#include "file_util.h"
+
+namespace serialization {
+
+namespace {
+
+using namespace std::literals;
+
+template <typename T>
+std::string Encode(const T& value) {
+    std::ostringstream strm;
+    BinaryOutputArchive output_archive{strm};
+    output_archive << value;
+    return std::move(strm).str();
+}
+
+// Применяет изменения к состоянию, поддерживая индексы объектов по id
+class DeltaApplier {
+public:
+    explicit DeltaApplier(GameStateRepr& state)
+        : state_{state} {
+        for (size_t i = 0; i < state_.dogs.size(); ++i) {
+            dog_index_.emplace(*state_.dogs[i].GetId(), i);
+        }
+        for (size_t i = 0; i < state_.lost_objects.size(); ++i) {
+            loot_index_.emplace(*state_.lost_objects[i].object.id, i);
+        }
+        for (size_t i = 0; i < state_.players.size(); ++i) {
+            player_index_.emplace(state_.players[i].token, i);
+        }
+    }
+
+    void Apply(const TickDeltaRepr& delta) {
+        for (const auto& dog : delta.changed_dogs) {
+            Upsert(state_.dogs, dog_index_, *dog.GetId(), dog);
+        }
+        for (const auto& loot : delta.spawned_loot) {
+            Upsert(state_.lost_objects, loot_index_, *loot.object.id, loot);
+        }
+        for (const auto id : delta.collected_loot) {
+            Erase(state_.lost_objects, loot_index_, id, [](const LostObjectRepr& loot) {
+                return *loot.object.id;
+            });
+        }
+        for (const auto& player : delta.joined_players) {
+            Upsert(state_.players, player_index_, player.token, player);
+        }
+        for (const auto id : delta.retired_dogs) {
+            Erase(state_.dogs, dog_index_, id, [](const DogRepr& dog) {
+                return *dog.GetId();
+            });
+            RetirePlayersOf(id);
+        }
+        state_.loot_generator = delta.loot_generator;
+    }
+
+private:
+    template <typename T, typename Key, typename Index>
+    static void Upsert(std::vector<T>& items, Index& index, const Key& key, const T& item) {
+        if (auto it = index.find(key); it != index.end()) {
+            items[it->second] = item;
+        } else {
+            index.emplace(key, items.size());
+            items.push_back(item);
+        }
+    }
+
+    // Удаляет элемент, перемещая на его место последний
+    template <typename T, typename Key, typename Index, typename GetKey>
+    static void Erase(std::vector<T>& items, Index& index, const Key& key, GetKey get_key) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return;
+        }
+        const size_t pos = it->second;
+        index.erase(it);
+        if (pos + 1 != items.size()) {
+            items[pos] = std::move(items.back());
+            index[get_key(items[pos])] = pos;
+        }
+        items.pop_back();
+    }
+
+    void RetirePlayersOf(model::Dog::Id::ValueType dog_id) {
+        for (size_t i = 0; i < state_.players.size();) {
+            if (state_.players[i].dog_id == dog_id) {
+                Erase(state_.players, player_index_, std::string{state_.players[i].token},
+                      [](const PlayerRepr& player) {
+                          return player.token;
+                      });
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    GameStateRepr& state_;
+    std::unordered_map<model::Dog::Id::ValueType, size_t> dog_index_;
+    std::unordered_map<model::FoundObject::Id::ValueType, size_t> loot_index_;
+    std::unordered_map<std::string, size_t> player_index_;
+};
+
+// Читает записи журнала до конца файла или до первой повреждённой записи.
+// Возвращает длину корректной части журнала
+template <typename Fn>
+std::streamoff ReadLog(const std::filesystem::path& path, Fn&& on_delta) {
+    std::ifstream input{path, std::ios::binary};
+    if (!input) {
+        return 0;
+    }
+    BinaryInputArchive input_archive{input};
+    std::streamoff valid_length = 0;
+    while (input.peek() != std::char_traits<char>::eof()) {
+        TickDeltaRepr delta;
+        try {
+            input_archive >> delta;
+        } catch (const std::exception&) {
+            // Последняя запись могла быть записана не полностью
+            break;
+        }
+        valid_length = input.tellg();
+        on_delta(delta);
+    }
+    return valid_length;
+}
+
+}  // namespace
+
+void ApplyDelta(GameStateRepr& state, const TickDeltaRepr& delta) {
+    DeltaApplier{state}.Apply(delta);
+}
+
+StateJournal::StateJournal(std::filesystem::path directory, Config config)
+    : directory_{std::move(directory)}
+    , config_{config} {
+    std::filesystem::create_directories(directory_);
+    OpenLog(false);
+    // Отрезаем недописанный хвост, иначе новые записи окажутся после него
+    const auto valid_length = ReadLog(GetLogPath(directory_), [this](const TickDeltaRepr&) {
+        ++appended_since_compaction_;
+    });
+    if (::ftruncate(log_fd_, valid_length) != 0) {
+        ::close(log_fd_);
+        ThrowSystemError("Failed to truncate journal"s);
+    }
+}
+
+StateJournal::~StateJournal() {
+    if (log_fd_ >= 0) {
+        ::close(log_fd_);
+    }
+}
+
+void StateJournal::OpenLog(bool truncate) {
+    if (log_fd_ >= 0) {
+        ::close(log_fd_);
+        log_fd_ = -1;
+    }
+    const int flags = O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0);
+    log_fd_ = ::open(GetLogPath(directory_).c_str(), flags, 0644);
+    if (log_fd_ < 0) {
+        ThrowSystemError("Failed to open journal"s);
+    }
+}
+
+void StateJournal::Append(const TickDeltaRepr& delta) {
+    WriteAll(log_fd_, Encode(delta), "Failed to write journal"sv);
+    if (config_.sync_each_append && ::fdatasync(log_fd_) != 0) {
+        ThrowSystemError("Failed to sync journal"s);
+    }
+    ++appended_since_compaction_;
+}
+
+void StateJournal::Compact(const GameStateRepr& state, uint64_t tick) {
+    std::ostringstream strm;
+    BinaryOutputArchive output_archive{strm};
+    output_archive << tick << state;
+    WriteFileAtomically(GetSnapshotPath(directory_), std::move(strm).str());
+    // Если сбой произойдёт до очистки журнала, его записи будут пропущены
+    // при восстановлении, так как их тики не больше тика снимка
+    OpenLog(true);
+    appended_since_compaction_ = 0;
+}
+
+StateJournal::RecoveredState StateJournal::Recover(const std::filesystem::path& directory) {
+    RecoveredState result;
+    bool has_snapshot = false;
+    if (std::ifstream input{GetSnapshotPath(directory), std::ios::binary}) {
+        BinaryInputArchive input_archive{input};
+        input_archive >> result.tick >> result.state;
+        has_snapshot = true;
+    }
+    const uint64_t snapshot_tick = result.tick;
+
+    DeltaApplier applier{result.state};
+    ReadLog(GetLogPath(directory), [&](const TickDeltaRepr& delta) {
+        // Изменения, уже вошедшие в снимок
+        if (has_snapshot && delta.tick <= snapshot_tick) {
+            return;
+        }
+        applier.Apply(delta);
+        result.tick = delta.tick;
+        ++result.replayed_deltas;
+    });
+    return result;
+}
+
+}  // namespace serialization
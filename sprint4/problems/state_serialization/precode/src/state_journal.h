@@ -0,0 +1,108 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "model_serialization.h"
+
+namespace serialization {
+
+// Изменения состояния игры за один тик
+struct TickDeltaRepr {
+    uint64_t tick = 0;
+    // Собаки, состояние которых изменилось, и собаки, вошедшие в игру
+    std::vector<DogRepr> changed_dogs;
+    std::vector<LostObjectRepr> spawned_loot;
+    std::vector<model::FoundObject::Id::ValueType> collected_loot;
+    std::vector<PlayerRepr> joined_players;
+    // id собак, ушедших на пенсию, вместе с их игроками
+    std::vector<model::Dog::Id::ValueType> retired_dogs;
+    LootGeneratorRepr loot_generator;
+
+    bool IsEmpty() const noexcept {
+        return changed_dogs.empty() && spawned_loot.empty() && collected_loot.empty()
+            && joined_players.empty() && retired_dogs.empty();
+    }
+
+    template <typename Archive>
+    void serialize(Archive& ar, [[maybe_unused]] const unsigned version) {
+        ar& tick;
+        ar& changed_dogs;
+        ar& spawned_loot;
+        ar& collected_loot;
+        ar& joined_players;
+        ar& retired_dogs;
+        ar& loot_generator;
+    }
+};
+
+// Применяет изменения delta к состоянию state
+void ApplyDelta(GameStateRepr& state, const TickDeltaRepr& delta);
+
+/*
+ * Инкрементальное сохранение состояния игры.
+ *
+ * Каждый тик в журнал (write-ahead log) дописываются только изменения состояния.
+ * Когда журнал накапливает достаточно записей, игра вызывает Compact, который
+ * атомарно записывает полный снимок и очищает журнал. При восстановлении
+ * загружается последний снимок, а затем к нему применяются записи журнала,
+ * сделанные после него. Недописанная из-за сбоя последняя запись журнала отбрасывается.
+ */
+class StateJournal {
+public:
+    struct Config {
+        // Количество записей журнала, после которого NeedsCompaction возвращает true
+        size_t compaction_threshold = 1000;
+        // Вызывать fdatasync после каждой записи журнала
+        bool sync_each_append = true;
+    };
+
+    struct RecoveredState {
+        GameStateRepr state;
+        // Тик последнего применённого изменения
+        uint64_t tick = 0;
+        size_t replayed_deltas = 0;
+    };
+
+    explicit StateJournal(std::filesystem::path directory)
+        : StateJournal(std::move(directory), Config{}) {
+    }
+
+    StateJournal(std::filesystem::path directory, Config config);
+
+    StateJournal(const StateJournal&) = delete;
+    StateJournal& operator=(const StateJournal&) = delete;
+
+    ~StateJournal();
+
+    // Дописывает изменения в журнал
+    void Append(const TickDeltaRepr& delta);
+
+    bool NeedsCompaction() const noexcept {
+        return appended_since_compaction_ >= config_.compaction_threshold;
+    }
+
+    // Записывает полный снимок состояния на момент тика tick и очищает журнал
+    void Compact(const GameStateRepr& state, uint64_t tick);
+
+    // Восстанавливает состояние из снимка и журнала в каталоге directory
+    static RecoveredState Recover(const std::filesystem::path& directory);
+
+    static std::filesystem::path GetSnapshotPath(const std::filesystem::path& directory) {
+        return directory / "state.snapshot";
+    }
+
+    static std::filesystem::path GetLogPath(const std::filesystem::path& directory) {
+        return directory / "state.wal";
+    }
+
+private:
+    void OpenLog(bool truncate);
+
+    std::filesystem::path directory_;
+    Config config_;
+    int log_fd_ = -1;
+    size_t appended_since_compaction_ = 0;
+};
+
+}  // namespace serialization
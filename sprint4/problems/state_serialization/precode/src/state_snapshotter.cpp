@@ -0,0 +1,76 @@
+#include "state_snapshotter.h"
+
+#include <sstream>
+
+#include "binary_archive.h"
+
+namespace serialization {
+
+StateSnapshotter::StateSnapshotter(Writer writer)
+    : writer_{std::move(writer)} {
+    worker_ = std::jthread{[this](std::stop_token stop) {
+        Run(std::move(stop));
+    }};
+}
+
+StateSnapshotter::~StateSnapshotter() {
+    worker_.request_stop();
+    worker_.join();
+}
+
+void StateSnapshotter::Wait() {
+    std::unique_lock lock{mutex_};
+    idle_.wait(lock, [this] {
+        return !busy_;
+    });
+}
+
+StateSnapshotter::Metrics StateSnapshotter::GetMetrics() const {
+    std::lock_guard lock{mutex_};
+    return metrics_;
+}
+
+void StateSnapshotter::Run(std::stop_token stop) {
+    for (;;) {
+        {
+            std::unique_lock lock{mutex_};
+            if (!has_snapshot_.wait(lock, stop, [this] {
+                    return busy_;
+                })) {
+                // Остановка запрошена, а несохранённых снимков нет
+                break;
+            }
+        }
+
+        // Пока busy_ == true, игровой поток не обращается к back_
+        const auto start = std::chrono::steady_clock::now();
+        bool success = true;
+        size_t size = 0;
+        try {
+            std::ostringstream strm;
+            BinaryOutputArchive output_archive{strm};
+            output_archive << back_;
+            const std::string data = std::move(strm).str();
+            size = data.size();
+            writer_(data);
+        } catch (...) {
+            success = false;
+        }
+        const auto write_time = std::chrono::steady_clock::now() - start;
+
+        {
+            std::lock_guard lock{mutex_};
+            if (success) {
+                ++metrics_.written;
+                metrics_.last_write_time = write_time;
+                metrics_.last_snapshot_size = size;
+            } else {
+                ++metrics_.failed;
+            }
+            busy_ = false;
+        }
+        idle_.notify_all();
+    }
+}
+
+}  // namespace serialization
@@ -0,0 +1,124 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "model_serialization.h"
+
+namespace serialization {
+
+/*
+ * Сохраняет снимки состояния игры в фоновом потоке.
+ *
+ * Игровой поток лишь копирует состояние в заранее выделенный буфер (TryCapture),
+ * а кодирование в двоичный формат и запись на диск выполняются в отдельном потоке.
+ * Буферов два: пока фоновый поток записывает один, игровой поток заполняет другой,
+ * поэтому после первых снимков копирование не выделяет память.
+ * Если предыдущий снимок ещё не записан, новый снимок пропускается, и игровой поток
+ * никогда не ждёт завершения ввода-вывода.
+ */
+class StateSnapshotter {
+public:
+    using Duration = std::chrono::steady_clock::duration;
+    // Сохраняет закодированный снимок. Вызывается в фоновом потоке
+    using Writer = std::function<void(std::string_view data)>;
+
+    struct Metrics {
+        uint64_t captured = 0;
+        uint64_t skipped = 0;
+        uint64_t written = 0;
+        uint64_t failed = 0;
+        // Время, на которое TryCapture задержал игровой поток
+        Duration last_capture_time{};
+        Duration max_capture_time{};
+        Duration last_write_time{};
+        size_t last_snapshot_size = 0;
+    };
+
+    explicit StateSnapshotter(Writer writer);
+
+    StateSnapshotter(const StateSnapshotter&) = delete;
+    StateSnapshotter& operator=(const StateSnapshotter&) = delete;
+
+    // Дожидается записи последнего снимка и останавливает фоновый поток
+    ~StateSnapshotter();
+
+    /*
+     * Делает снимок состояния, вызывая fill(GameStateRepr&) в текущем потоке.
+     * fill должен перезаписать переданное ему представление (например, через
+     * CaptureDogs), не освобождая память, выделенную в прошлый раз.
+     * Возвращает false, если предыдущий снимок ещё записывается.
+     */
+    template <typename Fill>
+    bool TryCapture(Fill&& fill) {
+        const auto start = std::chrono::steady_clock::now();
+        {
+            std::lock_guard lock{mutex_};
+            if (busy_) {
+                ++metrics_.skipped;
+                return false;
+            }
+        }
+        // Фоновый поток не обращается к front_, пока busy_ == false
+        fill(front_);
+        const auto capture_time = std::chrono::steady_clock::now() - start;
+        {
+            std::lock_guard lock{mutex_};
+            std::swap(front_, back_);
+            busy_ = true;
+            ++metrics_.captured;
+            metrics_.last_capture_time = capture_time;
+            metrics_.max_capture_time = std::max(metrics_.max_capture_time, capture_time);
+        }
+        has_snapshot_.notify_one();
+        return true;
+    }
+
+    // Ждёт, пока будет записан последний сделанный снимок
+    void Wait();
+
+    Metrics GetMetrics() const;
+
+private:
+    void Run(std::stop_token stop);
+
+    Writer writer_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable_any has_snapshot_;
+    std::condition_variable idle_;
+    bool busy_ = false;
+    Metrics metrics_;
+
+    // Заполняется игровым потоком
+    GameStateRepr front_;
+    // Записывается фоновым потоком
+    GameStateRepr back_;
+
+    std::jthread worker_;
+};
+
+// Перезаписывает dogs состоянием собак из диапазона [first, last), повторно используя память
+template <typename DogIt>
+void CaptureDogs(DogIt first, DogIt last, std::vector<DogRepr>& dogs) {
+    dogs.resize(static_cast<size_t>(std::distance(first, last)));
+    for (auto& repr : dogs) {
+        const auto& dog = *first++;
+        // Собаки могут храниться как по значению, так и по указателю (model::DogPtr)
+        if constexpr (requires { *dog; }) {
+            repr.Assign(*dog);
+        } else {
+            repr.Assign(dog);
+        }
+    }
+}
+
+}  // namespace serialization
@@ -0,0 +1,175 @@
+#include <boost/crc.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "../src/crc32.h"
+#include "../src/flat_snapshot.h"
+
+using namespace model;
+using namespace std::literals;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct TempFile {
+    fs::path path = fs::temp_directory_path()
+                  / ("flat-snapshot-tests-"s + std::to_string(reinterpret_cast<uintptr_t>(this)));
+
+    ~TempFile() {
+        std::error_code ec;
+        fs::remove(path, ec);
+    }
+};
+
+void CheckEqual(const Dog& lhs, const Dog& rhs) {
+    CHECK(lhs.GetId() == rhs.GetId());
+    CHECK(lhs.GetName() == rhs.GetName());
+    CHECK(lhs.GetPosition() == rhs.GetPosition());
+    CHECK(lhs.GetSpeed() == rhs.GetSpeed());
+    CHECK(lhs.GetDirection() == rhs.GetDirection());
+    CHECK(lhs.GetBagCapacity() == rhs.GetBagCapacity());
+    CHECK(lhs.GetBagContent() == rhs.GetBagContent());
+    CHECK(lhs.GetScore() == rhs.GetScore());
+}
+
+}  // namespace
+
+SCENARIO("Flat snapshot") {
+    TempFile file;
+
+    GIVEN("some dogs") {
+        std::vector<Dog> dogs;
+        for (uint32_t id = 0; id < 10; ++id) {
+            dogs.emplace_back(Dog::Id{id}, "Dog with a rather long name #"s + std::to_string(id),
+                              geom::Point2D{id * 1.5, -2.0}, 3);
+            auto& dog = dogs.back();
+            dog.SetSpeed({0.5, id * 1.0});
+            dog.SetDirection(Direction::WEST);
+            dog.AddScore(id * 10);
+            for (uint32_t i = 0; i < id % 4; ++i) {
+                CHECK(dog.PutToBag({FoundObject::Id{id * 10 + i}, i}));
+            }
+        }
+        serialization::FlatSnapshotBuilder builder;
+        builder.Reserve(dogs.size());
+        for (const auto& dog : dogs) {
+            builder.AddDog(dog);
+        }
+
+        WHEN("the snapshot is written and mapped") {
+            builder.WriteTo(file.path);
+            const serialization::MappedFlatSnapshot snapshot{file.path};
+
+            THEN("names and bags are available without copying") {
+                REQUIRE(snapshot.GetDogCount() == dogs.size());
+                CHECK(snapshot.GetDogName(3) == "Dog with a rather long name #3"sv);
+                REQUIRE(snapshot.GetDogBag(3).size() == 3);
+                CHECK(snapshot.GetDogBag(3)[2] == FoundObject{FoundObject::Id{32}, 2});
+                CHECK(snapshot.GetDogBag(4).empty());
+            }
+
+            THEN("dogs are restored") {
+                NameTable names;
+                const auto restored = snapshot.RestoreDogs(names);
+                REQUIRE(restored.size() == dogs.size());
+                for (size_t i = 0; i < dogs.size(); ++i) {
+                    CheckEqual(restored[i], dogs[i]);
+                }
+            }
+        }
+
+        WHEN("the snapshot is corrupted") {
+            auto data = builder.Build();
+            data[data.size() - 1] ^= 1;
+            std::ofstream{file.path, std::ios::binary} << data;
+
+            THEN("it is rejected") {
+                CHECK_THROWS_AS(serialization::MappedFlatSnapshot{file.path}, std::runtime_error);
+            }
+        }
+
+        WHEN("the snapshot is truncated") {
+            auto data = builder.Build();
+            data.resize(data.size() / 2);
+            std::ofstream{file.path, std::ios::binary} << data;
+
+            THEN("it is rejected") {
+                CHECK_THROWS_AS(serialization::MappedFlatSnapshot{file.path}, std::runtime_error);
+            }
+        }
+    }
+
+    GIVEN("dogs sharing names") {
+        NameTable names;
+        serialization::FlatSnapshotBuilder builder;
+        for (uint32_t id = 0; id < 100; ++id) {
+            builder.AddDog(Dog{Dog::Id{id}, names, names.Intern(id % 2 ? "Pluto"sv : "Goofy"sv),
+                               {0, 0}, 3});
+        }
+        builder.WriteTo(file.path);
+
+        WHEN("the snapshot is restored into an empty name table") {
+            const serialization::MappedFlatSnapshot snapshot{file.path};
+            NameTable game_names;
+            const auto restored = snapshot.RestoreDogs(game_names);
+
+            THEN("each name is written once and shared by the restored dogs") {
+                CHECK(snapshot.GetNameCount() == 2);
+                CHECK(snapshot.GetDogName(1) == "Pluto"sv);
+                CHECK(snapshot.GetDogName(1).data() == snapshot.GetDogName(3).data());
+                REQUIRE(restored.size() == 100);
+                CHECK(restored[0].GetName() == "Goofy"sv);
+                CHECK(restored[1].GetName().data() == restored[99].GetName().data());
+                CHECK(game_names.GetCount() == 2);
+                CHECK(restored[1].GetName().data() == game_names.Get(game_names.Intern("Pluto"sv)).data());
+            }
+        }
+
+        WHEN("the snapshot is restored into a table that already has names") {
+            const serialization::MappedFlatSnapshot snapshot{file.path};
+            NameTable game_names;
+            const auto pluto = game_names.Intern("Pluto"sv);
+            game_names.Intern("Rex"sv);
+            const auto restored = snapshot.RestoreDogs(game_names);
+
+            THEN("names are shared with the existing ones") {
+                REQUIRE(restored.size() == 100);
+                CHECK(game_names.GetCount() == 3);
+                CHECK(restored[1].GetName().data() == game_names.Get(pluto).data());
+                CHECK(restored[0].GetName() == "Goofy"sv);
+            }
+        }
+    }
+
+    GIVEN("no dogs") {
+        serialization::FlatSnapshotBuilder{}.WriteTo(file.path);
+
+        THEN("an empty snapshot is restored") {
+            const serialization::MappedFlatSnapshot snapshot{file.path};
+            NameTable names;
+            CHECK(snapshot.RestoreDogs(names).empty());
+        }
+    }
+}
+
+SCENARIO("CRC32") {
+    GIVEN("data of various lengths and alignments") {
+        std::string data;
+        for (int i = 0; i < 100; ++i) {
+            data += static_cast<char>(i * 37 + 11);
+        }
+
+        THEN("checksum matches boost::crc_32_type") {
+            for (size_t offset = 0; offset < 8; ++offset) {
+                for (size_t size = 0; offset + size <= data.size(); ++size) {
+                    boost::crc_32_type expected;
+                    expected.process_bytes(data.data() + offset, size);
+                    CHECK(serialization::Crc32(data.data() + offset, size) == expected.checksum());
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,148 @@
+#include <catch2/catch_test_macros.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/model.h"
+
+using namespace model;
+using namespace std::literals;
+
+SCENARIO("Name table") {
+    GIVEN("a name table") {
+        NameTable names;
+
+        WHEN("names are interned") {
+            const auto pluto = names.Intern("Pluto"sv);
+            const auto goofy = names.Intern("Goofy"sv);
+            const auto pluto_again = names.Intern("Pluto"s);
+
+            THEN("each name is stored once") {
+                CHECK(names.GetCount() == 2);
+                CHECK(pluto == pluto_again);
+                CHECK(pluto != goofy);
+                CHECK(names.Get(pluto) == "Pluto"sv);
+                CHECK(names.Get(goofy) == "Goofy"sv);
+                CHECK(names.Get(pluto).data() == names.Get(pluto_again).data());
+            }
+        }
+
+        WHEN("many short and long names are interned") {
+            const auto first = names.Intern("first"sv);
+            const auto first_view = names.Get(first);
+            const std::string long_name(100'000, 'x');
+            const auto long_ref = names.Intern(long_name);
+            std::vector<NameRef> refs;
+            for (int i = 0; i < 20'000; ++i) {
+                refs.push_back(names.Intern("Dog #"s + std::to_string(i)));
+            }
+
+            THEN("previously returned names stay valid") {
+                CHECK(names.Get(first).data() == first_view.data());
+                CHECK(first_view == "first"sv);
+                CHECK(names.Get(long_ref) == long_name);
+                for (int i = 0; i < 20'000; ++i) {
+                    CHECK(names.Get(refs[i]) == "Dog #"s + std::to_string(i));
+                }
+            }
+        }
+
+        WHEN("a pool of distinct names is appended") {
+            const auto rex = names.Intern("Rex"sv);
+            const std::string pool = "PlutoGoofyRex";
+            const std::vector<uint32_t> offsets{0, 5, 10, 13};
+            names.AppendUnique(pool, offsets);
+
+            THEN("the names get consecutive indices and can be found") {
+                REQUIRE(names.GetCount() == 4);
+                CHECK(names.GetByIndex(1) == "Pluto"sv);
+                CHECK(names.GetByIndex(3) == "Rex"sv);
+                CHECK(names.Intern("Goofy"sv) == NameRef{2, 5});
+                CHECK(names.Intern("Rex"sv) == rex);
+                CHECK(names.GetCount() == 4);
+            }
+        }
+
+        WHEN("a pool with invalid offsets is appended") {
+            const std::vector<uint32_t> unsorted{0, 5, 3};
+            const std::vector<uint32_t> past_end{0, 10};
+
+            THEN("it is rejected") {
+                CHECK_THROWS_AS(names.AppendUnique("PlutoGoofy"sv, unsorted), std::out_of_range);
+                CHECK_THROWS_AS(names.AppendUnique("Pluto"sv, past_end), std::out_of_range);
+                CHECK(names.GetCount() == 0);
+            }
+        }
+
+        WHEN("an empty name is interned") {
+            const auto empty = names.Intern(""sv);
+
+            THEN("it is an empty string") {
+                CHECK(names.Get(empty).empty());
+            }
+        }
+    }
+}
+
+SCENARIO("Dog names") {
+    GIVEN("dogs of a game sharing a name table") {
+        NameTable names;
+        const auto pluto_ref = names.Intern("Pluto"sv);
+        const Dog pluto{Dog::Id{1}, names, pluto_ref, {0, 0}, 3};
+        const Dog other_pluto{Dog::Id{2}, names, names.Intern("Pluto"sv), {1, 1}, 3};
+
+        THEN("their names point into the table without copying") {
+            CHECK(pluto.GetName() == "Pluto"sv);
+            CHECK(pluto.GetName().data() == names.Get(pluto_ref).data());
+            CHECK(pluto.GetName().data() == other_pluto.GetName().data());
+        }
+
+        WHEN("a dog is copied and moved") {
+            Dog copy = pluto;
+            const Dog moved = std::move(copy);
+
+            THEN("the copies still point into the table") {
+                CHECK(moved.GetName().data() == names.Get(pluto_ref).data());
+            }
+        }
+    }
+
+    GIVEN("a dog created with its own name") {
+        std::optional<Dog> dog{std::in_place, Dog::Id{1}, "Rex"s, geom::Point2D{0, 0}, 3};
+
+        WHEN("the dog is copied and moved, and the original is destroyed") {
+            Dog copy = *dog;
+            std::vector<Dog> dogs;
+            dogs.push_back(std::move(*dog));
+            dog.reset();
+            // Перераспределение памяти вектора снова перемещает собаку
+            dogs.push_back(copy);
+            copy = dogs.front();
+
+            THEN("each copy refers to its own name") {
+                CHECK(copy.GetName() == "Rex"sv);
+                CHECK(dogs.front().GetName() == "Rex"sv);
+                CHECK(dogs.back().GetName() == "Rex"sv);
+                CHECK(copy.GetName().data() != dogs.front().GetName().data());
+            }
+        }
+    }
+
+    GIVEN("a dog with its own long name") {
+        const std::string long_name(100, 'r');
+        Dog dog{Dog::Id{1}, long_name, geom::Point2D{0, 0}, 3};
+        const char* const name_data = dog.GetName().data();
+
+        WHEN("the dog is moved") {
+            Dog moved = std::move(dog);
+            Dog assigned{Dog::Id{2}, "Rex"sv, geom::Point2D{0, 0}, 3};
+            assigned = std::move(moved);
+
+            THEN("the name is not copied") {
+                CHECK(assigned.GetName() == long_name);
+                CHECK(assigned.GetName().data() == name_data);
+            }
+        }
+    }
+}
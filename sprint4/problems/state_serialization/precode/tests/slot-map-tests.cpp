@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "../src/model.h"
+
+using namespace model;
+using namespace std::literals;
+
+namespace {
+
+struct Item {};
+using ItemId = util::Tagged<uint32_t, Item>;
+using ItemMap = util::SlotMap<ItemId, std::string>;
+
+}  // namespace
+
+SCENARIO("Slot map") {
+    GIVEN("a slot map with several values") {
+        ItemMap items;
+        const auto a = items.Insert("a"s);
+        const auto b = items.Insert("b"s);
+        const auto c = items.Insert("c"s);
+
+        THEN("values are found by their ids") {
+            CHECK(items.Size() == 3);
+            CHECK(a != b);
+            CHECK(b != c);
+            REQUIRE(items.Find(a));
+            CHECK(*items.Find(a) == "a"s);
+            CHECK(*items.Find(b) == "b"s);
+            CHECK(*items.Find(c) == "c"s);
+        }
+
+        WHEN("a value in the middle is erased") {
+            REQUIRE(items.Erase(a));
+
+            THEN("its id becomes stale while other ids stay valid") {
+                CHECK_FALSE(items.Contains(a));
+                CHECK(items.Find(a) == nullptr);
+                CHECK_FALSE(items.Erase(a));
+                CHECK(items.Size() == 2);
+                CHECK(*items.Find(b) == "b"s);
+                CHECK(*items.Find(c) == "c"s);
+            }
+
+            THEN("the remaining values are stored densely") {
+                std::vector<std::string> values(items.begin(), items.end());
+                std::sort(values.begin(), values.end());
+                CHECK(values == std::vector{"b"s, "c"s});
+                for (size_t i = 0; i < items.Size(); ++i) {
+                    CHECK(items.Find(items.GetIdAt(i)) == &*(items.begin() + i));
+                }
+            }
+
+            AND_WHEN("a new value is inserted") {
+                const auto d = items.Insert("d"s);
+
+                THEN("the slot is reused with a new generation") {
+                    CHECK(ItemMap::GetIndex(d) == ItemMap::GetIndex(a));
+                    CHECK(ItemMap::GetGeneration(d) == ItemMap::GetGeneration(a) + 1);
+                    CHECK(items.Find(a) == nullptr);
+                    CHECK(*items.Find(d) == "d"s);
+                }
+            }
+        }
+
+        WHEN("the map is cleared") {
+            items.Clear();
+
+            THEN("all ids become stale") {
+                CHECK(items.IsEmpty());
+                CHECK_FALSE(items.Contains(a));
+                CHECK_FALSE(items.Contains(b));
+                CHECK_FALSE(items.Contains(c));
+            }
+        }
+
+        WHEN("a value factory throws") {
+            CHECK_THROWS(items.Insert([](ItemId) -> std::string {
+                throw std::runtime_error("failed");
+            }));
+
+            THEN("the map is unchanged and the slot is reusable") {
+                CHECK(items.Size() == 3);
+                const auto d = items.Insert("d"s);
+                CHECK(*items.Find(d) == "d"s);
+                CHECK(items.Size() == 4);
+            }
+        }
+    }
+
+    GIVEN("a slot map with a small generation counter") {
+        util::SlotMap<ItemId, std::string, 30> items;
+        static_assert(decltype(items)::MAX_GENERATION == 3);
+        auto id = items.Insert("x"s);
+        const auto first_index = decltype(items)::GetIndex(id);
+
+        WHEN("one slot is reused until its generation is exhausted") {
+            for (int i = 0; i < 3; ++i) {
+                REQUIRE(items.Erase(id));
+                id = items.Insert("x"s);
+                CHECK(decltype(items)::GetIndex(id) == first_index);
+            }
+            REQUIRE(items.Erase(id));
+            const auto next = items.Insert("y"s);
+
+            THEN("the exhausted slot is retired") {
+                CHECK(decltype(items)::GetIndex(next) != first_index);
+                CHECK_FALSE(items.Contains(id));
+                CHECK(*items.Find(next) == "y"s);
+            }
+        }
+    }
+}
+
+SCENARIO("Dog registry") {
+    GIVEN("a dog registry") {
+        DogRegistry dogs;
+        NameTable names;
+
+        WHEN("dogs are created by the registry") {
+            const auto pluto = dogs.Insert([&](Dog::Id id) {
+                return Dog{id, names, names.Intern("Pluto"sv), {1.0, 2.0}, 3};
+            });
+            const auto goofy = dogs.Insert([&](Dog::Id id) {
+                return Dog{id, names, names.Intern("Goofy"sv), {3.0, 4.0}, 3};
+            });
+
+            THEN("each dog knows its own id") {
+                REQUIRE(dogs.Find(pluto));
+                CHECK(dogs.Find(pluto)->GetId() == pluto);
+                CHECK(dogs.Find(pluto)->GetName() == "Pluto"sv);
+                CHECK(dogs.Find(goofy)->GetId() == goofy);
+                CHECK(dogs.Find(goofy)->GetName() == "Goofy"sv);
+            }
+
+            AND_WHEN("a dog leaves") {
+                REQUIRE(dogs.Find(goofy)->PutToBag({FoundObject::Id{7u}, 1u}));
+                dogs.Erase(pluto);
+
+                THEN("the other dog is moved without losing its bag") {
+                    CHECK(dogs.Find(pluto) == nullptr);
+                    CHECK(dogs.Find(goofy)->GetPosition() == geom::Point2D{3.0, 4.0});
+                    CHECK(dogs.Find(goofy)->GetBagContent()
+                          == Dog::BagContent{FoundObject{FoundObject::Id{7u}, 1u}});
+                }
+            }
+        }
+    }
+
+    GIVEN("a lost object registry") {
+        LostObjectRegistry objects;
+        const auto id = objects.Insert(LostObject{2u, {5.0, 6.0}});
+
+        THEN("a collected object is removed by its id") {
+            CHECK(objects.Find(id)->type == 2u);
+            CHECK(objects.Erase(id));
+            CHECK(objects.IsEmpty());
+        }
+    }
+}
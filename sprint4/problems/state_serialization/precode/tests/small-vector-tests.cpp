@@ -0,0 +1,171 @@
+#include <catch2/catch_test_macros.hpp>
+#include <utility>
+#include <vector>
+
+#include "../src/model.h"
+#include "../src/small_vector.h"
+
+using namespace std::literals;
+
+namespace {
+
+using Vector = util::SmallVector<int, 3>;
+
+std::vector<int> ToStd(const Vector& vec) {
+    return {vec.begin(), vec.end()};
+}
+
+}  // namespace
+
+SCENARIO("Small vector") {
+    GIVEN("an empty vector") {
+        Vector vec;
+        CHECK(vec.empty());
+        CHECK(vec.is_inline());
+        CHECK(vec.capacity() == 3);
+
+        WHEN("items fit into the inline buffer") {
+            vec.push_back(1);
+            vec.push_back(2);
+            vec.push_back(3);
+
+            THEN("they are stored inline") {
+                CHECK(vec.is_inline());
+                CHECK(ToStd(vec) == std::vector{1, 2, 3});
+                CHECK(vec.back() == 3);
+            }
+
+            THEN("clearing keeps the vector inline") {
+                vec.clear();
+                CHECK(vec.empty());
+                CHECK(vec.is_inline());
+            }
+        }
+
+        WHEN("more items than the inline capacity are added") {
+            for (int i = 0; i < 10; ++i) {
+                vec.push_back(i);
+            }
+
+            THEN("they are moved to the heap") {
+                CHECK_FALSE(vec.is_inline());
+                CHECK(vec.size() == 10);
+                CHECK(vec[9] == 9);
+            }
+        }
+
+        WHEN("capacity is reserved") {
+            vec.reserve(2);
+            CHECK(vec.is_inline());
+            vec.reserve(5);
+
+            THEN("large reservations allocate on the heap") {
+                CHECK_FALSE(vec.is_inline());
+                CHECK(vec.capacity() == 5);
+            }
+        }
+    }
+
+    GIVEN("inline and heap vectors") {
+        const Vector small{1, 2};
+        const Vector large{1, 2, 3, 4, 5};
+
+        THEN("they can be copied") {
+            Vector small_copy = small;
+            Vector large_copy = large;
+            CHECK(small_copy == small);
+            CHECK(large_copy == large);
+            CHECK_FALSE(small_copy == large_copy);
+
+            small_copy = large;
+            CHECK(small_copy == large);
+            large_copy = small;
+            CHECK(large_copy == small);
+        }
+
+        THEN("they can be moved") {
+            Vector small_copy = small;
+            Vector large_copy = large;
+            Vector moved_small = std::move(small_copy);
+            Vector moved_large = std::move(large_copy);
+            CHECK(moved_small == small);
+            CHECK(moved_small.is_inline());
+            CHECK(moved_large == large);
+            CHECK(small_copy.empty());
+            CHECK(large_copy.empty());
+
+            moved_small = std::move(moved_large);
+            CHECK(moved_small == large);
+        }
+
+        THEN("items can be appended and assigned") {
+            Vector vec = small;
+            vec.insert(vec.end(), large.begin(), large.end());
+            CHECK(ToStd(vec) == std::vector{1, 2, 1, 2, 3, 4, 5});
+            vec.assign(small.begin(), small.end());
+            CHECK(vec == small);
+        }
+    }
+
+    GIVEN("full inline and heap vectors") {
+        Vector small{1, 2, 3};
+        Vector large{1, 2, 3, 4, 5};
+        REQUIRE(large.size() == large.capacity());
+
+        THEN("their own items can be appended while they grow") {
+            small.push_back(small[0]);
+            large.push_back(large[0]);
+            CHECK(ToStd(small) == std::vector{1, 2, 3, 1});
+            CHECK(ToStd(large) == std::vector{1, 2, 3, 4, 5, 1});
+        }
+
+        THEN("they can be appended to themselves while they grow") {
+            small.insert(small.end(), small.begin(), small.end());
+            large.insert(large.end(), large.begin(), large.end());
+            CHECK(ToStd(small) == std::vector{1, 2, 3, 1, 2, 3});
+            CHECK(ToStd(large) == std::vector{1, 2, 3, 4, 5, 1, 2, 3, 4, 5});
+        }
+
+        THEN("insertion doubles their capacity unless more items are inserted") {
+            const std::vector<int> one{7};
+            small.insert(small.end(), one.begin(), one.end());
+            large.insert(large.end(), one.begin(), one.end());
+            CHECK(small.capacity() == 6);
+            CHECK(large.capacity() == 10);
+
+            const std::vector<int> many(20, 7);
+            small.insert(small.end(), many.begin(), many.end());
+            CHECK(small.size() == 24);
+            CHECK(small.capacity() == 24);
+        }
+    }
+}
+
+SCENARIO("Dog bag storage") {
+    GIVEN("a dog with a small bag") {
+        model::Dog dog{model::Dog::Id{1}, "Rex"sv, {0, 0}, model::Dog::BAG_INLINE_CAPACITY};
+
+        THEN("its bag is stored inside the dog") {
+            for (uint32_t i = 0; i < model::Dog::BAG_INLINE_CAPACITY; ++i) {
+                CHECK(dog.PutToBag({model::FoundObject::Id{i}, i}));
+            }
+            CHECK(dog.IsBagFull());
+            CHECK(dog.GetBagContent().is_inline());
+            CHECK_FALSE(dog.PutToBag({model::FoundObject::Id{100}, 0}));
+            CHECK(dog.EmptyBag() == model::Dog::BAG_INLINE_CAPACITY);
+        }
+    }
+
+    GIVEN("a dog with a large bag") {
+        model::Dog dog{model::Dog::Id{1}, "Rex"sv, {0, 0}, 10};
+
+        THEN("its bag falls back to the heap") {
+            for (uint32_t i = 0; i < 10; ++i) {
+                CHECK(dog.PutToBag({model::FoundObject::Id{i}, i}));
+            }
+            CHECK(dog.IsBagFull());
+            CHECK(dog.GetBagContent().size() == 10);
+            CHECK_FALSE(dog.GetBagContent().is_inline());
+        }
+    }
+}
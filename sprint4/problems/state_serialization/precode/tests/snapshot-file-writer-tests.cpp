@@ -0,0 +1,208 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include "../src/binary_archive.h"
+#include "../src/file_util.h"
+#include "../src/snapshot_file_writer.h"
+#include "../src/state_snapshotter.h"
+
+using namespace std::literals;
+namespace fs = std::filesystem;
+
+namespace {
+
+class TempDirectory {
+public:
+    TempDirectory()
+        : path_{fs::temp_directory_path()
+                / ("snapshot-file-writer-tests-"s
+                   + std::to_string(reinterpret_cast<uintptr_t>(this)))} {
+        fs::remove_all(path_);
+    }
+
+    ~TempDirectory() {
+        std::error_code ec;
+        fs::remove_all(path_, ec);
+    }
+
+    const fs::path& GetPath() const noexcept {
+        return path_;
+    }
+
+private:
+    fs::path path_;
+};
+
+std::string ReadFile(const fs::path& path) {
+    std::ifstream input{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+}
+
+std::string MakeData(size_t size, char seed) {
+    std::string data(size, '\0');
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<char>(seed + i % 251);
+    }
+    return data;
+}
+
+}  // namespace
+
+SCENARIO("Snapshot file writer") {
+    TempDirectory dir;
+    serialization::SnapshotFileWriter::Config config;
+    config.directory = dir.GetPath();
+    config.generations = 2;
+    config.block_size = serialization::SnapshotFileWriter::ALIGNMENT * 2;
+
+    GIVEN("a writer") {
+        serialization::SnapshotFileWriter writer{config};
+
+        WHEN("a snapshot is written") {
+            const auto data = MakeData(config.block_size * 3 + 123, 'a');
+            const auto path = writer.Write(data);
+
+            THEN("the file contains exactly the snapshot") {
+                CHECK(ReadFile(path) == data);
+                CHECK_FALSE(fs::exists(fs::path{path} += ".tmp"));
+
+                const auto metrics = writer.GetMetrics();
+                CHECK(metrics.written == 1);
+                CHECK(metrics.sync_failed == 0);
+                CHECK(metrics.last_synced);
+                CHECK(metrics.total_bytes == data.size());
+                CHECK(metrics.last_size == data.size());
+                CHECK(metrics.GetThroughput() > 0);
+            }
+        }
+
+        WHEN("more snapshots than generations are written") {
+            for (char seed = 'a'; seed < 'f'; ++seed) {
+                writer.Write(MakeData(1000, seed));
+            }
+
+            THEN("only the newest generations are kept") {
+                const auto generations
+                    = serialization::SnapshotFileWriter::ListGenerations(dir.GetPath(), "state"sv);
+                REQUIRE(generations.size() == 2);
+                CHECK(ReadFile(generations[0]) == MakeData(1000, 'e'));
+                CHECK(ReadFile(generations[1]) == MakeData(1000, 'd'));
+            }
+        }
+    }
+
+    GIVEN("a writer using direct I/O") {
+        config.direct_io = true;
+        serialization::SnapshotFileWriter writer{config};
+
+        WHEN("a snapshot larger than a block with an unaligned size is written") {
+            const auto data = MakeData(config.block_size * 3 + 123, 'b');
+            const auto path = writer.Write(data);
+
+            THEN("the padding of the last block is cut off") {
+                CHECK(ReadFile(path) == data);
+                CHECK(fs::file_size(path) == data.size());
+            }
+        }
+    }
+
+    GIVEN("snapshots written by a previous run") {
+        {
+            serialization::SnapshotFileWriter writer{config};
+            writer.Write("old"sv);
+        }
+
+        WHEN("a new writer continues writing") {
+            serialization::SnapshotFileWriter writer{config};
+            writer.Write("new"sv);
+
+            THEN("generation numbering continues") {
+                const auto generations
+                    = serialization::SnapshotFileWriter::ListGenerations(dir.GetPath(), "state"sv);
+                REQUIRE(generations.size() == 2);
+                CHECK(ReadFile(generations[0]) == "new"s);
+                CHECK(ReadFile(generations[1]) == "old"s);
+            }
+        }
+    }
+
+    GIVEN("a background snapshotter writing through the file writer") {
+        serialization::SnapshotFileWriter writer{config};
+        serialization::StateSnapshotter snapshotter{[&writer](std::string_view data) {
+            writer.Write(data);
+        }};
+        std::vector<model::Dog> dogs;
+        dogs.emplace_back(model::Dog::Id{7}, "Pluto"s, geom::Point2D{1, 2}, 3);
+
+        WHEN("a snapshot is captured") {
+            snapshotter.TryCapture([&dogs](serialization::GameStateRepr& state) {
+                serialization::CaptureDogs(dogs.begin(), dogs.end(), state.dogs);
+            });
+            snapshotter.Wait();
+
+            THEN("it can be loaded from the newest generation") {
+                const auto generations
+                    = serialization::SnapshotFileWriter::ListGenerations(dir.GetPath(), "state"sv);
+                REQUIRE(generations.size() == 1);
+                std::ifstream input{generations[0], std::ios::binary};
+                serialization::BinaryInputArchive input_archive{input};
+                serialization::GameStateRepr state;
+                input_archive >> state;
+                REQUIRE(state.dogs.size() == 1);
+                CHECK(state.dogs[0].Restore().GetName() == "Pluto"s);
+            }
+        }
+    }
+
+    THEN("invalid configurations are rejected") {
+        config.block_size = 1000;
+        CHECK_THROWS_AS(serialization::SnapshotFileWriter{config}, std::invalid_argument);
+        config.block_size = serialization::SnapshotFileWriter::ALIGNMENT;
+        config.generations = 0;
+        CHECK_THROWS_AS(serialization::SnapshotFileWriter{config}, std::invalid_argument);
+    }
+}
+
+SCENARIO("Atomic file replacement") {
+    TempDirectory dir;
+    fs::create_directories(dir.GetPath());
+    const auto path = dir.GetPath() / "file";
+    serialization::WriteFileAtomically(path, "old"sv);
+
+    WHEN("the file is replaced") {
+        serialization::WriteFileAtomically(path, "new"sv);
+
+        THEN("it contains the new data and no temporary file is left") {
+            CHECK(ReadFile(path) == "new"s);
+            CHECK_FALSE(fs::exists(serialization::GetTempPath(path)));
+        }
+    }
+
+    WHEN("writing the temporary file fails") {
+        CHECK_THROWS_AS(serialization::ReplaceFile(path,
+                                                   [](const fs::path& temp_path) {
+                                                       std::ofstream{temp_path} << "partial";
+                                                       throw std::runtime_error("disk full");
+                                                   }),
+                        std::runtime_error);
+
+        THEN("the file keeps its old content and the temporary file is removed") {
+            CHECK(ReadFile(path) == "old"s);
+            CHECK_FALSE(fs::exists(serialization::GetTempPath(path)));
+        }
+    }
+    WHEN("the file is given by a name without a directory") {
+        const auto current_path = fs::current_path();
+        fs::current_path(dir.GetPath());
+        CHECK_NOTHROW(serialization::WriteFileAtomically(fs::path{"file"}, "relative"sv));
+        fs::current_path(current_path);
+
+        THEN("it is written to the current directory") {
+            CHECK(ReadFile(path) == "relative"s);
+        }
+    }
+}
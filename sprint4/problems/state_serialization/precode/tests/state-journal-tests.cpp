@@ -0,0 +1,190 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "../src/binary_archive.h"
+#include "../src/state_journal.h"
+
+using namespace model;
+using namespace std::literals;
+namespace fs = std::filesystem;
+
+namespace {
+
+// Временный каталог, удаляемый в деструкторе
+class TempDirectory {
+public:
+    TempDirectory()
+        : path_{fs::temp_directory_path()
+                / ("state-journal-tests-"s + std::to_string(reinterpret_cast<uintptr_t>(this)))} {
+        fs::remove_all(path_);
+    }
+
+    ~TempDirectory() {
+        std::error_code ec;
+        fs::remove_all(path_, ec);
+    }
+
+    const fs::path& GetPath() const noexcept {
+        return path_;
+    }
+
+private:
+    fs::path path_;
+};
+
+serialization::DogRepr MakeDog(uint32_t id, Score score) {
+    Dog dog{Dog::Id{id}, "Dog #"s + std::to_string(id), geom::Point2D{id * 1.0, 2.0}, 3};
+    dog.AddScore(score);
+    return serialization::DogRepr{dog};
+}
+
+serialization::TickDeltaRepr MakeJoinDelta(uint64_t tick, uint32_t dog_id) {
+    serialization::TickDeltaRepr delta;
+    delta.tick = tick;
+    delta.changed_dogs.push_back(MakeDog(dog_id, 0));
+    delta.joined_players.push_back({"token-"s + std::to_string(dog_id), dog_id});
+    delta.loot_generator.spawn_counter = tick;
+    return delta;
+}
+
+}  // namespace
+
+SCENARIO("Applying tick deltas") {
+    GIVEN("a game state") {
+        serialization::GameStateRepr state;
+        serialization::ApplyDelta(state, MakeJoinDelta(1, 1));
+        serialization::ApplyDelta(state, MakeJoinDelta(2, 2));
+        REQUIRE(state.dogs.size() == 2);
+        REQUIRE(state.players.size() == 2);
+
+        WHEN("a dog changes") {
+            serialization::TickDeltaRepr delta;
+            delta.changed_dogs.push_back(MakeDog(1, 42));
+            serialization::ApplyDelta(state, delta);
+
+            THEN("it is replaced in place") {
+                REQUIRE(state.dogs.size() == 2);
+                CHECK(state.dogs[0].Restore().GetScore() == 42);
+            }
+        }
+
+        WHEN("loot is spawned and then collected") {
+            serialization::TickDeltaRepr spawn;
+            spawn.spawned_loot.push_back({FoundObject{FoundObject::Id{7}, 1}, {1.0, 2.0}});
+            spawn.spawned_loot.push_back({FoundObject{FoundObject::Id{8}, 2}, {3.0, 4.0}});
+            serialization::ApplyDelta(state, spawn);
+
+            serialization::TickDeltaRepr collect;
+            collect.collected_loot.push_back(7);
+            serialization::ApplyDelta(state, collect);
+
+            THEN("only the remaining loot stays on the map") {
+                REQUIRE(state.lost_objects.size() == 1);
+                CHECK(*state.lost_objects[0].object.id == 8);
+            }
+        }
+
+        WHEN("a dog retires") {
+            serialization::TickDeltaRepr delta;
+            delta.retired_dogs.push_back(1);
+            serialization::ApplyDelta(state, delta);
+
+            THEN("the dog and its player are removed") {
+                REQUIRE(state.dogs.size() == 1);
+                CHECK(*state.dogs[0].GetId() == 2);
+                REQUIRE(state.players.size() == 1);
+                CHECK(state.players[0].token == "token-2"s);
+            }
+        }
+    }
+}
+
+SCENARIO("State journal") {
+    TempDirectory dir;
+    serialization::StateJournal::Config config;
+    config.compaction_threshold = 3;
+    config.sync_each_append = false;
+
+    GIVEN("a journal with some deltas") {
+        {
+            serialization::StateJournal journal{dir.GetPath(), config};
+            journal.Append(MakeJoinDelta(1, 1));
+            journal.Append(MakeJoinDelta(2, 2));
+            CHECK_FALSE(journal.NeedsCompaction());
+        }
+
+        WHEN("the state is recovered") {
+            const auto recovered = serialization::StateJournal::Recover(dir.GetPath());
+
+            THEN("all deltas are replayed") {
+                CHECK(recovered.tick == 2);
+                CHECK(recovered.replayed_deltas == 2);
+                CHECK(recovered.state.dogs.size() == 2);
+                CHECK(recovered.state.players.size() == 2);
+                CHECK(recovered.state.loot_generator.spawn_counter == 2);
+            }
+        }
+
+        WHEN("the journal is compacted and more deltas are appended") {
+            {
+                serialization::StateJournal journal{dir.GetPath(), config};
+                journal.Append(MakeJoinDelta(3, 3));
+                REQUIRE(journal.NeedsCompaction());
+
+                auto state = serialization::StateJournal::Recover(dir.GetPath()).state;
+                journal.Compact(state, 3);
+                CHECK_FALSE(journal.NeedsCompaction());
+                journal.Append(MakeJoinDelta(4, 4));
+            }
+
+            THEN("the snapshot and the remaining delta are recovered") {
+                const auto recovered = serialization::StateJournal::Recover(dir.GetPath());
+                CHECK(recovered.tick == 4);
+                CHECK(recovered.replayed_deltas == 1);
+                CHECK(recovered.state.dogs.size() == 4);
+            }
+        }
+
+        WHEN("the last record is torn") {
+            const auto log_path = serialization::StateJournal::GetLogPath(dir.GetPath());
+            fs::resize_file(log_path, fs::file_size(log_path) - 5);
+
+            THEN("it is ignored on recovery") {
+                const auto recovered = serialization::StateJournal::Recover(dir.GetPath());
+                CHECK(recovered.tick == 1);
+                CHECK(recovered.state.dogs.size() == 1);
+            }
+
+            THEN("it is cut off before new deltas are appended") {
+                {
+                    serialization::StateJournal journal{dir.GetPath(), config};
+                    journal.Append(MakeJoinDelta(3, 3));
+                }
+                const auto recovered = serialization::StateJournal::Recover(dir.GetPath());
+                CHECK(recovered.tick == 3);
+                CHECK(recovered.replayed_deltas == 2);
+            }
+        }
+
+        WHEN("a snapshot is written but the journal is not cleared") {
+            serialization::GameStateRepr state;
+            serialization::ApplyDelta(state, MakeJoinDelta(1, 1));
+            serialization::ApplyDelta(state, MakeJoinDelta(2, 2));
+            {
+                std::ofstream out{serialization::StateJournal::GetSnapshotPath(dir.GetPath()),
+                                  std::ios::binary};
+                serialization::BinaryOutputArchive output_archive{out};
+                output_archive << uint64_t{2} << state;
+            }
+
+            THEN("deltas included in the snapshot are not replayed") {
+                const auto recovered = serialization::StateJournal::Recover(dir.GetPath());
+                CHECK(recovered.tick == 2);
+                CHECK(recovered.replayed_deltas == 0);
+                CHECK(recovered.state.dogs.size() == 2);
+            }
+        }
+    }
+}
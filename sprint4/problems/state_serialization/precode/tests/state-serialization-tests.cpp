@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
 
+#include "../src/binary_archive.h"
 #include "../src/model.h"
 #include "../src/model_serialization.h"
 
@@ -69,3 +71,309 @@ SCENARIO_METHOD(Fixture, "Dog Serialization") {
         }
     }
 }
+
+namespace {
+
+struct BinaryFixture {
+    std::stringstream strm;
+    serialization::BinaryOutputArchive output_archive{strm};
+};
+
+Dog MakeDog(uint32_t id) {
+    Dog dog{Dog::Id{id}, "Dog #"s + std::to_string(id), {id * 0.5, -1.25}, 3};
+    dog.AddScore(id * 10);
+    CHECK(dog.PutToBag({FoundObject::Id{id}, id % 4}));
+    dog.SetDirection(Direction::WEST);
+    dog.SetSpeed({0.1 * id, 3.0});
+    return dog;
+}
+
+}  // namespace
+
+SCENARIO_METHOD(BinaryFixture, "Binary snapshot serialization") {
+    GIVEN("a game state") {
+        serialization::GameStateRepr state;
+        for (uint32_t id = 0; id < 10; ++id) {
+            state.dogs.emplace_back(MakeDog(id));
+            state.players.push_back({"token"s + std::to_string(id), id});
+        }
+        state.lost_objects.push_back({{FoundObject::Id{100}, 1u}, {3.5, 4.0}});
+        state.loot_generator = {1500, 42};
+
+        WHEN("state is serialized") {
+            output_archive << state;
+
+            THEN("it can be deserialized") {
+                serialization::BinaryInputArchive input_archive{strm};
+                serialization::GameStateRepr restored;
+                input_archive >> restored;
+
+                REQUIRE(restored.dogs.size() == state.dogs.size());
+                for (uint32_t id = 0; id < 10; ++id) {
+                    const auto dog = MakeDog(id);
+                    const auto restored_dog = restored.dogs[id].Restore();
+                    CHECK(dog.GetId() == restored_dog.GetId());
+                    CHECK(dog.GetName() == restored_dog.GetName());
+                    CHECK(dog.GetPosition() == restored_dog.GetPosition());
+                    CHECK(dog.GetSpeed() == restored_dog.GetSpeed());
+                    CHECK(dog.GetDirection() == restored_dog.GetDirection());
+                    CHECK(dog.GetScore() == restored_dog.GetScore());
+                    CHECK(dog.GetBagContent() == restored_dog.GetBagContent());
+                }
+                REQUIRE(restored.players.size() == state.players.size());
+                CHECK(restored.players[3].token == "token3"s);
+                CHECK(restored.players[3].dog_id == 3);
+                REQUIRE(restored.lost_objects.size() == 1);
+                CHECK(restored.lost_objects[0].object == state.lost_objects[0].object);
+                CHECK(restored.lost_objects[0].position == state.lost_objects[0].position);
+                CHECK(restored.loot_generator.time_without_loot == 1500);
+                CHECK(restored.loot_generator.spawn_counter == 42);
+            }
+
+            THEN("it is smaller than the text archive") {
+                std::stringstream text_strm;
+                OutputArchive text_archive{text_strm};
+                text_archive << state;
+                CHECK(strm.str().size() < text_strm.str().size());
+            }
+        }
+
+        WHEN("serialized data is corrupted") {
+            output_archive << state;
+            auto data = strm.str();
+            data[data.size() / 2] ^= 0x20;
+            std::stringstream corrupted{data};
+
+            THEN("deserialization fails") {
+                serialization::BinaryInputArchive input_archive{corrupted};
+                serialization::GameStateRepr restored;
+                CHECK_THROWS_AS(input_archive >> restored, std::runtime_error);
+            }
+        }
+
+        WHEN("serialized data is truncated") {
+            output_archive << state;
+            std::stringstream truncated{strm.str().substr(0, strm.str().size() - 1)};
+
+            THEN("deserialization fails") {
+                serialization::BinaryInputArchive input_archive{truncated};
+                serialization::GameStateRepr restored;
+                CHECK_THROWS_AS(input_archive >> restored, std::runtime_error);
+            }
+        }
+    }
+
+    GIVEN("several objects") {
+        const geom::Point2D p{10, 20};
+        const geom::Vec2D v{-1, 0.5};
+        output_archive << p << v;
+
+        THEN("they are deserialized one by one") {
+            serialization::BinaryInputArchive input_archive{strm};
+            geom::Point2D restored_point;
+            geom::Vec2D restored_vec;
+            input_archive >> restored_point >> restored_vec;
+            CHECK(p == restored_point);
+            CHECK(v == restored_vec);
+        }
+    }
+
+    GIVEN("numbers of different types") {
+        output_archive << uint16_t{0x0102} << -1 << 5u << size_t{5} << Direction::EAST << true;
+        const std::string data = strm.str();
+
+        THEN("each is written at the width of its type") {
+            const auto header_size = serialization::BinaryArchiveBase::HEADER_SIZE;
+            std::string_view rest = data;
+            const auto next_frame = [&rest, header_size] {
+                rest.remove_prefix(header_size);
+                const auto end = std::min(rest.find("DSNP"sv), rest.size());
+                const auto payload = rest.substr(0, end);
+                rest.remove_prefix(end);
+                return std::string{payload};
+            };
+            CHECK(next_frame() == "\x02\x01"s);
+            CHECK(next_frame() == std::string(4, '\xFF'));
+            CHECK(next_frame() == "\x05\0\0\0"s);
+            CHECK(next_frame() == "\x05\0\0\0\0\0\0\0"s);
+            CHECK(next_frame().size() == sizeof(Direction));
+            CHECK(next_frame() == "\x01"s);
+        }
+
+        THEN("they are read back") {
+            serialization::BinaryInputArchive input_archive{strm};
+            uint16_t u16 = 0;
+            int negative = 0;
+            unsigned u32 = 0;
+            size_t size = 0;
+            Direction direction = Direction::NORTH;
+            bool flag = false;
+            input_archive >> u16 >> negative >> u32 >> size >> direction >> flag;
+            CHECK(u16 == 0x0102);
+            CHECK(negative == -1);
+            CHECK(u32 == 5);
+            CHECK(size == 5);
+            CHECK(direction == Direction::EAST);
+            CHECK(flag);
+        }
+    }
+
+    GIVEN("a frame whose header claims more data than the stream has") {
+        output_archive << 42;
+        std::string data = strm.str();
+        // Размер данных лежит в заголовке после magic и версии формата
+        for (size_t i = 8; i < 16; ++i) {
+            data[i] = '\x7F';
+        }
+
+        THEN("reading fails without allocating the claimed size") {
+            std::stringstream corrupted{data};
+            serialization::BinaryInputArchive input_archive{corrupted};
+            int value = 0;
+            CHECK_THROWS_AS(input_archive >> value, std::runtime_error);
+        }
+    }
+}
+
+namespace {
+
+// Собака Pluto в текстовом архиве исходной версии игры, до появления версий DogRepr
+constexpr std::string_view OLD_TEXT_DOG
+    = "22 serialization::archive 18 0 0 42 5 Pluto 0 0 1.50000000000000000e+00 "
+      "2.50000000000000000e+00 3 0 0 5.00000000000000000e-01 -1.00000000000000000e+00 1 77 0 0 1 "
+      "0 0 0 10 2"sv;
+
+void CheckOldDog(const Dog& dog) {
+    CHECK(*dog.GetId() == 42);
+    CHECK(dog.GetName() == "Pluto"s);
+    CHECK(dog.GetPosition() == geom::Point2D{1.5, 2.5});
+    CHECK(dog.GetSpeed() == geom::Vec2D{0.5, -1.0});
+    CHECK(dog.GetDirection() == Direction::EAST);
+    CHECK(dog.GetBagCapacity() == 3);
+    CHECK(dog.GetScore() == 77);
+    CHECK(dog.GetBagContent() == Dog::BagContent{{FoundObject::Id{10}, 2u}});
+}
+
+}  // namespace
+
+SCENARIO("Versioned dog serialization") {
+    GIVEN("a text snapshot written before dog versions were introduced") {
+        THEN("it can be loaded") {
+            std::stringstream strm{std::string{OLD_TEXT_DOG}};
+            InputArchive input_archive{strm};
+            serialization::DogRepr repr;
+            input_archive >> repr;
+            CheckOldDog(repr.Restore());
+        }
+
+        THEN("text archives still use its layout and differ only in the class version") {
+            std::stringstream strm{std::string{OLD_TEXT_DOG}};
+            serialization::DogRepr repr;
+            InputArchive{strm} >> repr;
+
+            std::stringstream output;
+            {
+                OutputArchive output_archive{output};
+                output_archive << serialization::DogRepr{repr.Restore()};
+            }
+            std::string expected{OLD_TEXT_DOG};
+            expected.replace(expected.find(" 0 0 42 "), 8, " 0 1 42 ");
+            CHECK(output.str() == expected + "\n");
+        }
+    }
+
+    GIVEN("a dog saved in the current format") {
+        const auto dog = MakeDog(5);
+        std::stringstream strm;
+        serialization::BinaryOutputArchive output_archive{strm};
+        output_archive << serialization::DogRepr{dog};
+
+        WHEN("it is loaded") {
+            serialization::BinaryInputArchive input_archive{strm};
+            serialization::DogRepr repr;
+            input_archive >> repr;
+
+            THEN("hot fields are decoded eagerly and cold fields on first access") {
+                CHECK(repr.GetId() == dog.GetId());
+                CHECK(repr.GetPosition() == dog.GetPosition());
+                CHECK(repr.GetSpeed() == dog.GetSpeed());
+                CHECK(repr.GetDirection() == dog.GetDirection());
+                CHECK_FALSE(repr.HasColdFields());
+
+                CHECK(repr.GetName() == dog.GetName());
+                CHECK(repr.HasColdFields());
+                CHECK(repr.GetScore() == dog.GetScore());
+                CHECK(std::ranges::equal(repr.GetBagContent(), dog.GetBagContent()));
+            }
+
+            THEN("cold fields refer to the frame buffer of the archive") {
+                // Буфером владеют архив, repr и frame
+                const auto frame = input_archive.GetFrameBuffer();
+                CHECK(frame.use_count() == 3);
+                CHECK(repr.GetName() == dog.GetName());
+                CHECK(frame.use_count() == 2);
+            }
+
+            THEN("it can be saved again without decoding cold fields") {
+                std::stringstream copy_strm;
+                serialization::BinaryOutputArchive copy_archive{copy_strm};
+                copy_archive << repr;
+                CHECK_FALSE(repr.HasColdFields());
+                CHECK(copy_strm.str() == strm.str());
+            }
+        }
+
+        WHEN("it is saved to a text archive") {
+            std::stringstream text_strm;
+            {
+                OutputArchive text_archive{text_strm};
+                text_archive << serialization::DogRepr{dog};
+            }
+
+            THEN("all fields are written in the text form") {
+                CHECK(text_strm.str().find(" Dog #5 "s) != std::string::npos);
+            }
+
+            THEN("it can be loaded back") {
+                InputArchive text_archive{text_strm};
+                serialization::DogRepr repr;
+                text_archive >> repr;
+                CHECK(repr.Restore().GetName() == dog.GetName());
+                CHECK(repr.Restore().GetBagContent() == dog.GetBagContent());
+            }
+        }
+    }
+}
+
+SCENARIO("Field table") {
+    GIVEN("a table with a field unknown to the reader") {
+        std::string data;
+        serialization::FieldTableWriter writer{data};
+        writer.AddUint32(1, 7);
+        writer.Add(200, "from the future"sv);
+        writer.Add(2, "known"sv);
+
+        THEN("the unknown field is skipped") {
+            serialization::FieldTableReader reader{data};
+            uint8_t id = 0;
+            std::string_view value;
+            std::vector<uint8_t> ids;
+            while (reader.Next(id, value)) {
+                ids.push_back(id);
+            }
+            CHECK(ids == std::vector<uint8_t>{1, 200, 2});
+        }
+
+        THEN("a truncated table is rejected") {
+            serialization::FieldTableReader reader{std::string_view{data}.substr(0, data.size() - 1)};
+            uint8_t id = 0;
+            std::string_view value;
+            CHECK_THROWS_AS(
+                [&] {
+                    while (reader.Next(id, value)) {
+                    }
+                }(),
+                std::runtime_error);
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/binary_archive.h"
+#include "../src/state_snapshotter.h"
+
+using namespace model;
+using namespace std::literals;
+
+namespace {
+
+std::vector<Dog> MakeDogs(uint32_t count) {
+    std::vector<Dog> dogs;
+    for (uint32_t id = 0; id < count; ++id) {
+        dogs.emplace_back(Dog::Id{id}, "Dog #"s + std::to_string(id), geom::Point2D{id * 1.0, 2.0},
+                          2);
+        dogs.back().AddScore(id);
+    }
+    return dogs;
+}
+
+// Хранит записанные снимки и позволяет задержать запись
+class SnapshotStorage {
+public:
+    void Write(std::string_view data) {
+        std::unique_lock lock{mutex_};
+        opened_.wait(lock, [this] {
+            return open_;
+        });
+        snapshots_.emplace_back(data);
+    }
+
+    void SetOpen(bool open) {
+        {
+            std::lock_guard lock{mutex_};
+            open_ = open;
+        }
+        opened_.notify_all();
+    }
+
+    serialization::GameStateRepr Load(size_t index) const {
+        std::lock_guard lock{mutex_};
+        std::stringstream strm{snapshots_.at(index)};
+        serialization::BinaryInputArchive input_archive{strm};
+        serialization::GameStateRepr state;
+        input_archive >> state;
+        return state;
+    }
+
+    size_t GetCount() const {
+        std::lock_guard lock{mutex_};
+        return snapshots_.size();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable opened_;
+    bool open_ = true;
+    std::vector<std::string> snapshots_;
+};
+
+}  // namespace
+
+SCENARIO("Background state snapshots") {
+    SnapshotStorage storage;
+    serialization::StateSnapshotter snapshotter{[&storage](std::string_view data) {
+        storage.Write(data);
+    }};
+
+    GIVEN("some dogs") {
+        auto dogs = MakeDogs(100);
+
+        WHEN("a snapshot is captured") {
+            const bool captured = snapshotter.TryCapture([&dogs](serialization::GameStateRepr& state) {
+                serialization::CaptureDogs(dogs.begin(), dogs.end(), state.dogs);
+            });
+            // Изменения после снимка не должны в него попасть
+            dogs.front().AddScore(1000);
+            snapshotter.Wait();
+
+            THEN("it is written in the background with the captured state") {
+                CHECK(captured);
+                REQUIRE(storage.GetCount() == 1);
+                const auto state = storage.Load(0);
+                REQUIRE(state.dogs.size() == dogs.size());
+                CHECK(state.dogs[0].Restore().GetScore() == 0);
+                CHECK(state.dogs[99].Restore().GetName() == "Dog #99"s);
+                CHECK(snapshotter.GetMetrics().written == 1);
+            }
+        }
+
+        WHEN("snapshots are captured while the previous one is being written") {
+            storage.SetOpen(false);
+            auto fill = [&dogs](serialization::GameStateRepr& state) {
+                serialization::CaptureDogs(dogs.begin(), dogs.end(), state.dogs);
+            };
+            CHECK(snapshotter.TryCapture(fill));
+
+            THEN("they are skipped without waiting") {
+                CHECK_FALSE(snapshotter.TryCapture(fill));
+                CHECK_FALSE(snapshotter.TryCapture(fill));
+                storage.SetOpen(true);
+                snapshotter.Wait();
+
+                const auto metrics = snapshotter.GetMetrics();
+                CHECK(metrics.captured == 1);
+                CHECK(metrics.skipped == 2);
+                CHECK(storage.GetCount() == 1);
+            }
+        }
+
+        WHEN("snapshots are captured repeatedly") {
+            for (int i = 0; i < 5; ++i) {
+                dogs.pop_back();
+                CHECK(snapshotter.TryCapture([&dogs](serialization::GameStateRepr& state) {
+                    serialization::CaptureDogs(dogs.begin(), dogs.end(), state.dogs);
+                }));
+                snapshotter.Wait();
+            }
+
+            THEN("each snapshot reflects the state at capture time") {
+                REQUIRE(storage.GetCount() == 5);
+                for (size_t i = 0; i < 5; ++i) {
+                    CHECK(storage.Load(i).dogs.size() == 99 - i);
+                }
+            }
+        }
+    }
+}